@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+# Runs the headless benchmark on Level and Dev_Map and exits with its result:
+# 0 passed, 1 a metric regressed past the baseline, 2 a map could not be run.
+#
+# Usage: UE_ROOT=/path/to/UnrealEngine Benchmark/RunBenchmark.sh [-MemoryTags] [-UpdateBaseline] [-BenchmarkThreshold=0.1]
+# Results and CSV profiles are written to Saved/Benchmark, baselines live in Benchmark/Baselines.
+# -MemoryTags adds a second pass with -LLM that checks the memory tag high-water marks. LLM slows every
+# allocation, so the frame times are only measured by the first pass, which runs without it.
+
+set -u
+
+PROJECT_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+EDITOR="${UE_ROOT:?Set UE_ROOT to the Unreal Engine install}/Engine/Binaries/Linux/UnrealEditor"
+
+MEMORY_TAGS=0
+ARGS=()
+for ARG in "$@"; do
+	if [ "$ARG" = "-MemoryTags" ]; then
+		MEMORY_TAGS=1
+	else
+		ARGS+=("$ARG")
+	fi
+done
+
+run_benchmark() {
+	"$EDITOR" "$PROJECT_DIR/Spring2022_Capstone.uproject" /Game/Maps/Level -game -nullrhi -nosound -unattended -nosplash \
+		-CapstoneBenchmark -csvGpuStats=0 -log ${ARGS[@]+"${ARGS[@]}"} "$@"
+}
+
+run_benchmark
+RESULT=$?
+
+if [ "$MEMORY_TAGS" -eq 1 ]; then
+	run_benchmark -LLM
+	MEMORY_RESULT=$?
+	if [ "$MEMORY_RESULT" -gt "$RESULT" ]; then
+		RESULT=$MEMORY_RESULT
+	fi
+fi
+
+exit $RESULT
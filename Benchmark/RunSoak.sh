@@ -0,0 +1,14 @@
+#!/usr/bin/env bash
+# Runs the soak bot on Level and exits with 1 when a value kept growing until the end of the run.
+#
+# Usage: UE_ROOT=/path/to/UnrealEngine Benchmark/RunSoak.sh [-SoakMinutes=240] [-SoakSeed=7]
+# Samples, the growth report and the memory tag high-water marks (-LLM) are written to Saved/Soak.
+# The run is stepped at a fixed 60 Hz of game time, so it finishes as fast as the machine can simulate it.
+
+set -u
+
+PROJECT_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+EDITOR="${UE_ROOT:?Set UE_ROOT to the Unreal Engine install}/Engine/Binaries/Linux/UnrealEditor"
+
+"$EDITOR" "$PROJECT_DIR/Spring2022_Capstone.uproject" /Game/Maps/Level -game -nullrhi -nosound -unattended -nosplash \
+	-CapstoneSoak -CapstoneFixedStep=60 -LLM -log "$@"
@@ -3,10 +3,13 @@
 #include "BasePickup.h"
 #include "Spring2022_Capstone/Player/PlayerCharacter.h"
 #include "Components/SphereComponent.h"
+#include "Spring2022_Capstone/Performance/CapstoneMemoryTags.h"
+#include "Spring2022_Capstone/Performance/CapstoneTelemetry.h"
 
 // Sets default values
 ABasePickup::ABasePickup()
 {
+	CAPSTONE_LLM_SCOPE(Capstone_Pickups);
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -32,8 +35,9 @@ void ABasePickup::Tick(float DeltaTime)
 
 void ABasePickup::OnOverlapBegin(UPrimitiveComponent *Comp, AActor *otherActor, UPrimitiveComponent *otherComp, int32 otherBodyIndex, bool bFromSweep, const FHitResult &SweepResult)
 {
+	CAPSTONE_LLM_SCOPE(Capstone_Pickups);
 	APlayerCharacter *player = Cast<APlayerCharacter>(otherActor);
-	if (!player)
+	if (!player || bCollected)
 	{
 		return;
 	}
@@ -53,5 +57,13 @@ void ABasePickup::OnOverlapBegin(UPrimitiveComponent *Comp, AActor *otherActor,
 		break;
 	}
 
-	Destroy();
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::PickupCollected, this, 0, GetActorLocation(), StaticEnum<EPickupType>()->GetNameByValue(PickupType));
+	SetCollected(true);
+}
+
+void ABasePickup::SetCollected(bool bIsCollected)
+{
+	bCollected = bIsCollected;
+	SetActorHiddenInGame(bIsCollected);
+	SetActorEnableCollision(!bIsCollected);
 }
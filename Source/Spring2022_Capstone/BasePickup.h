@@ -26,6 +26,13 @@ public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	/**
+	 * @brief Hides and disables the pickup instead of destroying it, so a level reset can bring it back.
+	 * @param bIsCollected true - pickup is hidden and can't be picked up, false - pickup is available again.
+	 */
+	void SetCollected(bool bIsCollected);
+	FORCEINLINE bool IsCollected() const { return bCollected; }
+
 private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = true))
 	UStaticMeshComponent *PickupMesh;
@@ -35,6 +42,8 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Pickup")
 	TEnumAsByte<EPickupType> PickupType;
 
+	bool bCollected = false;
+
 	UFUNCTION()
 	void OnOverlapBegin(UPrimitiveComponent *Comp, AActor *otherActor, UPrimitiveComponent *otherComp, int32 otherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
 };
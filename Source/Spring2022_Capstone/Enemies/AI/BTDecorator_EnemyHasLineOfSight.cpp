@@ -0,0 +1,32 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTDecorator_EnemyHasLineOfSight.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "EnemyLineOfSightSubsystem.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTDecorator_EnemyHasLineOfSight::UBTDecorator_EnemyHasLineOfSight()
+{
+	NodeName = TEXT("Has Line Of Sight");
+}
+
+bool UBTDecorator_EnemyHasLineOfSight::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	UEnemyLineOfSightSubsystem* LineOfSight = OwnerComp.GetWorld()->GetSubsystem<UEnemyLineOfSightSubsystem>();
+	const APawn* Pawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	const AActor* Target = GetTarget(OwnerComp);
+	if (!LineOfSight || !Pawn || !Target)
+	{
+		return false;
+	}
+
+	return LineOfSight->GetLineOfSight(Pawn, Target).bHasLineOfSight;
+}
+
+FString UBTDecorator_EnemyHasLineOfSight::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: can see %s, checked every %.2fs"), *Super::GetStaticDescription(), *TargetKey.SelectedKeyName.ToString(), CheckInterval);
+}
@@ -0,0 +1,24 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BTDecorator_EnemyTargetCheck.h"
+#include "BTDecorator_EnemyHasLineOfSight.generated.h"
+
+/**
+ * Passes while the enemy can see the actor in TargetKey, using the batched results of UEnemyLineOfSightSubsystem.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTDecorator_EnemyHasLineOfSight : public UBTDecorator_EnemyTargetCheck
+{
+	GENERATED_BODY()
+
+public:
+	UBTDecorator_EnemyHasLineOfSight();
+
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+};
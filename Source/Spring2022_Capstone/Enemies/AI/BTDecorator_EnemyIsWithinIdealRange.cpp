@@ -0,0 +1,45 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTDecorator_EnemyIsWithinIdealRange.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTDecorator_EnemyIsWithinIdealRange::UBTDecorator_EnemyIsWithinIdealRange()
+{
+	NodeName = TEXT("Is Within Ideal Range");
+	IdealRangeKey.AddFloatFilter(this, GET_MEMBER_NAME_CHECKED(UBTDecorator_EnemyIsWithinIdealRange, IdealRangeKey));
+	CheckInterval = 0.25f;
+}
+
+void UBTDecorator_EnemyIsWithinIdealRange::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* Blackboard = GetBlackboardAsset())
+		IdealRangeKey.ResolveSelectedKey(*Blackboard);
+}
+
+bool UBTDecorator_EnemyIsWithinIdealRange::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	const APawn* Pawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	const AActor* Target = GetTarget(OwnerComp);
+	if (!Pawn || !Target)
+	{
+		return false;
+	}
+
+	const float IdealRange = OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Float>(IdealRangeKey.GetSelectedKeyID());
+	return Pawn->GetDistanceTo(Target) - ErrorMargin <= IdealRange;
+}
+
+FString UBTDecorator_EnemyIsWithinIdealRange::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s within %s + %.0f, checked every %.2fs"), *Super::GetStaticDescription(), *TargetKey.SelectedKeyName.ToString(),
+		*IdealRangeKey.SelectedKeyName.ToString(), ErrorMargin, CheckInterval);
+}
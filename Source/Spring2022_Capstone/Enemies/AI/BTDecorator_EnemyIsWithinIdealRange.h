@@ -0,0 +1,34 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BTDecorator_EnemyTargetCheck.h"
+#include "BTDecorator_EnemyIsWithinIdealRange.generated.h"
+
+/**
+ * Native BTD_IsWithinIdealRange. Passes while the actor in TargetKey is no further than the IdealRangeKey float plus
+ * ErrorMargin.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTDecorator_EnemyIsWithinIdealRange : public UBTDecorator_EnemyTargetCheck
+{
+	GENERATED_BODY()
+
+public:
+	UBTDecorator_EnemyIsWithinIdealRange();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+
+private:
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	FBlackboardKeySelector IdealRangeKey;
+
+	// Distance past the ideal range that still counts as within it.
+	UPROPERTY(EditAnywhere, Category = "Condition", meta = (ClampMin = "0"))
+	float ErrorMargin = 50.f;
+};
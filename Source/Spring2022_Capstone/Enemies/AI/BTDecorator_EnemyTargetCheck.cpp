@@ -0,0 +1,63 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTDecorator_EnemyTargetCheck.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Spring2022_Capstone/Enemies/EnemySignificanceSubsystem.h"
+
+UBTDecorator_EnemyTargetCheck::UBTDecorator_EnemyTargetCheck()
+{
+	TargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTDecorator_EnemyTargetCheck, TargetKey), AActor::StaticClass());
+
+	bNotifyBecomeRelevant = true;
+	bNotifyTick = true;
+	bTickIntervals = true;
+	bAllowAbortNone = true;
+	bAllowAbortLowerPri = true;
+	bAllowAbortChildNodes = true;
+}
+
+void UBTDecorator_EnemyTargetCheck::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* Blackboard = GetBlackboardAsset())
+		TargetKey.ResolveSelectedKey(*Blackboard);
+}
+
+void UBTDecorator_EnemyTargetCheck::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FTargetCheckMemory* Memory = reinterpret_cast<FTargetCheckMemory*>(NodeMemory);
+	Memory->bLastResult = CalculateRawConditionValue(OwnerComp, NodeMemory);
+	ScheduleNextCheck(OwnerComp, NodeMemory);
+}
+
+void UBTDecorator_EnemyTargetCheck::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	FTargetCheckMemory* Memory = reinterpret_cast<FTargetCheckMemory*>(NodeMemory);
+	ScheduleNextCheck(OwnerComp, NodeMemory);
+
+	const bool bResult = CalculateRawConditionValue(OwnerComp, NodeMemory);
+	if (bResult != Memory->bLastResult)
+	{
+		Memory->bLastResult = bResult;
+		OwnerComp.RequestExecution(this);
+	}
+}
+
+const AActor* UBTDecorator_EnemyTargetCheck::GetTarget(const UBehaviorTreeComponent& OwnerComp) const
+{
+	return Cast<AActor>(OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID()));
+}
+
+void UBTDecorator_EnemyTargetCheck::ScheduleNextCheck(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	// Less significant enemies check less often.
+	const UEnemySignificanceSubsystem* Significance = OwnerComp.GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>();
+	const APawn* Pawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	SetNextTickTime(NodeMemory, FMath::Max(CheckInterval, Significance ? Significance->GetTickInterval(Pawn) : 0.f));
+}
@@ -0,0 +1,47 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTDecorator.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "BTDecorator_EnemyTargetCheck.generated.h"
+
+/**
+ * Base for enemy decorators testing a condition against the actor in TargetKey. With an abort mode set the condition
+ * is re-checked every CheckInterval seconds rather than every frame, or at the enemy's significance tick interval when
+ * that is longer, and the tree is only asked to re-evaluate when the result changed.
+ */
+UCLASS(Abstract)
+class SPRING2022_CAPSTONE_API UBTDecorator_EnemyTargetCheck : public UBTDecorator
+{
+	GENERATED_BODY()
+
+public:
+	UBTDecorator_EnemyTargetCheck();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(FTargetCheckMemory); }
+
+protected:
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+	// The actor in TargetKey, null when the key is empty.
+	const AActor* GetTarget(const UBehaviorTreeComponent& OwnerComp) const;
+
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	FBlackboardKeySelector TargetKey;
+
+	// Seconds between re-checks while the decorator can abort.
+	UPROPERTY(EditAnywhere, Category = "Condition", meta = (ClampMin = "0"))
+	float CheckInterval = 0.2f;
+
+private:
+	struct FTargetCheckMemory
+	{
+		bool bLastResult;
+	};
+
+	void ScheduleNextCheck(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const;
+};
@@ -0,0 +1,46 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTService_EnemyTargetDistance.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTService_EnemyTargetDistance::UBTService_EnemyTargetDistance()
+{
+	NodeName = TEXT("Target Distance");
+	Interval = 0.25f;
+	RandomDeviation = 0.05f;
+	bNotifyBecomeRelevant = false;
+	bNotifyCeaseRelevant = false;
+
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_EnemyTargetDistance, BlackboardKey), AActor::StaticClass());
+	DistanceKey.AddFloatFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_EnemyTargetDistance, DistanceKey));
+}
+
+void UBTService_EnemyTargetDistance::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* Blackboard = GetBlackboardAsset())
+		DistanceKey.ResolveSelectedKey(*Blackboard);
+}
+
+void UBTService_EnemyTargetDistance::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+
+	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	const APawn* Pawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	const AActor* Target = Cast<AActor>(Blackboard->GetValue<UBlackboardKeyType_Object>(BlackboardKey.GetSelectedKeyID()));
+	if (!Pawn || !Target)
+	{
+		return;
+	}
+
+	Blackboard->SetValue<UBlackboardKeyType_Float>(DistanceKey.GetSelectedKeyID(), Pawn->GetDistanceTo(Target));
+}
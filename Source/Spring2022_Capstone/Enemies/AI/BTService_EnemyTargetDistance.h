@@ -0,0 +1,29 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Services/BTService_BlackboardBase.h"
+#include "BTService_EnemyTargetDistance.generated.h"
+
+/**
+ * Writes the distance to the actor in the blackboard key into DistanceKey every Interval seconds, so blackboard
+ * decorators can compare it without the tree measuring it every frame.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTService_EnemyTargetDistance : public UBTService_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTService_EnemyTargetDistance();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+
+protected:
+	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+private:
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector DistanceKey;
+};
@@ -0,0 +1,24 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTTask_EnemyClearFocus.h"
+#include "AIController.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTTask_EnemyClearFocus::UBTTask_EnemyClearFocus()
+{
+	NodeName = TEXT("Clear Focus");
+}
+
+EBTNodeResult::Type UBTTask_EnemyClearFocus::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	if (!AIController)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	AIController->ClearFocus(EAIFocusPriority::Gameplay);
+	return EBTNodeResult::Succeeded;
+}
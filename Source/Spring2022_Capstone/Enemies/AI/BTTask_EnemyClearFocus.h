@@ -0,0 +1,21 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "BTTask_EnemyClearFocus.generated.h"
+
+/**
+ * Native BTT_ClearFocus. Clears the gameplay focus set by UBTTask_EnemyFocusTarget.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTTask_EnemyClearFocus : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyClearFocus();
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+};
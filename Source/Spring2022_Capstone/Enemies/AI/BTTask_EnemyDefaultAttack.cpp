@@ -0,0 +1,72 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTTask_EnemyDefaultAttack.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Kismet/GameplayStatics.h"
+#include "Spring2022_Capstone/Enemies/BaseEnemy.h"
+#include "Spring2022_Capstone/Enemies/EnemyAttackSchedulerSubsystem.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTTask_EnemyDefaultAttack::UBTTask_EnemyDefaultAttack()
+{
+	NodeName = TEXT("Default Attack");
+	TargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_EnemyDefaultAttack, TargetKey), AActor::StaticClass());
+}
+
+void UBTTask_EnemyDefaultAttack::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* Blackboard = GetBlackboardAsset())
+		TargetKey.ResolveSelectedKey(*Blackboard);
+}
+
+EBTNodeResult::Type UBTTask_EnemyDefaultAttack::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	ABaseEnemy* Enemy = OwnerComp.GetAIOwner() ? Cast<ABaseEnemy>(OwnerComp.GetAIOwner()->GetPawn()) : nullptr;
+	UEnemyAttackSchedulerSubsystem* Scheduler = OwnerComp.GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>();
+	if (!Enemy || !Scheduler)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	AActor* Target = TargetKey.IsSet() ? Cast<AActor>(OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID())) : nullptr;
+	if (!Target)
+		Target = UGameplayStatics::GetPlayerPawn(OwnerComp.GetWorld(), 0);
+	if (!Target)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	Scheduler->RequestAttack(Enemy, Target,
+		FOnEnemyAttackFinished::CreateUObject(this, &UBTTask_EnemyDefaultAttack::OnAttackFinished, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+	return EBTNodeResult::InProgress;
+}
+
+EBTNodeResult::Type UBTTask_EnemyDefaultAttack::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	const ABaseEnemy* Enemy = OwnerComp.GetAIOwner() ? Cast<ABaseEnemy>(OwnerComp.GetAIOwner()->GetPawn()) : nullptr;
+	UEnemyAttackSchedulerSubsystem* Scheduler = OwnerComp.GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>();
+	if (Enemy && Scheduler)
+		Scheduler->CancelAttack(Enemy);
+
+	return Super::AbortTask(OwnerComp, NodeMemory);
+}
+
+FString UBTTask_EnemyDefaultAttack::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: attack %s"), *Super::GetStaticDescription(), TargetKey.IsSet() ? *TargetKey.SelectedKeyName.ToString() : TEXT("player"));
+}
+
+void UBTTask_EnemyDefaultAttack::OnAttackFinished(bool bAttacked, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp)
+{
+	// Aborting cancels the attack, so a live owner is still waiting on this task.
+	if (UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get())
+		FinishLatentTask(*OwnerComp, bAttacked ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
@@ -0,0 +1,32 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "BTTask_EnemyDefaultAttack.generated.h"
+
+/**
+ * Native BTT_DefaultAttack. Asks UEnemyAttackSchedulerSubsystem for an attack on the actor in TargetKey, or the
+ * player when the key is empty, and waits for it. Succeeds once the enemy attacked, fails when it got no attack
+ * token in time so the tree moves on, e.g. to repositioning.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTTask_EnemyDefaultAttack : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyDefaultAttack();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual FString GetStaticDescription() const override;
+
+private:
+	void OnAttackFinished(bool bAttacked, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp);
+
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector TargetKey;
+};
@@ -0,0 +1,61 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTTask_EnemyFindCoverPoint.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "CoverPointSubsystem.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTTask_EnemyFindCoverPoint::UBTTask_EnemyFindCoverPoint()
+{
+	NodeName = TEXT("Find Cover Point");
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_EnemyFindCoverPoint, BlackboardKey));
+	TargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_EnemyFindCoverPoint, TargetKey), AActor::StaticClass());
+}
+
+void UBTTask_EnemyFindCoverPoint::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* Blackboard = GetBlackboardAsset())
+		TargetKey.ResolveSelectedKey(*Blackboard);
+}
+
+EBTNodeResult::Type UBTTask_EnemyFindCoverPoint::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	UCoverPointSubsystem* CoverPoints = OwnerComp.GetWorld()->GetSubsystem<UCoverPointSubsystem>();
+	const APawn* Pawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	const AActor* Target = Cast<AActor>(OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID()));
+	if (!CoverPoints || !Pawn || !Target)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FCoverPointQuery Query;
+	Query.Querier = Pawn;
+	Query.Threat = Target;
+	Query.SearchRadius = SearchRadius;
+	Query.MinThreatDistance = MinTargetDistance;
+	Query.MaxThreatDistance = MaxTargetDistance;
+	Query.bRequireVisibility = bMustSeeTarget;
+
+	const int32 Index = CoverPoints->FindCoverPoint(Query);
+	if (!CoverPoints->ReserveCoverPoint(Index, Pawn))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	OwnerComp.GetBlackboardComponent()->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), CoverPoints->GetCoverPoint(Index).Location);
+	return EBTNodeResult::Succeeded;
+}
+
+FString UBTTask_EnemyFindCoverPoint::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: cover from %s, %.0f to %.0f away%s"), *Super::GetStaticDescription(), *TargetKey.SelectedKeyName.ToString(),
+		MinTargetDistance, MaxTargetDistance, bMustSeeTarget ? TEXT(", seeing it") : TEXT(""));
+}
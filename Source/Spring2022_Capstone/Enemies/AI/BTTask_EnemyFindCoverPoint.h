@@ -0,0 +1,44 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "BTTask_EnemyFindCoverPoint.generated.h"
+
+/**
+ * Baked replacement for EQS_FindCover. Reserves the best free cover point against the actor in TargetKey from
+ * UCoverPointSubsystem and writes its location to the vector in the blackboard key. The reservation outlives the
+ * task so the move that follows keeps the point, it runs out after the subsystem's ReservationTime unless renewed.
+ * Fails when the map has no cover points in reach, so the tree can fall back to the query.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTTask_EnemyFindCoverPoint : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyFindCoverPoint();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual FString GetStaticDescription() const override;
+
+private:
+	UPROPERTY(EditAnywhere, Category = "Cover")
+	FBlackboardKeySelector TargetKey;
+
+	// How far from the enemy cover points are looked for.
+	UPROPERTY(EditAnywhere, Category = "Cover", meta = (ClampMin = "0"))
+	float SearchRadius = 1500.f;
+
+	// Distance to keep from the target.
+	UPROPERTY(EditAnywhere, Category = "Cover", meta = (ClampMin = "0"))
+	float MinTargetDistance = 400.f;
+	UPROPERTY(EditAnywhere, Category = "Cover", meta = (ClampMin = "0"))
+	float MaxTargetDistance = 3000.f;
+
+	// Only cover the enemy can shoot the target from.
+	UPROPERTY(EditAnywhere, Category = "Cover")
+	bool bMustSeeTarget = false;
+};
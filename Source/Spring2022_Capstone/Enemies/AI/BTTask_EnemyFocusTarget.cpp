@@ -0,0 +1,28 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTTask_EnemyFocusTarget.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTTask_EnemyFocusTarget::UBTTask_EnemyFocusTarget()
+{
+	NodeName = TEXT("Focus Target");
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_EnemyFocusTarget, BlackboardKey), AActor::StaticClass());
+}
+
+EBTNodeResult::Type UBTTask_EnemyFocusTarget::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	AActor* Target = Cast<AActor>(OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(BlackboardKey.GetSelectedKeyID()));
+	if (!AIController || !Target)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	AIController->SetFocus(Target);
+	return EBTNodeResult::Succeeded;
+}
@@ -0,0 +1,21 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "BTTask_EnemyFocusTarget.generated.h"
+
+/**
+ * Native BTT_FocusTarget. Makes the AI controller focus the actor in the blackboard key, so the enemy turns to face it.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTTask_EnemyFocusTarget : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyFocusTarget();
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+};
@@ -0,0 +1,169 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTTask_EnemyMoveToIdealRange.h"
+#include "AIController.h"
+#include "CoverPointSubsystem.h"
+#include "EnemyPathRequestSubsystem.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTTask_EnemyMoveToIdealRange::UBTTask_EnemyMoveToIdealRange()
+{
+	NodeName = TEXT("Move To Ideal Range");
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_EnemyMoveToIdealRange, BlackboardKey), AActor::StaticClass());
+	bNotifyTaskFinished = true;
+	IdealRangeKey.AddFloatFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_EnemyMoveToIdealRange, IdealRangeKey));
+}
+
+void UBTTask_EnemyMoveToIdealRange::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* Blackboard = GetBlackboardAsset())
+		IdealRangeKey.ResolveSelectedKey(*Blackboard);
+}
+
+EBTNodeResult::Type UBTTask_EnemyMoveToIdealRange::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	const APawn* Enemy = AIController ? AIController->GetPawn() : nullptr;
+	const UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	const AActor* Target = Cast<AActor>(Blackboard->GetValue<UBlackboardKeyType_Object>(BlackboardKey.GetSelectedKeyID()));
+	if (!Enemy || !Target)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	const float IdealRange = Blackboard->GetValue<UBlackboardKeyType_Float>(IdealRangeKey.GetSelectedKeyID());
+	if (Enemy->GetDistanceTo(Target) <= IdealRange)
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	// Close in along the line to the target until it is within range.
+	const FVector Direction = (Enemy->GetActorLocation() - Target->GetActorLocation()).GetSafeNormal();
+	FMoveToIdealRangeMemory* Memory = reinterpret_cast<FMoveToIdealRangeMemory*>(NodeMemory);
+	Memory->MoveRequestID = FAIRequestID::InvalidRequest;
+	Memory->PathRequestID = INDEX_NONE;
+	Memory->bReservedCover = false;
+	Memory->Goal = Target->GetActorLocation() + Direction * FMath::Max(IdealRange - AcceptanceRadius, 0.f);
+
+	// A baked cover point in range that can see the target beats the straight line.
+	UCoverPointSubsystem* CoverPoints = bUseCoverPoints ? OwnerComp.GetWorld()->GetSubsystem<UCoverPointSubsystem>() : nullptr;
+	if (CoverPoints)
+	{
+		FCoverPointQuery Query;
+		Query.Querier = Enemy;
+		Query.Threat = Target;
+		Query.SearchRadius = CoverSearchRadius;
+		Query.MaxThreatDistance = IdealRange;
+		Query.bRequireVisibility = true;
+
+		const int32 CoverIndex = CoverPoints->FindCoverPoint(Query);
+		if (CoverPoints->ReserveCoverPoint(CoverIndex, Enemy))
+		{
+			Memory->Goal = CoverPoints->GetCoverPoint(CoverIndex).Location;
+			Memory->bReservedCover = true;
+		}
+	}
+
+	if (FVector::Dist2D(Enemy->GetNavAgentLocation(), Memory->Goal) <= AcceptanceRadius)
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	UEnemyPathRequestSubsystem* PathRequests = OwnerComp.GetWorld()->GetSubsystem<UEnemyPathRequestSubsystem>();
+	if (!PathRequests)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FNavPathSharedPtr Path;
+	Memory->PathRequestID = PathRequests->RequestPath(AIController, Memory->Goal, Path,
+		FOnEnemyPathResult::CreateUObject(this, &UBTTask_EnemyMoveToIdealRange::OnPathResult, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+	if (Memory->PathRequestID != INDEX_NONE)
+	{
+		return EBTNodeResult::InProgress;
+	}
+
+	return StartMove(OwnerComp, *Memory, Path);
+}
+
+EBTNodeResult::Type UBTTask_EnemyMoveToIdealRange::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FMoveToIdealRangeMemory* Memory = reinterpret_cast<FMoveToIdealRangeMemory*>(NodeMemory);
+	UEnemyPathRequestSubsystem* PathRequests = OwnerComp.GetWorld()->GetSubsystem<UEnemyPathRequestSubsystem>();
+	if (PathRequests && Memory->PathRequestID != INDEX_NONE)
+		PathRequests->CancelRequest(Memory->PathRequestID);
+	Memory->PathRequestID = INDEX_NONE;
+
+	const AAIController* AIController = OwnerComp.GetAIOwner();
+	if (UPathFollowingComponent* PathFollowing = AIController ? AIController->GetPathFollowingComponent() : nullptr)
+		PathFollowing->AbortMove(*this, FPathFollowingResultFlags::OwnerFinished, Memory->MoveRequestID);
+
+	return Super::AbortTask(OwnerComp, NodeMemory);
+}
+
+void UBTTask_EnemyMoveToIdealRange::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	// Finished, failed or aborted, the point is free for others again.
+	FMoveToIdealRangeMemory* Memory = reinterpret_cast<FMoveToIdealRangeMemory*>(NodeMemory);
+	UCoverPointSubsystem* CoverPoints = OwnerComp.GetWorld()->GetSubsystem<UCoverPointSubsystem>();
+	const APawn* Pawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	if (Memory->bReservedCover && CoverPoints && Pawn)
+		CoverPoints->ReleaseCoverPoint(Pawn);
+	Memory->bReservedCover = false;
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+FString UBTTask_EnemyMoveToIdealRange::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s within %s, acceptance radius %.0f%s"), *Super::GetStaticDescription(), *IdealRangeKey.SelectedKeyName.ToString(),
+		AcceptanceRadius, bUseCoverPoints ? TEXT(", prefers cover") : TEXT(""));
+}
+
+void UBTTask_EnemyMoveToIdealRange::OnPathResult(FNavPathSharedPtr Path, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp)
+{
+	// Aborting cancels the request, so a live owner is still waiting on this task.
+	UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get();
+	FMoveToIdealRangeMemory* Memory = OwnerComp ? reinterpret_cast<FMoveToIdealRangeMemory*>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this))) : nullptr;
+	if (!Memory)
+	{
+		return;
+	}
+
+	Memory->PathRequestID = INDEX_NONE;
+	const EBTNodeResult::Type Result = StartMove(*OwnerComp, *Memory, Path);
+	if (Result != EBTNodeResult::InProgress)
+		FinishLatentTask(*OwnerComp, Result);
+}
+
+EBTNodeResult::Type UBTTask_EnemyMoveToIdealRange::StartMove(UBehaviorTreeComponent& OwnerComp, FMoveToIdealRangeMemory& Memory, FNavPathSharedPtr Path)
+{
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	if (!AIController || !Path.IsValid())
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FAIMoveRequest MoveRequest(Memory.Goal);
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
+	Memory.MoveRequestID = AIController->RequestMove(MoveRequest, Path);
+	if (!Memory.MoveRequestID.IsValid())
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	// The default OnMessage() finishes the task when the move does.
+	WaitForMessage(OwnerComp, UBrainComponent::AIMessage_MoveFinished, Memory.MoveRequestID);
+	WaitForMessage(OwnerComp, UBrainComponent::AIMessage_RepathFailed);
+	return EBTNodeResult::InProgress;
+}
@@ -0,0 +1,58 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AITypes.h"
+#include "NavigationData.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "BTTask_EnemyMoveToIdealRange.generated.h"
+
+/**
+ * Native BTT_MoveToIdealRange. Moves the enemy towards the actor in the blackboard key until it is within the
+ * IdealRangeKey float of it, or to a baked cover point within that range that can see the target when the map has one.
+ * Succeeds straight away when already within range. The path comes from
+ * UEnemyPathRequestSubsystem, shared with enemies heading the same way.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTTask_EnemyMoveToIdealRange : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyMoveToIdealRange();
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(FMoveToIdealRangeMemory); }
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual FString GetStaticDescription() const override;
+
+private:
+	struct FMoveToIdealRangeMemory
+	{
+		FAIRequestID MoveRequestID;
+		int32 PathRequestID;
+		FVector Goal;
+		bool bReservedCover;
+	};
+
+	void OnPathResult(FNavPathSharedPtr Path, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp);
+	EBTNodeResult::Type StartMove(UBehaviorTreeComponent& OwnerComp, FMoveToIdealRangeMemory& Memory, FNavPathSharedPtr Path);
+
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector IdealRangeKey;
+
+	// Distance from the destination at which the move counts as finished.
+	UPROPERTY(EditAnywhere, Category = "Movement", meta = (ClampMin = "0"))
+	float AcceptanceRadius = 50.f;
+
+	// Moves to a free baked cover point within ideal range instead when there is one.
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	bool bUseCoverPoints = true;
+
+	// How far from the enemy cover points are looked for.
+	UPROPERTY(EditAnywhere, Category = "Movement", meta = (ClampMin = "0", EditCondition = "bUseCoverPoints"))
+	float CoverSearchRadius = 1500.f;
+};
@@ -0,0 +1,98 @@
+// Created by Spring2022_Capstone team
+
+
+#include "BTTask_EnemyRunCachedQuery.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "EnemyQueryCacheSubsystem.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+UBTTask_EnemyRunCachedQuery::UBTTask_EnemyRunCachedQuery()
+{
+	NodeName = TEXT("Run Cached Query");
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_EnemyRunCachedQuery, BlackboardKey));
+	TargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_EnemyRunCachedQuery, TargetKey), AActor::StaticClass());
+}
+
+void UBTTask_EnemyRunCachedQuery::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* Blackboard = GetBlackboardAsset())
+		TargetKey.ResolveSelectedKey(*Blackboard);
+}
+
+EBTNodeResult::Type UBTTask_EnemyRunCachedQuery::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyBehavior, AI);
+	FRunCachedQueryMemory* Memory = reinterpret_cast<FRunCachedQueryMemory*>(NodeMemory);
+	Memory->RequestID = INDEX_NONE;
+
+	UEnemyQueryCacheSubsystem* QueryCache = OwnerComp.GetWorld()->GetSubsystem<UEnemyQueryCacheSubsystem>();
+	APawn* Pawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	const AActor* Target = Cast<AActor>(OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID()));
+	if (!QueryCache || !Pawn || !Target || !Query)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	TArray<FVector> Locations;
+	Memory->RequestID = QueryCache->RequestQuery(Query, Pawn, Target->GetActorLocation(), Locations,
+		FOnEnemyQueryResult::CreateUObject(this, &UBTTask_EnemyRunCachedQuery::OnQueryResult, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+	if (Memory->RequestID != INDEX_NONE)
+	{
+		return EBTNodeResult::InProgress;
+	}
+
+	return ApplyResult(OwnerComp, Locations) ? EBTNodeResult::Succeeded : EBTNodeResult::Failed;
+}
+
+EBTNodeResult::Type UBTTask_EnemyRunCachedQuery::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FRunCachedQueryMemory* Memory = reinterpret_cast<FRunCachedQueryMemory*>(NodeMemory);
+	UEnemyQueryCacheSubsystem* QueryCache = OwnerComp.GetWorld()->GetSubsystem<UEnemyQueryCacheSubsystem>();
+	if (QueryCache && Memory->RequestID != INDEX_NONE)
+		QueryCache->CancelRequest(Memory->RequestID);
+	Memory->RequestID = INDEX_NONE;
+
+	return Super::AbortTask(OwnerComp, NodeMemory);
+}
+
+FString UBTTask_EnemyRunCachedQuery::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s against %s, best %d"), *Super::GetStaticDescription(), *GetNameSafe(Query), *TargetKey.SelectedKeyName.ToString(), PickFromBest);
+}
+
+void UBTTask_EnemyRunCachedQuery::OnQueryResult(const TArray<FVector>& Locations, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp)
+{
+	// Aborting cancels the request, so a live owner is still waiting on this task.
+	UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get();
+	if (!OwnerComp)
+	{
+		return;
+	}
+
+	if (FRunCachedQueryMemory* Memory = reinterpret_cast<FRunCachedQueryMemory*>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this))))
+		Memory->RequestID = INDEX_NONE;
+
+	FinishLatentTask(*OwnerComp, ApplyResult(*OwnerComp, Locations) ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
+
+bool UBTTask_EnemyRunCachedQuery::ApplyResult(UBehaviorTreeComponent& OwnerComp, const TArray<FVector>& Locations) const
+{
+	const APawn* Pawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	if (!Pawn || Locations.Num() == 0)
+	{
+		return false;
+	}
+
+	// Stable per enemy, so an enemy keeps picking the same rank while the result is shared.
+	const int32 Index = Pawn->GetUniqueID() % (uint32)FMath::Min(Locations.Num(), PickFromBest);
+	OwnerComp.GetBlackboardComponent()->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), Locations[Index]);
+	return true;
+}
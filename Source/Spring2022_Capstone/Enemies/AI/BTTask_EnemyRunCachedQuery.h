@@ -0,0 +1,48 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "BTTask_EnemyRunCachedQuery.generated.h"
+
+class UEnvQuery;
+
+/**
+ * Replacement for Run EQS Query in BT_EnemyBase. Asks UEnemyQueryCacheSubsystem for the result of Query against the
+ * actor in TargetKey and writes one of the best locations to the vector in the blackboard key. Enemies sharing a
+ * cached result each pick from its best PickFromBest locations so they don't all run to the same spot.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UBTTask_EnemyRunCachedQuery : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyRunCachedQuery();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(FRunCachedQueryMemory); }
+	virtual FString GetStaticDescription() const override;
+
+private:
+	struct FRunCachedQueryMemory
+	{
+		int32 RequestID;
+	};
+
+	void OnQueryResult(const TArray<FVector>& Locations, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp);
+	bool ApplyResult(UBehaviorTreeComponent& OwnerComp, const TArray<FVector>& Locations) const;
+
+	UPROPERTY(EditAnywhere, Category = "Query")
+	UEnvQuery* Query;
+
+	UPROPERTY(EditAnywhere, Category = "Query")
+	FBlackboardKeySelector TargetKey;
+
+	// Number of best locations enemies spread over.
+	UPROPERTY(EditAnywhere, Category = "Query", meta = (ClampMin = "1"))
+	int32 PickFromBest = 3;
+};
@@ -0,0 +1,161 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CoverPointGraph.h"
+#include "Components/BoxComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+
+bool FCoverPoint::ProtectsFrom(const FVector& ThreatLocation) const
+{
+	return FVector::DotProduct((ThreatLocation - Location).GetSafeNormal2D(), Facing) >= COS_PROTECTED_ANGLE;
+}
+
+bool FCoverPoint::CanSee(const FVector& TargetLocation) const
+{
+	const int32 Bit = GetRegionBit(Location, TargetLocation);
+	return Bit != INDEX_NONE && (VisibleRegions & (1ull << Bit)) != 0;
+}
+
+int32 FCoverPoint::GetRegionBit(const FVector& From, const FVector& To)
+{
+	const int32 DeltaX = FMath::FloorToInt(To.X / REGION_SIZE) - FMath::FloorToInt(From.X / REGION_SIZE);
+	const int32 DeltaY = FMath::FloorToInt(To.Y / REGION_SIZE) - FMath::FloorToInt(From.Y / REGION_SIZE);
+	if (FMath::Abs(DeltaX) > REGION_RADIUS || FMath::Abs(DeltaY) > REGION_RADIUS)
+	{
+		return INDEX_NONE;
+	}
+	return (DeltaY + REGION_RADIUS) * (REGION_RADIUS * 2 + 1) + DeltaX + REGION_RADIUS;
+}
+
+// Sets default values
+ACoverPointGraph::ACoverPointGraph()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	BakeBounds = CreateDefaultSubobject<UBoxComponent>("Bake Bounds");
+	BakeBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	BakeBounds->SetBoxExtent(FVector(2000.f, 2000.f, 500.f));
+	BakeBounds->SetHiddenInGame(true);
+	RootComponent = BakeBounds;
+}
+
+#if WITH_EDITOR
+void ACoverPointGraph::BakeCoverPoints()
+{
+	UWorld* World = GetWorld();
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavSys)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: cover points need a navmesh, build navigation first"), *GetName());
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	Modify();
+	CoverPoints.Reset();
+
+	const FBox Box = BakeBounds->Bounds.GetBox();
+	const FVector ProjectExtent(SampleSpacing * 0.5f, SampleSpacing * 0.5f, Box.GetExtent().Z);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(CoverPointBake), false, this);
+
+	for (float X = Box.Min.X; X <= Box.Max.X; X += SampleSpacing)
+	{
+		for (float Y = Box.Min.Y; Y <= Box.Max.Y; Y += SampleSpacing)
+		{
+			FNavLocation Sample;
+			if (!NavSys->ProjectPointToNavigation(FVector(X, Y, Box.GetCenter().Z), Sample, ProjectExtent))
+				continue;
+
+			for (int32 Probe = 0; Probe < PROBE_DIRECTIONS; Probe++)
+			{
+				const FVector Direction = FRotator(0.f, Probe * 360.f / PROBE_DIRECTIONS, 0.f).Vector();
+				const FVector Start = Sample.Location + FVector(0.f, 0.f, PROBE_HEIGHT);
+
+				// Only walls count, not slopes or steps.
+				FHitResult Hit;
+				if (!World->LineTraceSingleByChannel(Hit, Start, Start + Direction * ProbeDistance, ECC_Visibility, Params) || FMath::Abs(Hit.ImpactNormal.Z) > 0.3f)
+					continue;
+
+				const float Height = MeasureCoverHeight(Sample.Location, Direction, Hit.Distance);
+				if (Height < MinCoverHeight)
+					continue;
+
+				const FVector WallNormal = Hit.ImpactNormal.GetSafeNormal2D();
+				FNavLocation PointLocation;
+				if (!NavSys->ProjectPointToNavigation(FVector(Hit.ImpactPoint.X, Hit.ImpactPoint.Y, Sample.Location.Z) + WallNormal * WallOffset, PointLocation, ProjectExtent))
+					continue;
+
+				const bool bTooClose = CoverPoints.ContainsByPredicate([&](const FCoverPoint& Other)
+				{
+					return FVector::DistSquared(Other.Location, PointLocation.Location) < FMath::Square(MinPointSpacing) && FVector::DotProduct(Other.Facing, -WallNormal) > 0.7f;
+				});
+				if (bTooClose)
+					continue;
+
+				FCoverPoint& Point = CoverPoints.AddDefaulted_GetRef();
+				Point.Location = PointLocation.Location;
+				Point.Facing = -WallNormal;
+				Point.Height = Height;
+			}
+		}
+	}
+
+	for (FCoverPoint& Point : CoverPoints)
+		Point.VisibleRegions = BakeVisibleRegions(Point.Location);
+
+	FlushPersistentDebugLines(World);
+	for (const FCoverPoint& Point : CoverPoints)
+	{
+		DrawDebugDirectionalArrow(World, Point.Location + FVector(0.f, 0.f, 20.f), Point.Location + FVector(0.f, 0.f, 20.f) + Point.Facing * 50.f, 20.f,
+			Point.Height >= MAX_COVER_HEIGHT ? FColor::Blue : FColor::Cyan, true, 10.f);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%s: baked %d cover points in %.1f s"), *GetName(), CoverPoints.Num(), FPlatformTime::Seconds() - StartTime);
+}
+
+float ACoverPointGraph::MeasureCoverHeight(const FVector& Floor, const FVector& Direction, float WallDistance) const
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(CoverPointBake), false, this);
+
+	// Raise the probe until it clears the wall. The top of the cover is below the first height that clears it, which is
+	// reported so a wall topping out between two probes isn't measured a whole step short.
+	for (float Height = PROBE_HEIGHT + HEIGHT_STEP; Height < MAX_COVER_HEIGHT; Height += HEIGHT_STEP)
+	{
+		const FVector Start = Floor + FVector(0.f, 0.f, Height);
+		if (!GetWorld()->LineTraceTestByChannel(Start, Start + Direction * (WallDistance + WallOffset), ECC_Visibility, Params))
+			return Height;
+	}
+	return MAX_COVER_HEIGHT;
+}
+
+uint64 ACoverPointGraph::BakeVisibleRegions(const FVector& PointLocation) const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(CoverPointBake), false, this);
+	const FVector Eye = PointLocation + FVector(0.f, 0.f, FCoverPoint::EYE_HEIGHT);
+	const FVector RegionExtent(FCoverPoint::REGION_SIZE * 0.5f, FCoverPoint::REGION_SIZE * 0.5f, BakeBounds->Bounds.BoxExtent.Z);
+
+	// Each region is represented by the navmesh nearest to its centre, regions nobody can stand in stay hidden.
+	uint64 VisibleRegions = 0;
+	for (int32 DeltaY = -FCoverPoint::REGION_RADIUS; DeltaY <= FCoverPoint::REGION_RADIUS; DeltaY++)
+	{
+		for (int32 DeltaX = -FCoverPoint::REGION_RADIUS; DeltaX <= FCoverPoint::REGION_RADIUS; DeltaX++)
+		{
+			const FVector RegionCentre(
+				(FMath::FloorToInt(PointLocation.X / FCoverPoint::REGION_SIZE) + DeltaX + 0.5f) * FCoverPoint::REGION_SIZE,
+				(FMath::FloorToInt(PointLocation.Y / FCoverPoint::REGION_SIZE) + DeltaY + 0.5f) * FCoverPoint::REGION_SIZE,
+				PointLocation.Z);
+
+			FNavLocation RegionLocation;
+			if (!NavSys->ProjectPointToNavigation(RegionCentre, RegionLocation, RegionExtent))
+				continue;
+
+			if (!GetWorld()->LineTraceTestByChannel(Eye, RegionLocation.Location + FVector(0.f, 0.f, FCoverPoint::EYE_HEIGHT), ECC_Visibility, Params))
+				VisibleRegions |= 1ull << FCoverPoint::GetRegionBit(PointLocation, RegionCentre);
+		}
+	}
+	return VisibleRegions;
+}
+#endif
@@ -0,0 +1,117 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CoverPointGraph.generated.h"
+
+class UBoxComponent;
+
+/**
+ * Cover position baked by ACoverPointGraph.
+ */
+USTRUCT()
+struct FCoverPoint
+{
+	GENERATED_BODY()
+
+	// On the navmesh, just behind the cover.
+	UPROPERTY(VisibleAnywhere, Category = "Cover")
+	FVector Location = FVector::ZeroVector;
+
+	// Flat direction from the point towards the cover.
+	UPROPERTY(VisibleAnywhere, Category = "Cover")
+	FVector Facing = FVector::ForwardVector;
+
+	// Height of the cover above the point.
+	UPROPERTY(VisibleAnywhere, Category = "Cover")
+	float Height = 0;
+
+	// One bit per region around the point that is visible from it at eye height, see GetRegionBit().
+	UPROPERTY()
+	uint64 VisibleRegions = 0;
+
+	// Whether the cover is between the point and a threat at ThreatLocation.
+	bool ProtectsFrom(const FVector& ThreatLocation) const;
+
+	// Whether Location was visible from the point when baked, regions further than REGION_RADIUS count as not visible.
+	bool CanSee(const FVector& Location) const;
+
+	// Bit of the region containing To, relative to the one containing From. INDEX_NONE when out of range.
+	static int32 GetRegionBit(const FVector& From, const FVector& To);
+
+/// Const Variables ///
+	static constexpr float REGION_SIZE = 1000.f;		// Size of the regions visibility is baked for.
+	static constexpr int32 REGION_RADIUS = 3;			// Regions baked in each direction, (2 * 3 + 1)^2 bits fit in VisibleRegions.
+	static constexpr float EYE_HEIGHT = 150.f;			// Height visibility is traced at, roughly a standing enemy's or player's eyes.
+	static constexpr float COS_PROTECTED_ANGLE = 0.5f;	// Threats within 60 degrees of Facing are covered against.
+};
+
+/**
+ * Cover points of a map, baked in the editor from the navmesh and level geometry inside BakeBounds and saved with
+ * the map. Place one or more per map, build navigation, then press Bake Cover Points in the details panel.
+ *
+ * The bake samples the navmesh every SampleSpacing units and probes around each sample for walls. A wall at least
+ * MinCoverHeight tall becomes a cover point facing it, and visibility from the point to the regions around it is
+ * traced once so it never has to be at runtime. UCoverPointSubsystem indexes every graph in the world when play
+ * begins and handles the lookups and reservations.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API ACoverPointGraph : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	ACoverPointGraph();
+
+	const TArray<FCoverPoint>& GetCoverPoints() const { return CoverPoints; }
+
+#if WITH_EDITOR
+	/**
+	 * @brief Replaces the baked cover points with ones found inside BakeBounds. Needs navigation to be built.
+	 */
+	UFUNCTION(CallInEditor, Category = "Cover")
+	void BakeCoverPoints();
+#endif
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "Components", meta = (AllowPrivateAccess = true))
+	UBoxComponent* BakeBounds;
+
+	// Distance between navmesh samples.
+	UPROPERTY(EditAnywhere, Category = "Cover|Bake", meta = (ClampMin = "25"))
+	float SampleSpacing = 100.f;
+
+	// How far from a sample walls are looked for.
+	UPROPERTY(EditAnywhere, Category = "Cover|Bake", meta = (ClampMin = "0"))
+	float ProbeDistance = 120.f;
+
+	// Lowest wall that counts as cover.
+	UPROPERTY(EditAnywhere, Category = "Cover|Bake", meta = (ClampMin = "0"))
+	float MinCoverHeight = 90.f;
+
+	// Distance kept between the point and the wall.
+	UPROPERTY(EditAnywhere, Category = "Cover|Bake", meta = (ClampMin = "0"))
+	float WallOffset = 50.f;
+
+	// Points facing the same way closer than this are merged.
+	UPROPERTY(EditAnywhere, Category = "Cover|Bake", meta = (ClampMin = "0"))
+	float MinPointSpacing = 150.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Cover")
+	TArray<FCoverPoint> CoverPoints;
+
+private:
+#if WITH_EDITOR
+	float MeasureCoverHeight(const FVector& Floor, const FVector& Direction, float WallDistance) const;
+	uint64 BakeVisibleRegions(const FVector& PointLocation) const;
+#endif
+
+/// Const Variables ///
+	const int32 PROBE_DIRECTIONS = 8;		// Directions walls are probed in around each sample.
+	const float PROBE_HEIGHT = 50.f;		// Height of the first probe, low enough to find waist high cover.
+	const float HEIGHT_STEP = 10.f;			// Resolution of the measured cover height, which is rounded up to it.
+	const float MAX_COVER_HEIGHT = 300.f;	// Walls at least this tall count as full cover.
+};
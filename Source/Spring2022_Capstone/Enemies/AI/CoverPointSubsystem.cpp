@@ -0,0 +1,134 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CoverPointSubsystem.h"
+#include "EngineUtils.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+void UCoverPointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<ACoverPointGraph> It(&InWorld); It; ++It)
+		Points.Append(It->GetCoverPoints());
+
+	Occupants.SetNum(Points.Num());
+	ReservedUntil.SetNumZeroed(Points.Num());
+	for (int32 Index = 0; Index < Points.Num(); Index++)
+		Grid.FindOrAdd(GetCell(Points[Index].Location)).Add(Index);
+}
+
+bool UCoverPointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UCoverPointSubsystem::FindCoverPoint(const FCoverPointQuery& Query) const
+{
+	CAPSTONE_SCOPE_COST(AI);
+	if (!Query.Querier || !Query.Threat || Points.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector Origin = Query.Querier->GetActorLocation();
+	const FVector ThreatLocation = Query.Threat->GetActorLocation();
+	const float IdealThreatDistance = FMath::Min(Query.MaxThreatDistance, (Query.MinThreatDistance + Query.MaxThreatDistance) * 0.5f);
+	const FIntPoint MinCell = GetCell(Origin - FVector(Query.SearchRadius));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(Query.SearchRadius));
+
+	int32 BestIndex = INDEX_NONE;
+	float BestScore = MAX_flt;
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			const TArray<int32>* Cell = Grid.Find(FIntPoint(CellX, CellY));
+			if (!Cell)
+				continue;
+
+			for (const int32 Index : *Cell)
+			{
+				const FCoverPoint& Point = Points[Index];
+				const float Distance = FVector::Dist(Point.Location, Origin);
+				const float ThreatDistance = FVector::Dist2D(Point.Location, ThreatLocation);
+				if (Distance > Query.SearchRadius || ThreatDistance < Query.MinThreatDistance || ThreatDistance > Query.MaxThreatDistance || !IsFree(Index, Query.Querier))
+					continue;
+				if ((Query.bRequireCover && !Point.ProtectsFrom(ThreatLocation)) || (Query.bRequireVisibility && !Point.CanSee(ThreatLocation)))
+					continue;
+
+				const float Score = Distance + FMath::Abs(ThreatDistance - IdealThreatDistance);
+				if (Score < BestScore)
+				{
+					BestScore = Score;
+					BestIndex = Index;
+				}
+			}
+		}
+	}
+
+	// The baked data is per region, one trace confirms it for the threat's actual position.
+	if (BestIndex != INDEX_NONE && !ValidatePoint(Points[BestIndex], Query))
+	{
+		return INDEX_NONE;
+	}
+	return BestIndex;
+}
+
+bool UCoverPointSubsystem::ReserveCoverPoint(int32 Index, const AActor* Occupant)
+{
+	if (!Points.IsValidIndex(Index) || !Occupant || !IsFree(Index, Occupant))
+	{
+		return false;
+	}
+
+	// A reservation that ran out still has its occupant listed.
+	if (const AActor* PreviousOccupant = Occupants[Index].Get())
+		Reservations.Remove(PreviousOccupant);
+
+	ReleaseCoverPoint(Occupant);
+	Occupants[Index] = Occupant;
+	ReservedUntil[Index] = GetWorld()->GetTimeSeconds() + ReservationTime;
+	Reservations.Add(Occupant, Index);
+	return true;
+}
+
+void UCoverPointSubsystem::ReleaseCoverPoint(const AActor* Occupant)
+{
+	int32 Index;
+	if (Reservations.RemoveAndCopyValue(Occupant, Index))
+		Occupants[Index].Reset();
+}
+
+FIntPoint UCoverPointSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / IndexCellSize), FMath::FloorToInt(Location.Y / IndexCellSize));
+}
+
+bool UCoverPointSubsystem::IsFree(int32 Index, const AActor* Querier) const
+{
+	const AActor* Occupant = Occupants[Index].Get();
+	return !Occupant || Occupant == Querier || GetWorld()->GetTimeSeconds() > ReservedUntil[Index];
+}
+
+bool UCoverPointSubsystem::ValidatePoint(const FCoverPoint& Point, const FCoverPointQuery& Query) const
+{
+	if (!Query.bRequireVisibility && !Query.bRequireCover)
+	{
+		return true;
+	}
+
+	FVector ThreatEyes;
+	FRotator ThreatRotation;
+	Query.Threat->GetActorEyesViewPoint(ThreatEyes, ThreatRotation);
+
+	// Visibility is checked at eye height, so a point that has to see the threat sees over its cover. Cover alone is
+	// checked at half the cover's height.
+	const float TraceHeight = Query.bRequireVisibility ? FCoverPoint::EYE_HEIGHT : Point.Height * 0.5f;
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(CoverPointValidation), false, Query.Threat);
+	Params.AddIgnoredActor(Query.Querier);
+
+	CAPSTONE_COUNT_SCENE_QUERY();
+	const bool bBlocked = GetWorld()->LineTraceTestByChannel(Point.Location + FVector(0.f, 0.f, TraceHeight), ThreatEyes, ECC_Visibility, Params);
+	return Query.bRequireVisibility ? !bBlocked : bBlocked;
+}
@@ -0,0 +1,89 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CoverPointGraph.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CoverPointSubsystem.generated.h"
+
+/**
+ * What a cover point lookup is after. Points reserved by someone other than Querier are always skipped.
+ */
+struct FCoverPointQuery
+{
+	const AActor* Querier = nullptr;
+	const AActor* Threat = nullptr;
+
+	// Points further than SearchRadius from the querier are not considered.
+	float SearchRadius = 1500.f;
+
+	// Distance to keep from the threat, the middle of the range is preferred.
+	float MinThreatDistance = 0;
+	float MaxThreatDistance = BIG_NUMBER;
+
+	// Cover has to be between the point and the threat.
+	bool bRequireCover = true;
+
+	// The threat has to be visible from the point.
+	bool bRequireVisibility = false;
+};
+
+/**
+ * Runtime side of the baked cover points. Indexes every ACoverPointGraph in the world into a grid when play begins,
+ * answers lookups from the baked data with at most one validation trace, and keeps track of which enemy holds which
+ * point so two enemies never take the same cover. An enemy holds one point at a time, until it releases it or the
+ * reservation runs out after ReservationTime seconds without being renewed.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UCoverPointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/**
+	 * @brief Best free cover point for Query, nearest to the querier and closest to the middle of the threat range.
+	 * @return Index of the point, INDEX_NONE if none matched or the best one failed validation.
+	 */
+	int32 FindCoverPoint(const FCoverPointQuery& Query) const;
+
+	const FCoverPoint& GetCoverPoint(int32 Index) const { return Points[Index]; }
+
+	/**
+	 * @brief Reserves the point at Index for Occupant for ReservationTime seconds, releasing the point Occupant held
+	 * before. Reserving the same point again renews it.
+	 * @return False if someone else holds the point.
+	 */
+	bool ReserveCoverPoint(int32 Index, const AActor* Occupant);
+
+	// Releases the point Occupant holds, if any.
+	void ReleaseCoverPoint(const AActor* Occupant);
+
+	int32 GetCoverPointCount() const { return Points.Num(); }
+	int32 GetReservedCount() const { return Reservations.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+	bool IsFree(int32 Index, const AActor* Querier) const;
+	bool ValidatePoint(const FCoverPoint& Point, const FCoverPointQuery& Query) const;
+
+	// Size of the grid cells points are indexed by.
+	UPROPERTY(Config)
+	float IndexCellSize = 500.f;
+
+	// Seconds a reservation lasts, long enough to reach the point and fight from it. Tasks release theirs sooner.
+	UPROPERTY(Config)
+	float ReservationTime = 10.f;
+
+	TArray<FCoverPoint> Points;
+	TArray<TWeakObjectPtr<const AActor>> Occupants;
+	TArray<float> ReservedUntil;
+	TMap<FIntPoint, TArray<int32>> Grid;
+	TMap<FObjectKey, int32> Reservations;
+};
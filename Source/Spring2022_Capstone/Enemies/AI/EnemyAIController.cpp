@@ -0,0 +1,32 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyAIController.h"
+#include "EnemyLineOfSightSubsystem.h"
+#include "EnemyPathRequestSubsystem.h"
+#include "NavigationData.h"
+
+bool AEnemyAIController::LineOfSightTo(const AActor* Other, FVector ViewPoint, bool bAlternateChecks) const
+{
+	UEnemyLineOfSightSubsystem* LineOfSight = GetWorld()->GetSubsystem<UEnemyLineOfSightSubsystem>();
+	if (!LineOfSight || !GetPawn() || !ViewPoint.IsZero())
+	{
+		return Super::LineOfSightTo(Other, ViewPoint, bAlternateChecks);
+	}
+
+	return LineOfSight->GetLineOfSight(GetPawn(), Other).bHasLineOfSight;
+}
+
+void AEnemyAIController::FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const
+{
+	UEnemyPathRequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UEnemyPathRequestSubsystem>();
+	if (!PathRequests)
+	{
+		Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+		return;
+	}
+
+	OutPath = PathRequests->FindPathNow(this, Query);
+	if (OutPath.IsValid() && MoveRequest.IsMoveToActorRequest())
+		OutPath->SetGoalActorObservation(*MoveRequest.GetGoalActor(), GOAL_ACTOR_TETHER_DISTANCE);
+}
@@ -0,0 +1,33 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "EnemyAIController.generated.h"
+
+/**
+ * Native base for AIC_EnemyBase. LineOfSightTo() calls on the controller, from behavior tree nodes, Blueprints and
+ * gameplay code, are answered from UEnemyLineOfSightSubsystem instead of tracing on the spot. AI perception isn't
+ * affected, UAISense_Sight runs its own traces. Paths for MoveTo(), which the Blueprint AI Move To nodes end up in,
+ * come from UEnemyPathRequestSubsystem, shared with enemies going the same way.
+ *
+ * AIC_EnemyBase still derives from AAIController, so none of this runs until it is reparented onto this class.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API AEnemyAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Cached line of sight from the pawn's eyes to Other, false until the first batched trace came back.
+	 * Checks from a custom ViewPoint still trace straight away.
+	 */
+	virtual bool LineOfSightTo(const AActor* Other, FVector ViewPoint = FVector(ForceInit), bool bAlternateChecks = false) const override;
+
+	virtual void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const override;
+
+/// Const Variables ///
+	const float GOAL_ACTOR_TETHER_DISTANCE = 100.f;		// Distance the goal actor moves before the path is updated, as AAIController uses.
+};
@@ -0,0 +1,172 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyLineOfSightSubsystem.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarLineOfSightDebug(
+		TEXT("Capstone.LOS.Debug"),
+		false,
+		TEXT("Draws the cached enemy line of sight results, green when clear, red when blocked, greyed out as they get stale."),
+		ECVF_Cheat);
+
+	const float DEBUG_STALE_SECONDS = 1.f;		// Age at which a debug line is drawn fully greyed out.
+
+	FVector GetEyeLocation(const AActor* Actor)
+	{
+		FVector Location;
+		FRotator Rotation;
+		Actor->GetActorEyesViewPoint(Location, Rotation);
+		return Location;
+	}
+}
+
+void UEnemyLineOfSightSubsystem::Tick(float DeltaTime)
+{
+	CAPSTONE_SCOPE_COST(AI);
+
+	CollectResults();
+	IssueTraces();
+
+	if (CVarLineOfSightDebug.GetValueOnGameThread())
+		DrawDebug();
+}
+
+TStatId UEnemyLineOfSightSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyLineOfSightSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemyLineOfSightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FEnemyLineOfSight UEnemyLineOfSightSubsystem::GetLineOfSight(const AActor* Viewer, const AActor* Target)
+{
+	FEnemyLineOfSight Result;
+	if (!Viewer || !Target)
+	{
+		return Result;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	FEntry& Entry = Entries.FindOrAdd(TPair<FObjectKey, FObjectKey>(Viewer, Target));
+	Entry.Viewer = Viewer;
+	Entry.Target = Target;
+	Entry.LastRequestTime = Now;
+
+	Result.bValid = Entry.bValid;
+	Result.bHasLineOfSight = Entry.bHasLineOfSight;
+	Result.Age = Entry.bValid ? Now - Entry.ResultTime : 0.f;
+	return Result;
+}
+
+int32 UEnemyLineOfSightSubsystem::GetQueuedCount() const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	int32 Count = 0;
+	for (const TPair<TPair<FObjectKey, FObjectKey>, FEntry>& Pair : Entries)
+	{
+		if (!Pair.Value.TraceHandle.IsValid() && Pair.Value.IsStale(Now, CacheDuration))
+			Count++;
+	}
+	return Count;
+}
+
+float UEnemyLineOfSightSubsystem::GetMaxAge() const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	float MaxAge = 0;
+	for (const TPair<TPair<FObjectKey, FObjectKey>, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.bValid)
+			MaxAge = FMath::Max(MaxAge, (float)(Now - Pair.Value.ResultTime));
+	}
+	return MaxAge;
+}
+
+void UEnemyLineOfSightSubsystem::CollectResults()
+{
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		FEntry& Entry = It.Value();
+		if (!Entry.Viewer.IsValid() || !Entry.Target.IsValid() || Now - Entry.LastRequestTime > RequestTimeout)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (!Entry.TraceHandle.IsValid())
+			continue;
+
+		// Async results only live for a frame or two, a trace missed over a pause is simply requeued.
+		FTraceDatum Datum;
+		if (World->QueryTraceData(Entry.TraceHandle, Datum))
+		{
+			Entry.bHasLineOfSight = !Datum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+			Entry.bValid = true;
+			Entry.ResultTime = Now;
+			Entry.TraceHandle.Invalidate();
+		}
+		else if (!World->IsTraceHandleValid(Entry.TraceHandle, false))
+			Entry.TraceHandle.Invalidate();
+	}
+}
+
+void UEnemyLineOfSightSubsystem::IssueTraces()
+{
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+
+	// Oldest results first, pairs that were never traced before anything else.
+	TArray<FEntry*, TInlineAllocator<64>> Queued;
+	for (TPair<TPair<FObjectKey, FObjectKey>, FEntry>& Pair : Entries)
+	{
+		if (!Pair.Value.TraceHandle.IsValid() && Pair.Value.IsStale(Now, CacheDuration))
+			Queued.Add(&Pair.Value);
+	}
+	Queued.Sort([](const FEntry& A, const FEntry& B) { return A.bValid != B.bValid ? !A.bValid : A.ResultTime < B.ResultTime; });
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	LastFrameTraceCount = 0;
+	for (FEntry* Entry : Queued)
+	{
+		if (LastFrameTraceCount >= MaxTracesPerFrame || FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) >= TimeSliceMs)
+			break;
+
+		// Anything blocking between the two actors, other than themselves, breaks line of sight.
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(EnemyLineOfSight), true, Entry->Viewer.Get());
+		Params.AddIgnoredActor(Entry->Target.Get());
+
+		CAPSTONE_COUNT_SCENE_QUERY();
+		INC_DWORD_STAT(STAT_CapstoneLineOfSightTraces);
+		Entry->TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, GetEyeLocation(Entry->Viewer.Get()), GetEyeLocation(Entry->Target.Get()), ECC_Visibility, Params);
+		LastFrameTraceCount++;
+	}
+}
+
+void UEnemyLineOfSightSubsystem::DrawDebug() const
+{
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+
+	for (const TPair<TPair<FObjectKey, FObjectKey>, FEntry>& Pair : Entries)
+	{
+		const FEntry& Entry = Pair.Value;
+		if (!Entry.bValid || !Entry.Viewer.IsValid() || !Entry.Target.IsValid())
+			continue;
+
+		const FLinearColor ResultColor = Entry.bHasLineOfSight ? FLinearColor::Green : FLinearColor::Red;
+		const float Staleness = FMath::Clamp((float)(Now - Entry.ResultTime) / DEBUG_STALE_SECONDS, 0.f, 1.f);
+		DrawDebugLine(World, GetEyeLocation(Entry.Viewer.Get()), GetEyeLocation(Entry.Target.Get()),
+			FLinearColor::LerpUsingHSV(ResultColor, FLinearColor::Gray, Staleness).ToFColor(true), false, -1.f, 0, 1.f);
+	}
+}
@@ -0,0 +1,103 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "EnemyLineOfSightSubsystem.generated.h"
+
+/**
+ * Cached line of sight result between two actors.
+ */
+USTRUCT(BlueprintType)
+struct FEnemyLineOfSight
+{
+	GENERATED_BODY()
+
+	// False until the first trace for the pair came back, bHasLineOfSight is false until then.
+	UPROPERTY(BlueprintReadOnly)
+	bool bValid = false;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bHasLineOfSight = false;
+
+	// Seconds since the result was traced.
+	UPROPERTY(BlueprintReadOnly)
+	float Age = 0;
+};
+
+/**
+ * Line of sight checks for all enemies, traced asynchronously in batches under a per frame budget.
+ *
+ * Asking for a viewer and target pair returns the cached result and queues a new trace when it is older than
+ * CacheDuration. Each frame the oldest queued pairs are traced, at most MaxTracesPerFrame of them and only while
+ * within TimeSliceMs, so the cost is flat however many enemies ask. Pairs nobody asked about for a while are dropped.
+ *
+ * AEnemyAIController::LineOfSightTo() and UBTDecorator_EnemyHasLineOfSight read from here, Blueprints use
+ * GetLineOfSight(). Neither is in use yet: AIC_EnemyBase has to be reparented onto AEnemyAIController and the
+ * decorator placed in BT_EnemyBase in the editor. Capstone.LOS.Debug 1 draws every cached pair, green or red, fading as the result gets stale.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UEnemyLineOfSightSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Cached line of sight from Viewer's eyes to Target, queues a new trace when the result is stale.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AI")
+	FEnemyLineOfSight GetLineOfSight(const AActor* Viewer, const AActor* Target);
+
+	// Traces issued last frame and pairs still waiting for one, for the overlay.
+	int32 GetLastFrameTraceCount() const { return LastFrameTraceCount; }
+	int32 GetQueuedCount() const;
+
+	// Age of the stalest cached result in seconds.
+	float GetMaxAge() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<const AActor> Viewer;
+		TWeakObjectPtr<const AActor> Target;
+		FTraceHandle TraceHandle;
+		double ResultTime = 0;
+		double LastRequestTime = 0;
+		bool bValid = false;
+		bool bHasLineOfSight = false;
+
+		bool IsStale(double Now, float CacheDuration) const { return !bValid || Now - ResultTime >= CacheDuration; }
+	};
+
+	void CollectResults();
+	void IssueTraces();
+	void DrawDebug() const;
+
+	// Seconds a result is used before it is traced again.
+	UPROPERTY(Config)
+	float CacheDuration = 0.2f;
+
+	// Hard cap on traces started per frame.
+	UPROPERTY(Config)
+	int32 MaxTracesPerFrame = 16;
+
+	// Game thread time spent starting traces per frame.
+	UPROPERTY(Config)
+	float TimeSliceMs = 0.1f;
+
+	// Pairs nobody asked about for this long are dropped.
+	UPROPERTY(Config)
+	float RequestTimeout = 2.f;
+
+	TMap<TPair<FObjectKey, FObjectKey>, FEntry> Entries;
+	int32 LastFrameTraceCount = 0;
+};
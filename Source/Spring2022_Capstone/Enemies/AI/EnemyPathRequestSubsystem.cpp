@@ -0,0 +1,409 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyPathRequestSubsystem.h"
+#include "AIController.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Spring2022_Capstone/Enemies/EncounterDirectorSubsystem.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+namespace
+{
+	FIntVector ToCell(const FVector& Location, float CellSize)
+	{
+		return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+	}
+}
+
+void UEnemyPathRequestSubsystem::Tick(float DeltaTime)
+{
+	CAPSTONE_SCOPE_COST(AI);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// Oldest requests first, a search that can't start this frame keeps its place in the queue. Private searches
+	// go first, their requests already waited on a shared one. FindPathNow's searches this frame count as well.
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	int32 PrivateIndex = 0;
+	TArray<FWaiter> Failed;
+	for (; PrivateIndex < PrivateQueue.Num() && FrameSearches < MaxSearchesPerFrame; PrivateIndex++)
+	{
+		FWaiter& Waiter = PrivateQueue[PrivateIndex];
+		if (!Waiter.Controller.IsValid())
+			continue;
+
+		if (!StartPrivateSearch(NavSys, Waiter))
+			Failed.Add(MoveTemp(Waiter));
+	}
+	PrivateQueue.RemoveAt(0, PrivateIndex, false);
+
+	// Callbacks can request again and grow the queue, so they run once it's trimmed.
+	for (const FWaiter& Waiter : Failed)
+		Waiter.OnResult.ExecuteIfBound(nullptr);
+
+	int32 QueueIndex = 0;
+	for (; QueueIndex < Queue.Num() && FrameSearches < MaxSearchesPerFrame; QueueIndex++)
+	{
+		const FPathKey Key = Queue[QueueIndex];
+		FPathEntry* Entry = Entries.Find(Key);
+		if (!Entry)
+			continue;
+
+		Entry->bQueued = false;
+		Entry->Waiters.RemoveAll([](const FWaiter& Waiter) { return !Waiter.Controller.IsValid(); });
+		if (Entry->Waiters.Num() > 0)
+			StartSearch(NavSys, Key, *Entry);
+	}
+	Queue.RemoveAt(0, QueueIndex, false);
+
+	// Paths past their time that nobody is waiting on.
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		const FPathEntry& Entry = It.Value();
+		if (!Entry.bQueued && !Entry.bRunning && Entry.Waiters.Num() == 0 && (!Entry.bHasResult || Now - Entry.ResultTime >= CacheDuration))
+			It.RemoveCurrent();
+	}
+
+	FrameCycles += FPlatformTime::Cycles64() - StartCycles;
+	RecordCost(DeltaTime);
+}
+
+TStatId UEnemyPathRequestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyPathRequestSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemyPathRequestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UEnemyPathRequestSubsystem::RequestPath(AAIController* Controller, const FVector& Goal, FNavPathSharedPtr& OutPath, FOnEnemyPathResult OnResult)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	ON_SCOPE_EXIT { FrameCycles += FPlatformTime::Cycles64() - StartCycles; };
+
+	OutPath.Reset();
+	if (!Controller || !Controller->GetPawn())
+	{
+		return INDEX_NONE;
+	}
+
+	RequestCount++;
+	FrameRequests++;
+	const FVector Start = Controller->GetNavAgentLocation();
+	const FPathKey Key = { ToCell(Start, StartCellSize), ToCell(Goal, GoalCellSize) };
+	FPathEntry& Entry = Entries.FindOrAdd(Key);
+
+	const int32 RequestID = NextRequestID++;
+	if (Entry.bHasResult && GetWorld()->GetTimeSeconds() - Entry.ResultTime < CacheDuration)
+	{
+		if (MakePath(Entry, Controller, Goal, OutPath))
+		{
+			return INDEX_NONE;
+		}
+		PrivateQueue.Add({ RequestID, Controller, Goal, MoveTemp(OnResult) });
+		return RequestID;
+	}
+
+	Entry.Waiters.Add({ RequestID, Controller, Goal, MoveTemp(OnResult) });
+
+	// A search already queued or running for these cells answers everyone waiting on it, the first request
+	// decides where exactly it goes.
+	if (!Entry.bQueued && !Entry.bRunning)
+	{
+		Entry.Start = Start;
+		Entry.Goal = Goal;
+		Entry.bQueued = true;
+		Queue.Add(Key);
+	}
+	return RequestID;
+}
+
+FNavPathSharedPtr UEnemyPathRequestSubsystem::FindPathNow(const AAIController* Controller, const FPathFindingQuery& Query)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	ON_SCOPE_EXIT { FrameCycles += FPlatformTime::Cycles64() - StartCycles; };
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!Controller || !NavSys)
+	{
+		return nullptr;
+	}
+
+	RequestCount++;
+	FrameRequests++;
+	const FPathKey Key = { ToCell(Query.StartLocation, StartCellSize), ToCell(Query.EndLocation, GoalCellSize) };
+	FPathEntry& Entry = Entries.FindOrAdd(Key);
+
+	FNavPathSharedPtr Path;
+	if (Entry.bHasResult && GetWorld()->GetTimeSeconds() - Entry.ResultTime < CacheDuration && MakePath(Entry, Controller, Query.EndLocation, Path))
+	{
+		return Path;
+	}
+
+	// Past the frame's searches the entry is searched asynchronously instead, the waiter only keeps the search
+	// going. An older path from the same cells, when there is one, keeps the enemy moving meanwhile.
+	if (FrameSearches >= MaxSearchesPerFrame)
+	{
+		Entry.Waiters.Add({ NextRequestID++, Controller, Query.EndLocation, FOnEnemyPathResult() });
+		if (!Entry.bQueued && !Entry.bRunning)
+		{
+			Entry.Start = Query.StartLocation;
+			Entry.Goal = Query.EndLocation;
+			Entry.bQueued = true;
+			Queue.Add(Key);
+		}
+		if (Entry.bHasResult && MakePath(Entry, Controller, Query.EndLocation, Path))
+		{
+			return Path;
+		}
+		return nullptr;
+	}
+
+	INC_DWORD_STAT(STAT_CapstonePathSearches);
+	FrameSearches++;
+	SearchCount++;
+	const FPathFindingResult Result = NavSys->FindPathSync(Query);
+	Path = Result.IsSuccessful() ? Result.Path : nullptr;
+	if (Path.IsValid())
+		Path->EnableRecalculationOnInvalidation(true);
+
+	// A search of the entry's own is running or about to, it will share its result.
+	if (!Entry.bQueued && !Entry.bRunning)
+	{
+		Entry.Start = Query.StartLocation;
+		Entry.Goal = Query.EndLocation;
+		Entry.NavData = Query.NavData;
+		Entry.bHasResult = true;
+		Entry.ResultTime = GetWorld()->GetTimeSeconds();
+		SetEntryPoints(Entry, Path);
+	}
+	return Path;
+}
+
+void UEnemyPathRequestSubsystem::CancelRequest(int32 RequestID)
+{
+	const auto IsRequest = [RequestID](const FWaiter& Waiter) { return Waiter.RequestID == RequestID; };
+	if (PrivateQueue.RemoveAll(IsRequest) > 0)
+	{
+		return;
+	}
+	for (auto It = RunningPrivateSearches.CreateIterator(); It; ++It)
+	{
+		if (IsRequest(It.Value()))
+		{
+			It.RemoveCurrent();
+			return;
+		}
+	}
+	for (TPair<FPathKey, FPathEntry>& Pair : Entries)
+	{
+		if (Pair.Value.Waiters.RemoveAll(IsRequest) > 0)
+			return;
+	}
+}
+
+void UEnemyPathRequestSubsystem::ResetCostStats()
+{
+	CostByEnemyCount.Reset();
+}
+
+bool UEnemyPathRequestSubsystem::StartSearch(UNavigationSystemV1* NavSys, const FPathKey& Key, FPathEntry& Entry)
+{
+	const AAIController* Controller = Entry.Waiters[0].Controller.Get();
+	const FNavAgentProperties& AgentProperties = Controller->GetNavAgentPropertiesRef();
+	const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(AgentProperties) : nullptr;
+	if (!NavData)
+	{
+		Entry.Points.Reset();
+		FinishEntry(Entry);
+		return false;
+	}
+
+	const FPathFindingQuery Query(Controller, *NavData, Entry.Start, Entry.Goal, UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, nullptr));
+	const uint32 QueryID = NavSys->FindPathAsync(AgentProperties, Query, FNavPathQueryDelegate::CreateUObject(this, &UEnemyPathRequestSubsystem::OnPathFound));
+	if (QueryID == INVALID_NAVQUERYID)
+	{
+		Entry.Points.Reset();
+		FinishEntry(Entry);
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_CapstonePathSearches);
+	Entry.NavData = NavData;
+	Entry.bRunning = true;
+	RunningSearches.Add(QueryID, Key);
+	FrameSearches++;
+	SearchCount++;
+	return true;
+}
+
+bool UEnemyPathRequestSubsystem::StartPrivateSearch(UNavigationSystemV1* NavSys, FWaiter& Waiter)
+{
+	const AAIController* Controller = Waiter.Controller.Get();
+	const FNavAgentProperties& AgentProperties = Controller->GetNavAgentPropertiesRef();
+	const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(AgentProperties) : nullptr;
+	if (!NavData)
+	{
+		return false;
+	}
+
+	const FPathFindingQuery Query(Controller, *NavData, Controller->GetNavAgentLocation(), Waiter.Goal, UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, nullptr));
+	const uint32 QueryID = NavSys->FindPathAsync(AgentProperties, Query, FNavPathQueryDelegate::CreateUObject(this, &UEnemyPathRequestSubsystem::OnPrivatePathFound));
+	if (QueryID == INVALID_NAVQUERYID)
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_CapstonePathSearches);
+	RunningPrivateSearches.Add(QueryID, MoveTemp(Waiter));
+	FrameSearches++;
+	SearchCount++;
+	return true;
+}
+
+void UEnemyPathRequestSubsystem::OnPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FPathKey Key;
+	if (!RunningSearches.RemoveAndCopyValue(QueryID, Key))
+	{
+		return;
+	}
+	FPathEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	// A failed search is shared as well, so a cell with no way through isn't searched again every frame.
+	Entry->bRunning = false;
+	SetEntryPoints(*Entry, Result == ENavigationQueryResult::Success ? Path : nullptr);
+	FinishEntry(*Entry);
+}
+
+void UEnemyPathRequestSubsystem::OnPrivatePathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FWaiter Waiter;
+	if (RunningPrivateSearches.RemoveAndCopyValue(QueryID, Waiter) && Waiter.Controller.IsValid())
+		Waiter.OnResult.ExecuteIfBound(Result == ENavigationQueryResult::Success ? Path : nullptr);
+}
+
+void UEnemyPathRequestSubsystem::FinishEntry(FPathEntry& Entry)
+{
+	Entry.bHasResult = true;
+	Entry.ResultTime = GetWorld()->GetTimeSeconds();
+
+	// Callbacks can request again and grow Entries, so nothing from the entry is touched while they run.
+	const TArray<FWaiter> Waiters = MoveTemp(Entry.Waiters);
+	Entry.Waiters.Reset();
+
+	// Waiters the shared path doesn't fit queue for their own search and are called back once it's done.
+	TArray<FWaiter> Finished;
+	TArray<FNavPathSharedPtr, TInlineAllocator<8>> Paths;
+	for (const FWaiter& Waiter : Waiters)
+	{
+		FNavPathSharedPtr Path;
+		if (MakePath(Entry, Waiter.Controller.Get(), Waiter.Goal, Path))
+		{
+			Finished.Add(Waiter);
+			Paths.Add(Path);
+		}
+		// FindPathNow's waiters only wanted the shared path searched, they ask again on their next move.
+		else if (Waiter.OnResult.IsBound())
+			PrivateQueue.Add(Waiter);
+	}
+
+	for (int32 Index = 0; Index < Finished.Num(); Index++)
+		Finished[Index].OnResult.ExecuteIfBound(Paths[Index]);
+}
+
+void UEnemyPathRequestSubsystem::SetEntryPoints(FPathEntry& Entry, const FNavPathSharedPtr& Path) const
+{
+	Entry.Points.Reset();
+	if (!Path.IsValid())
+	{
+		return;
+	}
+	for (const FNavPathPoint& Point : Path->GetPathPoints())
+		Entry.Points.Add(Point.Location);
+}
+
+bool UEnemyPathRequestSubsystem::MakePath(const FPathEntry& Entry, const AAIController* Controller, const FVector& Goal, FNavPathSharedPtr& OutPath) const
+{
+	OutPath.Reset();
+	if (!Controller || Entry.Points.Num() < 2)
+	{
+		return true;
+	}
+
+	// Every enemy follows its own copy from its feet to its own goal. The cells are small, but a wall or ledge can
+	// still sit between the enemy and the shared path, so both straight legs are checked on the navmesh first.
+	// The copy is registered with the navigation data it came from, so it is searched again when the navmesh under
+	// it changes. An enemy of another agent size needs its own search.
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(Controller->GetNavAgentPropertiesRef()) : nullptr;
+	if (!NavData || NavData != Entry.NavData.Get())
+	{
+		return false;
+	}
+
+	TArray<FVector> Points = Entry.Points;
+	FVector HitLocation;
+	const FVector Start = Controller->GetNavAgentLocation();
+	if (!Start.Equals(Points[0]))
+	{
+		if (NavData->Raycast(Start, Points[1], HitLocation, NavData->GetDefaultQueryFilter(), Controller))
+		{
+			return false;
+		}
+		Points[0] = Start;
+	}
+
+	// A goal off the navmesh keeps the end of the shared path.
+	FNavLocation GoalOnNavMesh;
+	if (NavSys->ProjectPointToNavigation(Goal, GoalOnNavMesh) && !GoalOnNavMesh.Location.Equals(Points.Last()))
+	{
+		if (NavData->Raycast(Points[Points.Num() - 2], GoalOnNavMesh.Location, HitLocation, NavData->GetDefaultQueryFilter(), Controller))
+		{
+			return false;
+		}
+		Points.Last() = GoalOnNavMesh.Location;
+	}
+
+	OutPath = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points);
+	OutPath->SetNavigationDataUsed(NavData);
+	OutPath->SetQuerier(Controller);
+	OutPath->SetFilter(UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, nullptr));
+	OutPath->EnableRecalculationOnInvalidation(true);
+	NavData->RegisterActivePath(OutPath);
+	return true;
+}
+
+void UEnemyPathRequestSubsystem::RecordCost(float DeltaTime)
+{
+	const UEncounterDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEncounterDirectorSubsystem>();
+	const int32 EnemyCount = Director ? Director->GetActiveEnemyCount() : 0;
+
+	// Buckets of 1, 2-3, 4-7 and so on active enemies.
+	const int32 Bucket = EnemyCount > 0 ? FMath::FloorLog2(EnemyCount) + 1 : 0;
+	while (CostByEnemyCount.Num() <= Bucket)
+	{
+		const int32 Index = CostByEnemyCount.Num();
+		CostByEnemyCount.AddDefaulted_GetRef().MinEnemies = Index > 0 ? 1 << (Index - 1) : 0;
+	}
+
+	FEnemyPathCost& Cost = CostByEnemyCount[Bucket];
+	Cost.Frames++;
+	Cost.EnemyFrames += EnemyCount;
+	Cost.EnemySeconds += EnemyCount * DeltaTime;
+	Cost.Requests += FrameRequests;
+	Cost.Searches += FrameSearches;
+	Cost.GameThreadMs += FPlatformTime::ToMilliseconds64(FrameCycles);
+
+	LastFrameSearchCount = FrameSearches;
+	FrameRequests = 0;
+	FrameSearches = 0;
+	FrameCycles = 0;
+}
@@ -0,0 +1,162 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPathRequestSubsystem.generated.h"
+
+class AAIController;
+class UNavigationSystemV1;
+
+DECLARE_DELEGATE_OneParam(FOnEnemyPathResult, FNavPathSharedPtr /* Path, null when none was found */);
+
+/**
+ * Path requests and searches while a number of enemies was active, for the benchmark.
+ */
+struct FEnemyPathCost
+{
+	int32 MinEnemies = 0;
+	int32 Frames = 0;
+	int64 EnemyFrames = 0;
+	float EnemySeconds = 0;
+	int32 Requests = 0;
+	int32 Searches = 0;
+	double GameThreadMs = 0;
+
+	float GetSearchesPerEnemySecond() const { return EnemySeconds > 0 ? Searches / EnemySeconds : 0.f; }
+	float GetGameThreadUsPerEnemyFrame() const { return EnemyFrames > 0 ? GameThreadMs * 1000.0 / EnemyFrames : 0.f; }
+};
+
+/**
+ * Finds paths for all enemies, asynchronously and shared between enemies going the same way.
+ *
+ * Requests are grouped by the StartCellSize cell they start in and the GoalCellSize cell they go to. One search
+ * per group runs on the navigation system's async path finding, at most MaxSearchesPerFrame started per frame,
+ * and everyone in the group gets a copy of its path for CacheDuration seconds. Each copy starts at the enemy's
+ * own feet and ends at its own goal, the shared part in between is what the search found. When the navmesh doesn't
+ * allow a straight line from the enemy to the shared path, or from it to the enemy's goal, the enemy gets a search
+ * of its own instead, queued like the shared ones.
+ *
+ * Cost is recorded per power of two of active enemies, the benchmark logs it to show the cost per enemy falling
+ * as more of them share paths.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UEnemyPathRequestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Asks for a path for Controller's pawn to Goal.
+	 * @return INDEX_NONE - OutPath was filled from the cache, null when no path was found, and OnResult won't be
+	 * called. Otherwise the ID of the request, OnResult is called once the search finished.
+	 */
+	int32 RequestPath(AAIController* Controller, const FVector& Goal, FNavPathSharedPtr& OutPath, FOnEnemyPathResult OnResult);
+
+	/**
+	 * @brief Answers Query right away, for moves that need their path in the same call like AAIController::MoveTo.
+	 * Uses the shared path from Query's cells when one is cached, searches synchronously otherwise and shares the
+	 * result with the requests that follow. The synchronous search counts against MaxSearchesPerFrame, past it the
+	 * search is queued like RequestPath's and an older path from the same cells is used until it's done.
+	 * @return Null when no path was found, or none is known yet and the frame's searches are used up.
+	 */
+	FNavPathSharedPtr FindPathNow(const AAIController* Controller, const FPathFindingQuery& Query);
+
+	// Drops a request so its callback is never called, e.g. when the asking task is aborted.
+	void CancelRequest(int32 RequestID);
+
+	// Searches started last frame, groups and single requests waiting for a search and the share of requests that
+	// didn't need their own search, for the overlay.
+	int32 GetLastFrameSearchCount() const { return LastFrameSearchCount; }
+	int32 GetQueuedCount() const { return Queue.Num() + PrivateQueue.Num(); }
+	float GetSharedFraction() const { return RequestCount > 0 ? 1.f - (float)SearchCount / RequestCount : 0.f; }
+
+	// Cost per power of two of active enemies since the last ResetCostStats(), empty buckets included.
+	const TArray<FEnemyPathCost>& GetCostByEnemyCount() const { return CostByEnemyCount; }
+	void ResetCostStats();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPathKey
+	{
+		FIntVector StartCell;
+		FIntVector GoalCell;
+
+		bool operator==(const FPathKey& Other) const { return StartCell == Other.StartCell && GoalCell == Other.GoalCell; }
+		friend uint32 GetTypeHash(const FPathKey& Key) { return HashCombine(GetTypeHash(Key.StartCell), GetTypeHash(Key.GoalCell)); }
+	};
+
+	struct FWaiter
+	{
+		int32 RequestID;
+		TWeakObjectPtr<const AAIController> Controller;
+		FVector Goal;
+		FOnEnemyPathResult OnResult;
+	};
+
+	struct FPathEntry
+	{
+		FVector Start;
+		FVector Goal;
+		TArray<FVector> Points;
+		TWeakObjectPtr<const ANavigationData> NavData;
+		TArray<FWaiter> Waiters;
+		double ResultTime = 0;
+		bool bHasResult = false;
+		bool bQueued = false;
+		bool bRunning = false;
+	};
+
+	bool StartSearch(UNavigationSystemV1* NavSys, const FPathKey& Key, FPathEntry& Entry);
+	bool StartPrivateSearch(UNavigationSystemV1* NavSys, FWaiter& Waiter);
+	void OnPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	void OnPrivatePathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	void FinishEntry(FPathEntry& Entry);
+	void SetEntryPoints(FPathEntry& Entry, const FNavPathSharedPtr& Path) const;
+
+	/**
+	 * @brief Fits Entry's shared path to Controller's pawn and Goal.
+	 * @return false - the shared path doesn't fit, the enemy needs its own search. OutPath is null when the shared
+	 * search found no path.
+	 */
+	bool MakePath(const FPathEntry& Entry, const AAIController* Controller, const FVector& Goal, FNavPathSharedPtr& OutPath) const;
+	void RecordCost(float DeltaTime);
+
+	// Size of the cells paths are shared in.
+	UPROPERTY(Config)
+	float StartCellSize = 300.f;
+	UPROPERTY(Config)
+	float GoalCellSize = 300.f;
+
+	// Seconds a path is handed out before it is searched again.
+	UPROPERTY(Config)
+	float CacheDuration = 1.f;
+
+	// Searches started per frame, FindPathNow's synchronous ones included, the rest wait in the queue.
+	UPROPERTY(Config)
+	int32 MaxSearchesPerFrame = 4;
+
+	TMap<FPathKey, FPathEntry> Entries;
+	TArray<FPathKey> Queue;
+	TMap<uint32, FPathKey> RunningSearches;
+	// Requests the shared path didn't fit, waiting for and running their own search.
+	TArray<FWaiter> PrivateQueue;
+	TMap<uint32, FWaiter> RunningPrivateSearches;
+	int32 NextRequestID = 0;
+
+	int32 LastFrameSearchCount = 0;
+	int32 FrameSearches = 0;
+	int32 RequestCount = 0;
+	int32 SearchCount = 0;
+
+	TArray<FEnemyPathCost> CostByEnemyCount;
+	int32 FrameRequests = 0;
+	uint64 FrameCycles = 0;
+};
@@ -0,0 +1,157 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyQueryCacheSubsystem.h"
+#include "Engine/World.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "EnvironmentQuery/EnvQueryManager.h"
+#include "GameFramework/Pawn.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+namespace
+{
+	FIntVector ToCell(const FVector& Location, float CellSize)
+	{
+		return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+	}
+}
+
+void UEnemyQueryCacheSubsystem::Tick(float DeltaTime)
+{
+	CAPSTONE_SCOPE_COST(AI);
+
+	// Oldest requests first, a query that can't start this frame keeps its place in the queue.
+	LastFrameQueryCount = 0;
+	int32 QueueIndex = 0;
+	for (; QueueIndex < Queue.Num() && LastFrameQueryCount < MaxQueriesPerFrame; QueueIndex++)
+	{
+		const FQueryKey Key = Queue[QueueIndex];
+		FCacheEntry* Entry = Entries.Find(Key);
+		if (!Entry)
+			continue;
+
+		Entry->bQueued = false;
+		Entry->Waiters.RemoveAll([](const FWaiter& Waiter) { return !Waiter.Querier.IsValid(); });
+		if (Entry->Waiters.Num() > 0 && Entry->Query.IsValid())
+			StartQuery(Key, *Entry);
+	}
+	Queue.RemoveAt(0, QueueIndex, false);
+
+	// Results past their time that nobody is waiting on.
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		const FCacheEntry& Entry = It.Value();
+		if (!Entry.bQueued && !Entry.bRunning && Entry.Waiters.Num() == 0 && (!Entry.bHasResult || Now - Entry.ResultTime >= CacheDuration))
+			It.RemoveCurrent();
+	}
+}
+
+TStatId UEnemyQueryCacheSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyQueryCacheSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemyQueryCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UEnemyQueryCacheSubsystem::RequestQuery(UEnvQuery* Query, APawn* Querier, const FVector& TargetLocation, TArray<FVector>& OutLocations, FOnEnemyQueryResult OnResult)
+{
+	OutLocations.Reset();
+	if (!Query || !Querier)
+	{
+		return INDEX_NONE;
+	}
+
+	const FQueryKey Key = { FObjectKey(Query), ToCell(Querier->GetActorLocation(), CellSize), ToCell(TargetLocation, TargetCellSize) };
+	FCacheEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.Query = Query;
+
+	if (Entry.bHasResult && GetWorld()->GetTimeSeconds() - Entry.ResultTime < CacheDuration)
+	{
+		CacheHitCount++;
+		OutLocations = Entry.Locations;
+		return INDEX_NONE;
+	}
+
+	CacheMissCount++;
+	const int32 RequestID = NextRequestID++;
+	Entry.Waiters.Add({ RequestID, Querier, MoveTemp(OnResult) });
+
+	// A query already queued or running for this cell answers everyone waiting on it.
+	if (!Entry.bQueued && !Entry.bRunning)
+	{
+		Entry.bQueued = true;
+		Queue.Add(Key);
+	}
+	return RequestID;
+}
+
+void UEnemyQueryCacheSubsystem::CancelRequest(int32 RequestID)
+{
+	for (TPair<FQueryKey, FCacheEntry>& Pair : Entries)
+	{
+		if (Pair.Value.Waiters.RemoveAll([RequestID](const FWaiter& Waiter) { return Waiter.RequestID == RequestID; }) > 0)
+			return;
+	}
+}
+
+void UEnemyQueryCacheSubsystem::StartQuery(const FQueryKey& Key, FCacheEntry& Entry)
+{
+	// Whoever asked first runs the query, the contexts resolve from them.
+	FEnvQueryRequest Request(Entry.Query.Get(), Entry.Waiters[0].Querier.Get());
+	const int32 QueryID = Request.Execute(EEnvQueryRunMode::AllMatching, FQueryFinishedSignature::CreateUObject(this, &UEnemyQueryCacheSubsystem::OnQueryFinished));
+	if (QueryID == INDEX_NONE)
+	{
+		Entry.Locations.Reset();
+		FinishEntry(Entry);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_CapstoneEnvQueries);
+	Entry.bRunning = true;
+	RunningQueries.Add(QueryID, Key);
+	LastFrameQueryCount++;
+}
+
+void UEnemyQueryCacheSubsystem::OnQueryFinished(TSharedPtr<FEnvQueryResult> Result)
+{
+	FQueryKey Key;
+	if (!Result.IsValid() || !RunningQueries.RemoveAndCopyValue(Result->QueryID, Key))
+	{
+		return;
+	}
+	FCacheEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	// All matching results come back sorted by score. A failed query is cached as well, so a cell without cover
+	// isn't queried again every frame.
+	Entry->bRunning = false;
+	Entry->Locations.Reset();
+	if (Result->IsSuccessful())
+	{
+		const int32 Count = FMath::Min(Result->Items.Num(), MaxResults);
+		for (int32 Index = 0; Index < Count; Index++)
+			Entry->Locations.Add(Result->GetItemAsLocation(Index));
+	}
+	FinishEntry(*Entry);
+}
+
+void UEnemyQueryCacheSubsystem::FinishEntry(FCacheEntry& Entry)
+{
+	Entry.bHasResult = true;
+	Entry.ResultTime = GetWorld()->GetTimeSeconds();
+
+	// Callbacks can request again and grow Entries, so nothing from the entry is touched while they run.
+	const TArray<FWaiter> Waiters = MoveTemp(Entry.Waiters);
+	const TArray<FVector> Locations = Entry.Locations;
+	Entry.Waiters.Reset();
+
+	for (const FWaiter& Waiter : Waiters)
+		Waiter.OnResult.ExecuteIfBound(Locations);
+}
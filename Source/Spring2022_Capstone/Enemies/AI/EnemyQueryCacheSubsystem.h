@@ -0,0 +1,112 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "EnemyQueryCacheSubsystem.generated.h"
+
+class UEnvQuery;
+
+DECLARE_DELEGATE_OneParam(FOnEnemyQueryResult, const TArray<FVector>& /* Locations, best first */);
+
+/**
+ * Shares environment query results between enemies and spreads the queries over frames.
+ *
+ * Results are cached per query, per CellSize cell of the enemy asking and per TargetCellSize cell of its target, so
+ * enemies standing near each other and fighting the same target reuse one EQS_FindCover or EQS_Strafe run instead
+ * of each running their own. Requests that miss the cache are queued and at most MaxQueriesPerFrame start each
+ * frame, the EQS manager then time slices their tests across frames (MaxAllowedTestingTime in DefaultGame.ini).
+ * Requests for a query that is already running wait for it instead of starting another one.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UEnemyQueryCacheSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Asks for the result of Query run by Querier against a target at TargetLocation.
+	 * @return INDEX_NONE - OutLocations was filled from the cache and OnResult won't be called.
+	 * Otherwise the ID of the request, OnResult is called once the query ran, with no locations if it failed.
+	 */
+	int32 RequestQuery(UEnvQuery* Query, APawn* Querier, const FVector& TargetLocation, TArray<FVector>& OutLocations, FOnEnemyQueryResult OnResult);
+
+	// Drops a request so its callback is never called, e.g. when the asking task is aborted.
+	void CancelRequest(int32 RequestID);
+
+	// Queries started last frame, queries waiting to start, requests answered from the cache and requests that had
+	// to wait, for the overlay.
+	int32 GetLastFrameQueryCount() const { return LastFrameQueryCount; }
+	int32 GetQueuedCount() const { return Queue.Num(); }
+	int32 GetCacheHitCount() const { return CacheHitCount; }
+	int32 GetCacheMissCount() const { return CacheMissCount; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FQueryKey
+	{
+		FObjectKey Query;
+		FIntVector QuerierCell;
+		FIntVector TargetCell;
+
+		bool operator==(const FQueryKey& Other) const { return Query == Other.Query && QuerierCell == Other.QuerierCell && TargetCell == Other.TargetCell; }
+		friend uint32 GetTypeHash(const FQueryKey& Key) { return HashCombine(GetTypeHash(Key.Query), HashCombine(GetTypeHash(Key.QuerierCell), GetTypeHash(Key.TargetCell))); }
+	};
+
+	struct FWaiter
+	{
+		int32 RequestID;
+		TWeakObjectPtr<APawn> Querier;
+		FOnEnemyQueryResult OnResult;
+	};
+
+	struct FCacheEntry
+	{
+		TWeakObjectPtr<UEnvQuery> Query;
+		TArray<FVector> Locations;
+		TArray<FWaiter> Waiters;
+		double ResultTime = 0;
+		bool bHasResult = false;
+		bool bQueued = false;
+		bool bRunning = false;
+	};
+
+	void StartQuery(const FQueryKey& Key, FCacheEntry& Entry);
+	void OnQueryFinished(TSharedPtr<FEnvQueryResult> Result);
+	void FinishEntry(FCacheEntry& Entry);
+
+	// Size of the cells enemies and targets are grouped by.
+	UPROPERTY(Config)
+	float CellSize = 400.f;
+	UPROPERTY(Config)
+	float TargetCellSize = 400.f;
+
+	// Seconds a result is handed out before the query runs again.
+	UPROPERTY(Config)
+	float CacheDuration = 1.5f;
+
+	// Queries started per frame, the rest wait in the queue.
+	UPROPERTY(Config)
+	int32 MaxQueriesPerFrame = 2;
+
+	// Best locations kept per result.
+	UPROPERTY(Config)
+	int32 MaxResults = 8;
+
+	TMap<FQueryKey, FCacheEntry> Entries;
+	TArray<FQueryKey> Queue;
+	TMap<int32, FQueryKey> RunningQueries;
+	int32 NextRequestID = 0;
+
+	int32 LastFrameQueryCount = 0;
+	int32 CacheHitCount = 0;
+	int32 CacheMissCount = 0;
+};
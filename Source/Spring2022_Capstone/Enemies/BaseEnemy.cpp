@@ -4,10 +4,20 @@
 #include "Spring2022_Capstone/HealthComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "AIController.h"
+#include "BrainComponent.h"
+#include "AI/CoverPointSubsystem.h"
+#include "AI/EnemyAIController.h"
+#include "EnemyAttackSchedulerSubsystem.h"
+#include "EnemyPoolSubsystem.h"
+#include "EnemySignificanceSubsystem.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "NavigationInvokerComponent.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
 
 // Sets default values
 ABaseEnemy::ABaseEnemy()
 {
+	CAPSTONE_LLM_SCOPE(Capstone_AI);
 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -18,20 +28,139 @@ ABaseEnemy::ABaseEnemy()
 
 	ProjectileSpawnPoint = CreateDefaultSubobject<USceneComponent>(TEXT("ProjectileSpawnPoint"));
 	ProjectileSpawnPoint->SetupAttachment(WeaponMesh);
+
+	NavigationInvoker = CreateDefaultSubobject<UNavigationInvokerComponent>(TEXT("NavigationInvoker"));
+	NavigationInvoker->SetGenerationRadii(NAV_GENERATION_RADIUS, NAV_REMOVAL_RADIUS);
+
+	AIControllerClass = AEnemyAIController::StaticClass();
+
+	// Animation rates are scaled by screen size and significance, see UEnemySignificanceSubsystem.
+	GetMesh()->bEnableUpdateRateOptimizations = true;
 }
 
 // Called when the game starts or when spawned
 void ABaseEnemy::BeginPlay()
 {
+	CAPSTONE_LLM_SCOPE(Capstone_AI);
 	Super::BeginPlay();
+
+	ResetAttackState();
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+		Significance->RegisterEnemy(this);
+}
+
+void ABaseEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+		Significance->UnregisterEnemy(this);
+	if (UCoverPointSubsystem* CoverPoints = GetWorld()->GetSubsystem<UCoverPointSubsystem>())
+		CoverPoints->ReleaseCoverPoint(this);
+	if (UEnemyAttackSchedulerSubsystem* AttackScheduler = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+		AttackScheduler->CancelAttack(this);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ABaseEnemy::Attack()
 {
+	AActor* Target = GetCurrentAttackTarget();
+	if (UEnemyAttackSchedulerSubsystem* AttackScheduler = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+		AttackScheduler->RequestAttack(this, Target, FOnEnemyAttackFinished());
+	else if (Target)
+		AttackTarget(Target);
+}
+
+void ABaseEnemy::PerformAttack()
+{
+	LastAttackTime = GetWorld()->GetTimeSeconds();
+}
+
+void ABaseEnemy::AttackTarget(AActor* Target)
+{
+	CurrentAttackTarget = Target;
+	PerformAttack();
+}
+
+AActor* ABaseEnemy::GetCurrentAttackTarget() const
+{
+	return CurrentAttackTarget.IsValid() ? CurrentAttackTarget.Get() : UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+}
+
+void ABaseEnemy::DamageActor(AActor* DamagingActor, const float DamageAmount)
+{
+	CAPSTONE_TRACE_SCOPE(STAT_CapstoneDamage);
+
+	// Several hits can land in the frame the enemy dies.
+	if (HealthComponent->GetHealth() <= 0)
+	{
+		return;
+	}
+
+	HealthComponent->SetHealth(HealthComponent->GetHealth() - DamageAmount);
+	if (HealthComponent->GetHealth() <= 0)
+		Die();
+}
+
+void ABaseEnemy::Die()
+{
+	UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+	if (Pool && Pool->Release(this))
+	{
+		return;
+	}
+
+	// Level placed enemies stay possessed, a snapshot restarting their tree brings them back.
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		AIController->StopMovement();
+		AIController->ClearFocus(EAIFocusPriority::Gameplay);
+		if (UBrainComponent* BrainComponent = AIController->GetBrainComponent())
+		{
+			BrainComponent->ResumeLogic(TEXT("Dormant"));
+			BrainComponent->StopLogic(TEXT("Dead"));
+		}
+	}
+	SetEnemyActive(false);
+}
+
+void ABaseEnemy::SetEnemyActive(bool bActive)
+{
+	bIsActive = bActive;
+	SetActorHiddenInGame(!bActive);
+	SetActorEnableCollision(bActive);
+	SetActorTickEnabled(bActive);
+	GetCharacterMovement()->SetComponentTickEnabled(bActive);
+	GetMesh()->SetComponentTickEnabled(bActive);
+
+	UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>();
+	if (bActive)
+	{
+		HealthComponent->SetHealth(HealthComponent->GetMaxHealth());
+		LastAttackTime = TNumericLimits<float>::Lowest();
+		CurrentAttackTarget.Reset();
+		ResetAttackState();
+		GetCharacterMovement()->SetDefaultMovementMode();
+		NavigationInvoker->Activate(true);
+		if (Significance)
+			Significance->RegisterEnemy(this);
+		return;
+	}
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	// Pooled enemies wait far below the level, no navmesh is wanted there.
+	NavigationInvoker->Deactivate();
+	if (Significance)
+		Significance->UnregisterEnemy(this);
+	if (UEnemyAttackSchedulerSubsystem* AttackScheduler = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+		AttackScheduler->CancelAttack(this);
+	if (UCoverPointSubsystem* CoverPoints = GetWorld()->GetSubsystem<UCoverPointSubsystem>())
+		CoverPoints->ReleaseCoverPoint(this);
 }
 
 // Called every frame
 void ABaseEnemy::Tick(float DeltaTime)
 {
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyTick, AI);
 	Super::Tick(DeltaTime);
 }
@@ -4,14 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "Spring2022_Capstone/GameplaySystems/DamageableActor.h"
 #include "BaseEnemy.generated.h"
 
 class UHealthComponent;
+class UNavigationInvokerComponent;
 UCLASS(Abstract)
-class SPRING2022_CAPSTONE_API ABaseEnemy : public ACharacter
+class SPRING2022_CAPSTONE_API ABaseEnemy : public ACharacter, public IDamageableActor
 {
 	GENERATED_BODY()
 
+	friend struct FGameplaySnapshot;
+	friend class UEnemyPoolSubsystem;
+
 public:
 	// Sets default values for this character's properties
 	ABaseEnemy();
@@ -19,25 +24,87 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(VisibleAnywhere, Category = "Components", meta = (AllowPrivateAccess = true))
 	UStaticMeshComponent *WeaponMesh;
 	UPROPERTY(VisibleAnywhere, Category = "Components", meta = (AllowPrivateAccess = true))
 	USceneComponent *ProjectileSpawnPoint;
+	// Generates navmesh around the enemy when the level's navmesh is built at runtime around invokers only.
+	UPROPERTY(VisibleAnywhere, Category = "Components", meta = (AllowPrivateAccess = true))
+	UNavigationInvokerComponent *NavigationInvoker;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UHealthComponent *HealthComponent;
 
+	/**
+	 * @brief Asks UEnemyAttackSchedulerSubsystem for an attack on the current attack target. The attack happens once
+	 * the enemy holds a token and its attack is due, so behavior trees calling this stay within the attack limits.
+	 */
 	UFUNCTION(BlueprintCallable)
-	virtual void Attack();
+	void Attack();
+
+	// The attack itself, run by AttackTarget() once the scheduler lets the enemy attack.
+	virtual void PerformAttack();
+
+	/**
+	 * @brief Returns the enemy to UEnemyPoolSubsystem when it came from there. Enemies placed in the level are hidden
+	 * and stopped where they fell instead, so a checkpoint or level start snapshot can bring them back.
+	 */
+	virtual void Die();
+
+	// Puts ammo, reloads and the like back to how the enemy spawned, when it spawns or comes out of the pool.
+	virtual void ResetAttackState() {}
+
+	// Target of the attack in progress, set by AttackTarget(). Player 0 when attacking without one.
+	AActor* GetCurrentAttackTarget() const;
 
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	virtual void DamageActor(AActor* DamagingActor, const float DamageAmount) override;
+
+	/**
+	 * @brief Attacks Target right away. Called by UEnemyAttackSchedulerSubsystem once the enemy holds a token and
+	 * its attack is due.
+	 */
+	void AttackTarget(AActor* Target);
+
+	// Seconds between attacks, from AttackSpeed in attacks per second.
+	float GetAttackInterval() const { return AttackSpeed > 0 ? 1.f / AttackSpeed : DEFAULT_ATTACK_INTERVAL; }
+
+	// False while the enemy can't attack, e.g. while reloading. Its attack token goes to another enemy then.
+	virtual bool CanAttackNow() const { return true; }
+
+	float GetDamage() const { return Damage; }
+
+	// World time of the last attack, enemies that attacked recently stay significant.
+	float GetLastAttackTime() const { return LastAttackTime; }
+
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "Stats", meta = (AllowPrivateAccess = true))
-	float Damage;
+	float Damage = 10.f;
+	// Attacks per second.
 	UPROPERTY(EditDefaultsOnly, Category = "Stats", meta = (AllowPrivateAccess = true))
-	float AttackSpeed;
+	float AttackSpeed = 1.f;
+
+	float LastAttackTime = TNumericLimits<float>::Lowest();
+	TWeakObjectPtr<AActor> CurrentAttackTarget;
+
+	// False while dead or waiting in the pool.
+	bool bIsActive = true;
+	// Spawned by UEnemyPoolSubsystem, which owns the enemy while it is inactive.
+	bool bIsPooled = false;
+
+	/**
+	 * @brief Wakes the enemy up with full health when it leaves the pool or a snapshot revives it, or hides it and
+	 * stops its movement, ticking and collision when it goes back in or dies. Its controller is left to the caller.
+	 */
+	void SetEnemyActive(bool bActive);
+
+/// Const Variables ///
+	const float DEFAULT_ATTACK_INTERVAL = 1.f;		// Seconds between attacks when AttackSpeed isn't set.
+	const float NAV_GENERATION_RADIUS = 3000.f;		// Navmesh is generated this far around the enemy with invokers.
+	const float NAV_REMOVAL_RADIUS = 5000.f;		// Tiles this far from every invoker are removed again.
 };
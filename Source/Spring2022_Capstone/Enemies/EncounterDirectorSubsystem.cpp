@@ -0,0 +1,159 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EncounterDirectorSubsystem.h"
+#include "Curves/CurveFloat.h"
+#include "EnemyAttackSchedulerSubsystem.h"
+#include "EnemySignificanceSubsystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "Spring2022_Capstone/Performance/CapstoneGameUserSettings.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+CSV_DECLARE_CATEGORY_EXTERN(Capstone);
+
+void UEncounterDirectorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LoadedIntensityCurve = IntensityCurve.LoadSynchronous();
+	NotifyEncounterStarted();
+	UpdateLimits();
+}
+
+void UEncounterDirectorSubsystem::Tick(float DeltaTime)
+{
+	CAPSTONE_SCOPE_COST(AI);
+
+	SampleFrameCost(DeltaTime);
+
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < UpdateInterval)
+	{
+		return;
+	}
+
+	// Back off quickly when the frame is close to the target, give the budget back slowly.
+	if (FrameLoad > EarlyWarningLoad)
+		BudgetScale = FMath::Max(MinBudgetScale, BudgetScale - ScaleDownRate * TimeSinceUpdate);
+	else if (FrameLoad < RestoreLoad)
+		BudgetScale = FMath::Min(1.f, BudgetScale + ScaleUpRate * TimeSinceUpdate);
+	bHoldSpawns = FrameLoad > EarlyWarningLoad;
+	LowestBudgetScale = FMath::Min(LowestBudgetScale, BudgetScale);
+	TimeSinceUpdate = 0;
+
+	UpdateLimits();
+
+	CSV_CUSTOM_STAT(Capstone, DirectorLoad, FrameLoad, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Capstone, DirectorBudgetScale, BudgetScale, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Capstone, DirectorMaxActiveEnemies, MaxActiveEnemies, ECsvCustomStatOp::Set);
+}
+
+TStatId UEncounterDirectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEncounterDirectorSubsystem, STATGROUP_Tickables);
+}
+
+bool UEncounterDirectorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEncounterDirectorSubsystem::NotifyEncounterStarted()
+{
+	EncounterStartTime = GetWorld()->GetTimeSeconds();
+}
+
+int32 UEncounterDirectorSubsystem::RequestSpawns(int32 Wanted)
+{
+	if (SpawnFrame != GFrameCounter)
+	{
+		SpawnFrame = GFrameCounter;
+		SpawnsThisFrame = 0;
+	}
+	if (bHoldSpawns)
+	{
+		return 0;
+	}
+
+	const int32 FreeSlots = FMath::Max(0, MaxActiveEnemies - GetActiveEnemyCount());
+	const int32 Granted = FMath::Clamp(Wanted, 0, FMath::Min(MaxSpawnsPerFrame - SpawnsThisFrame, FreeSlots));
+	SpawnsThisFrame += Granted;
+	return Granted;
+}
+
+int32 UEncounterDirectorSubsystem::GetAttackerCount() const
+{
+	const UEnemyAttackSchedulerSubsystem* AttackScheduler = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>();
+	return AttackScheduler ? AttackScheduler->GetTokenCount() : 0;
+}
+
+bool UEncounterDirectorSubsystem::RegisterEffect(UFXSystemComponent* Effect)
+{
+	if (!Effect)
+	{
+		return false;
+	}
+
+	Effects.RemoveAllSwap([](const TWeakObjectPtr<UFXSystemComponent>& Tracked) { return !Tracked.IsValid() || !Tracked->IsActive(); });
+	if (Effects.Num() >= MaxEffects)
+	{
+		return false;
+	}
+
+	Effects.Add(Effect);
+	return true;
+}
+
+int32 UEncounterDirectorSubsystem::GetActiveEnemyCount() const
+{
+	const UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>();
+	if (!Significance)
+	{
+		return 0;
+	}
+	return Significance->GetEnemyCount(EEnemySignificance::High) + Significance->GetEnemyCount(EEnemySignificance::Medium)
+		+ Significance->GetEnemyCount(EEnemySignificance::Low) + Significance->GetEnemyCount(EEnemySignificance::Dormant);
+}
+
+void UEncounterDirectorSubsystem::ResetFrameStats()
+{
+	SampledFrames = 0;
+	FramesOverTarget = 0;
+	LowestBudgetScale = BudgetScale;
+}
+
+void UEncounterDirectorSubsystem::SampleFrameCost(float DeltaTime)
+{
+	// The slowest thread sets the frame time. Without a renderer only the game thread is measured.
+	float FrameCostMs = FMath::Max3(FPlatformTime::ToMilliseconds(GGameThreadTime), FPlatformTime::ToMilliseconds(GRenderThreadTime), FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles()));
+	if (FrameCostMs <= 0)
+		FrameCostMs = DeltaTime * 1000.f;
+
+	const UCapstoneGameUserSettings* Settings = UCapstoneGameUserSettings::GetCapstoneGameUserSettings();
+	const float TargetFrameTimeMs = Settings ? Settings->GetTargetFrameTimeMs() : 1000.f / 60.f;
+
+	SmoothedFrameCostMs = FMath::Lerp(SmoothedFrameCostMs, FrameCostMs, SMOOTHING);
+	FrameLoad = SmoothedFrameCostMs / TargetFrameTimeMs;
+
+	SampledFrames++;
+	if (FrameCostMs > TargetFrameTimeMs)
+		FramesOverTarget++;
+}
+
+void UEncounterDirectorSubsystem::UpdateLimits()
+{
+	const float EncounterTime = GetWorld()->GetTimeSeconds() - EncounterStartTime;
+	Intensity = LoadedIntensityCurve ? FMath::Clamp(LoadedIntensityCurve->GetFloatValue(EncounterTime), 0.f, 1.f) : 1.f;
+
+	// At least one of each, an encounter never stalls completely.
+	const float Scale = Intensity * BudgetScale;
+	MaxActiveEnemies = FMath::Max(1, FMath::RoundToInt(DesignMaxActiveEnemies * Scale));
+	MaxAttackers = FMath::Max(1, FMath::RoundToInt(DesignMaxAttackers * Scale));
+	MaxEffects = FMath::Max(1, FMath::RoundToInt(DesignMaxEffects * Scale));
+
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+		Significance->SetBudgetScale(BudgetScale);
+}
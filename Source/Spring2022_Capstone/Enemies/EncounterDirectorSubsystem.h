@@ -0,0 +1,136 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EncounterDirectorSubsystem.generated.h"
+
+class UCurveFloat;
+class UFXSystemComponent;
+
+/**
+ * Decides how intense combat may get: how many enemies are active, how many attack at once and how many effects
+ * are alive.
+ *
+ * Each limit is its design maximum scaled by two factors. The design intensity comes from IntensityCurve over the
+ * seconds since the encounter started. The budget scale follows the measured frame cost. It drops as soon as the
+ * frame cost passes EarlyWarningLoad of the target frame time, before the frame rate actually falls, and recovers
+ * slowly once there is headroom again. While over EarlyWarningLoad, spawns are held back. The budget scale also
+ * shrinks the significance subsystem's High tier and distance, which moves distant enemies into cheaper tiers.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UEncounterDirectorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Restarts the intensity curve, called by AEnemyWaveSpawner when its encounter starts.
+	void NotifyEncounterStarted();
+
+	/**
+	 * @brief Asks to activate Wanted enemies this frame.
+	 * @return How many may be activated, 0 while spawns are held back or MaxActiveEnemies are already active.
+	 */
+	int32 RequestSpawns(int32 Wanted);
+
+	/**
+	 * @brief Tracks Effect until it finishes. Returns false and leaves the effect alone when at the limit, the caller
+	 * should skip or deactivate it then.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Encounter")
+	bool RegisterEffect(UFXSystemComponent* Effect);
+
+	// Current limits and state, for the overlay and the benchmark.
+	int32 GetMaxActiveEnemies() const { return MaxActiveEnemies; }
+	int32 GetMaxAttackers() const { return MaxAttackers; }
+	int32 GetMaxEffects() const { return MaxEffects; }
+	int32 GetActiveEnemyCount() const;
+	// Enemies holding an attack token, UEnemyAttackSchedulerSubsystem keeps them under MaxAttackers.
+	int32 GetAttackerCount() const;
+	int32 GetEffectCount() const { return Effects.Num(); }
+	float GetFrameLoad() const { return FrameLoad; }
+	float GetBudgetScale() const { return BudgetScale; }
+	float GetIntensity() const { return Intensity; }
+	bool AreSpawnsHeld() const { return bHoldSpawns; }
+
+	// Frames sampled and frames over the target frame time since the last ResetFrameStats(), for the benchmark.
+	int32 GetSampledFrames() const { return SampledFrames; }
+	int32 GetFramesOverTarget() const { return FramesOverTarget; }
+	float GetLowestBudgetScale() const { return LowestBudgetScale; }
+	void ResetFrameStats();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void SampleFrameCost(float DeltaTime);
+	void UpdateLimits();
+
+	// Design maximums at full intensity and budget.
+	UPROPERTY(Config)
+	int32 DesignMaxActiveEnemies = 30;
+	UPROPERTY(Config)
+	int32 DesignMaxAttackers = 6;
+	UPROPERTY(Config)
+	int32 DesignMaxEffects = 64;
+
+	// Enemies allowed in per frame across all spawners while spawning isn't held back.
+	UPROPERTY(Config)
+	int32 MaxSpawnsPerFrame = 4;
+
+	// Intensity from 0 to 1 over the seconds since the encounter started. Full intensity when unset.
+	UPROPERTY(Config)
+	TSoftObjectPtr<UCurveFloat> IntensityCurve;
+
+	// Frame cost as a fraction of the target frame time at which the director backs off, and below which it
+	// gives the budget back.
+	UPROPERTY(Config)
+	float EarlyWarningLoad = 0.9f;
+	UPROPERTY(Config)
+	float RestoreLoad = 0.75f;
+
+	// Budget scale change per second when backing off and when recovering.
+	UPROPERTY(Config)
+	float ScaleDownRate = 1.f;
+	UPROPERTY(Config)
+	float ScaleUpRate = 0.1f;
+
+	// The budget scale never goes below this, combat keeps going however slow the frame is.
+	UPROPERTY(Config)
+	float MinBudgetScale = 0.25f;
+
+	// Seconds between limit updates.
+	UPROPERTY(Config)
+	float UpdateInterval = 0.1f;
+
+	UPROPERTY()
+	UCurveFloat* LoadedIntensityCurve = nullptr;
+
+	TArray<TWeakObjectPtr<UFXSystemComponent>> Effects;
+
+	float SmoothedFrameCostMs = 0;
+	float FrameLoad = 0;
+	float BudgetScale = 1.f;
+	float Intensity = 1.f;
+	bool bHoldSpawns = false;
+	double EncounterStartTime = 0;
+	float TimeSinceUpdate = 0;
+
+	int32 MaxActiveEnemies = 0;
+	int32 MaxAttackers = 0;
+	int32 MaxEffects = 0;
+	uint64 SpawnFrame = 0;
+	int32 SpawnsThisFrame = 0;
+
+	int32 SampledFrames = 0;
+	int32 FramesOverTarget = 0;
+	float LowestBudgetScale = 1.f;
+
+/// Const Variables ///
+	const float SMOOTHING = 0.1f;			// Weight of the newest frame in the smoothed frame cost.
+};
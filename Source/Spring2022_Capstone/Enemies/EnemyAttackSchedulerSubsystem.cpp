@@ -0,0 +1,181 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyAttackSchedulerSubsystem.h"
+#include "BaseEnemy.h"
+#include "EncounterDirectorSubsystem.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+void UEnemyAttackSchedulerSubsystem::Tick(float DeltaTime)
+{
+	CAPSTONE_SCOPE_COST(AI);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	Attackers.RemoveAll([](const FAttacker& Attacker) { return !Attacker.Enemy.IsValid(); });
+
+	ReleaseTokens(Now);
+	GrantTokens();
+	RunAttacks(Now);
+}
+
+TStatId UEnemyAttackSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAttackSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemyAttackSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyAttackSchedulerSubsystem::RequestAttack(ABaseEnemy* Enemy, AActor* Target, FOnEnemyAttackFinished OnFinished)
+{
+	if (!Enemy || !Target)
+	{
+		OnFinished.ExecuteIfBound(false);
+		return;
+	}
+
+	FAttacker* Attacker = Attackers.FindByPredicate([Enemy](const FAttacker& Attacker) { return Attacker.Enemy.Get() == Enemy; });
+	if (!Attacker)
+	{
+		Attacker = &Attackers.AddDefaulted_GetRef();
+		Attacker->Enemy = Enemy;
+		// Keeps the cadence when the enemy dropped out of the scheduler between attacks.
+		Attacker->LastAttackTime = Enemy->GetLastAttackTime();
+	}
+
+	// A new target means queueing for its tokens again. Asking again while queued for the same target, as Blueprint
+	// trees calling Attack() every pass do, keeps the place in the queue.
+	const bool bNewTarget = Attacker->Target.Get() != Target;
+	if (bNewTarget)
+		Attacker->bHasToken = false;
+	if (bNewTarget || !Attacker->bPending)
+		Attacker->RequestTime = GetWorld()->GetTimeSeconds();
+	Attacker->Target = Target;
+	Attacker->OnFinished = MoveTemp(OnFinished);
+	Attacker->bPending = true;
+}
+
+void UEnemyAttackSchedulerSubsystem::CancelAttack(const ABaseEnemy* Enemy)
+{
+	Attackers.RemoveAll([Enemy](const FAttacker& Attacker) { return Attacker.Enemy.Get() == Enemy; });
+}
+
+int32 UEnemyAttackSchedulerSubsystem::GetTokenCount() const
+{
+	int32 Count = 0;
+	for (const FAttacker& Attacker : Attackers)
+	{
+		if (Attacker.bHasToken)
+			Count++;
+	}
+	return Count;
+}
+
+void UEnemyAttackSchedulerSubsystem::ReleaseTokens(double Now)
+{
+	for (int32 Index = Attackers.Num() - 1; Index >= 0; Index--)
+	{
+		FAttacker& Attacker = Attackers[Index];
+		const bool bIdle = !Attacker.bPending && Now - Attacker.LastAttackTime > TokenHoldTime;
+		if (Attacker.bHasToken && (bIdle || !Attacker.Target.IsValid() || !Attacker.Enemy->CanAttackNow()))
+			Attacker.bHasToken = false;
+
+		if (Attacker.bPending && !Attacker.bHasToken && Now - Attacker.RequestTime > MaxWaitTime)
+		{
+			const FOnEnemyAttackFinished OnFinished = MoveTemp(Attacker.OnFinished);
+			Attacker.bPending = false;
+			OnFinished.ExecuteIfBound(false);
+		}
+		else if (bIdle && !Attacker.bHasToken)
+			Attackers.RemoveAtSwap(Index, 1, false);
+	}
+
+	// The director's attacker limit can drop below the tokens already out, the holders that attacked last give
+	// theirs back first.
+	const UEncounterDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEncounterDirectorSubsystem>();
+	const int32 ExcessTokens = Director ? GetTokenCount() - Director->GetMaxAttackers() : 0;
+	if (ExcessTokens <= 0)
+	{
+		return;
+	}
+
+	TArray<FAttacker*, TInlineAllocator<32>> Holders;
+	for (FAttacker& Attacker : Attackers)
+	{
+		if (Attacker.bHasToken)
+			Holders.Add(&Attacker);
+	}
+	Holders.Sort([](const FAttacker& A, const FAttacker& B) { return A.LastAttackTime > B.LastAttackTime; });
+	for (int32 Index = 0; Index < ExcessTokens; Index++)
+		Holders[Index]->bHasToken = false;
+}
+
+void UEnemyAttackSchedulerSubsystem::GrantTokens()
+{
+	// The director caps attackers across all targets when frames get slow.
+	const UEncounterDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEncounterDirectorSubsystem>();
+	int32 FreeTokens = Director ? Director->GetMaxAttackers() - GetTokenCount() : TNumericLimits<int32>::Max();
+
+	TMap<const AActor*, int32> TokensPerTarget;
+	TArray<FAttacker*, TInlineAllocator<32>> Waiting;
+	for (FAttacker& Attacker : Attackers)
+	{
+		if (Attacker.bHasToken)
+			TokensPerTarget.FindOrAdd(Attacker.Target.Get())++;
+		else if (Attacker.bPending && Attacker.Target.IsValid() && Attacker.Enemy->CanAttackNow())
+			Waiting.Add(&Attacker);
+	}
+
+	// Longest waiting first.
+	Waiting.Sort([](const FAttacker& A, const FAttacker& B) { return A.RequestTime < B.RequestTime; });
+	for (FAttacker* Attacker : Waiting)
+	{
+		int32& TargetTokens = TokensPerTarget.FindOrAdd(Attacker->Target.Get());
+		if (FreeTokens <= 0)
+			break;
+		if (TargetTokens >= MaxTokensPerTarget)
+			continue;
+
+		Attacker->bHasToken = true;
+		TargetTokens++;
+		FreeTokens--;
+	}
+}
+
+void UEnemyAttackSchedulerSubsystem::RunAttacks(double Now)
+{
+	TArray<FAttacker*, TInlineAllocator<32>> Due;
+	for (FAttacker& Attacker : Attackers)
+	{
+		if (Attacker.bPending && Attacker.bHasToken && Now - Attacker.LastAttackTime >= Attacker.Enemy->GetAttackInterval())
+			Due.Add(&Attacker);
+	}
+
+	// Most overdue first, whatever doesn't fit this frame goes next frame.
+	Due.Sort([](const FAttacker& A, const FAttacker& B) { return A.LastAttackTime < B.LastAttackTime; });
+	LastFrameAttackCount = FMath::Min(Due.Num(), MaxAttacksPerFrame);
+
+	// Attacks can reach back into the scheduler, e.g. a kill cancelling the victim's attack, which removes from
+	// Attackers. Everything the attacks need is copied out before the first one runs.
+	TArray<FDueAttack, TInlineAllocator<8>> Attacks;
+	for (int32 Index = 0; Index < LastFrameAttackCount; Index++)
+	{
+		FAttacker* Attacker = Due[Index];
+		Attacker->LastAttackTime = Now;
+		Attacker->bPending = false;
+		Attacks.Add({ Attacker->Enemy, Attacker->Target, MoveTemp(Attacker->OnFinished) });
+	}
+
+	for (const FDueAttack& Attack : Attacks)
+	{
+		ABaseEnemy* Enemy = Attack.Enemy.Get();
+		AActor* Target = Attack.Target.Get();
+		if (Enemy && Target)
+			Enemy->AttackTarget(Target);
+	}
+
+	for (const FDueAttack& Attack : Attacks)
+		Attack.OnFinished.ExecuteIfBound(true);
+}
@@ -0,0 +1,87 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyAttackSchedulerSubsystem.generated.h"
+
+class ABaseEnemy;
+
+DECLARE_DELEGATE_OneParam(FOnEnemyAttackFinished, bool /* bAttacked */);
+
+/**
+ * Decides which enemies attack and when, so the number of enemies tracing and firing in a frame stays bounded.
+ *
+ * An enemy asks for an attack on a target with RequestAttack(). Each target hands out MaxTokensPerTarget attack
+ * tokens, further capped in total by the encounter director's attacker limit, and they go to the enemies that
+ * waited longest. A token counts against the director's limit from the moment it is granted, and when the limit
+ * drops the holders that attacked last hand theirs back. Token holders attack at their own cadence, one attack per
+ * GetAttackInterval(). Due attacks run in order, at most MaxAttacksPerFrame a frame, and the rest wait for the next
+ * frame. Tokens go back when an enemy starts reloading or stops asking, so another enemy can take over.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UEnemyAttackSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Queues one attack by Enemy on Target. OnFinished is called with true once the attack happened, or with
+	 * false when Enemy got no turn within MaxWaitTime.
+	 */
+	void RequestAttack(ABaseEnemy* Enemy, AActor* Target, FOnEnemyAttackFinished OnFinished);
+
+	// Drops Enemy's queued attack without calling back, and gives its token back.
+	void CancelAttack(const ABaseEnemy* Enemy);
+
+	// Tokens handed out and attacks run last frame, for the overlay.
+	int32 GetTokenCount() const;
+	int32 GetLastFrameAttackCount() const { return LastFrameAttackCount; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FAttacker
+	{
+		TWeakObjectPtr<ABaseEnemy> Enemy;
+		TWeakObjectPtr<AActor> Target;
+		FOnEnemyAttackFinished OnFinished;
+		double RequestTime = 0;
+		double LastAttackTime = TNumericLimits<float>::Lowest();
+		bool bPending = false;
+		bool bHasToken = false;
+	};
+
+	struct FDueAttack
+	{
+		TWeakObjectPtr<ABaseEnemy> Enemy;
+		TWeakObjectPtr<AActor> Target;
+		FOnEnemyAttackFinished OnFinished;
+	};
+
+	void ReleaseTokens(double Now);
+	void GrantTokens();
+	void RunAttacks(double Now);
+
+	// Tokens per target and attacks started per frame across all enemies.
+	UPROPERTY(Config)
+	int32 MaxTokensPerTarget = 3;
+	UPROPERTY(Config)
+	int32 MaxAttacksPerFrame = 2;
+
+	// Seconds a request waits for a token before it fails.
+	UPROPERTY(Config)
+	float MaxWaitTime = 2.f;
+
+	// Seconds a token is kept after an attack without a new request, covers the gap between attacks in the tree.
+	UPROPERTY(Config)
+	float TokenHoldTime = 1.f;
+
+	TArray<FAttacker> Attackers;
+	int32 LastFrameAttackCount = 0;
+};
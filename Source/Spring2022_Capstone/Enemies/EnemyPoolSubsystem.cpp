@@ -0,0 +1,156 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyPoolSubsystem.h"
+#include "AIController.h"
+#include "BaseEnemy.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BrainComponent.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+bool UEnemyPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyPoolSubsystem::Prewarm(TSubclassOf<ABaseEnemy> EnemyClass, int32 Count)
+{
+	if (!EnemyClass)
+	{
+		return;
+	}
+
+	CAPSTONE_LLM_SCOPE(Capstone_AI);
+	TArray<FPooledEnemy>& FreeEnemies = Free.FindOrAdd(EnemyClass.Get());
+	FreeEnemies.RemoveAll([](const FPooledEnemy& Pooled) { return !Pooled.Enemy.IsValid(); });
+	while (FreeEnemies.Num() < Count)
+	{
+		const FPooledEnemy Pooled = SpawnPooled(EnemyClass);
+		if (!Pooled.Enemy.IsValid())
+			return;
+
+		Deactivate(Pooled);
+		FreeEnemies.Add(Pooled);
+	}
+}
+
+ABaseEnemy* UEnemyPoolSubsystem::Acquire(TSubclassOf<ABaseEnemy> EnemyClass, const FTransform& Transform)
+{
+	if (!EnemyClass)
+	{
+		return nullptr;
+	}
+
+	FPooledEnemy Pooled;
+	if (TArray<FPooledEnemy>* FreeEnemies = Free.Find(EnemyClass.Get()))
+	{
+		while (!Pooled.Enemy.IsValid() && FreeEnemies->Num() > 0)
+			Pooled = FreeEnemies->Pop(false);
+	}
+	if (!Pooled.Enemy.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Enemy pool for %s is empty, spawning one mid game"), *EnemyClass->GetName());
+		Pooled = SpawnPooled(EnemyClass);
+		if (!Pooled.Enemy.IsValid())
+		{
+			return nullptr;
+		}
+	}
+
+	ABaseEnemy* Enemy = Pooled.Enemy.Get();
+	Enemy->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+	Enemy->SetEnemyActive(true);
+
+	// Possessing again runs the controller's On Possess, which starts the tree and seeds the blackboard. Anything the
+	// previous life left in the blackboard is cleared first.
+	if (AAIController* Controller = Pooled.Controller.Get())
+	{
+		if (UBlackboardComponent* Blackboard = Controller->GetBlackboardComponent())
+		{
+			for (FBlackboard::FKey KeyID = 0; KeyID < Blackboard->GetNumKeys(); KeyID++)
+				Blackboard->ClearValue(KeyID);
+		}
+		if (Controller->GetPawn() != Enemy)
+			Controller->Possess(Enemy);
+	}
+	else
+	{
+		Enemy->SpawnDefaultController();
+		Pooled.Controller = Cast<AAIController>(Enemy->GetController());
+	}
+
+	Active.Add(Enemy, Pooled);
+	return Enemy;
+}
+
+bool UEnemyPoolSubsystem::Release(ABaseEnemy* Enemy)
+{
+	FPooledEnemy Pooled;
+	if (!Enemy || !Active.RemoveAndCopyValue(Enemy, Pooled))
+	{
+		return false;
+	}
+
+	Deactivate(Pooled);
+	Free.FindOrAdd(Enemy->GetClass()).Add(Pooled);
+	OnEnemyReleased.Broadcast(Enemy);
+	return true;
+}
+
+void UEnemyPoolSubsystem::GetActiveEnemies(TArray<ABaseEnemy*>& OutEnemies) const
+{
+	OutEnemies.Reset(Active.Num());
+	for (const TPair<FObjectKey, FPooledEnemy>& Pair : Active)
+	{
+		if (ABaseEnemy* Enemy = Pair.Value.Enemy.Get())
+			OutEnemies.Add(Enemy);
+	}
+}
+
+int32 UEnemyPoolSubsystem::GetFreeCount() const
+{
+	int32 Count = 0;
+	for (const TPair<FObjectKey, TArray<FPooledEnemy>>& Pair : Free)
+		Count += Pair.Value.Num();
+	return Count;
+}
+
+UEnemyPoolSubsystem::FPooledEnemy UEnemyPoolSubsystem::SpawnPooled(TSubclassOf<ABaseEnemy> EnemyClass)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	FPooledEnemy Pooled;
+	Pooled.Enemy = GetWorld()->SpawnActor<ABaseEnemy>(EnemyClass, StorageLocation, FRotator::ZeroRotator, SpawnParams);
+	if (!Pooled.Enemy.IsValid())
+	{
+		return Pooled;
+	}
+	Pooled.Enemy->bIsPooled = true;
+
+	// Characters only get a controller by themselves when placed in the level, unless their class says otherwise.
+	if (!Pooled.Enemy->GetController())
+		Pooled.Enemy->SpawnDefaultController();
+	Pooled.Controller = Cast<AAIController>(Pooled.Enemy->GetController());
+	return Pooled;
+}
+
+void UEnemyPoolSubsystem::Deactivate(const FPooledEnemy& Pooled) const
+{
+	// The controller stays alive, unpossessing stops its behavior tree and path following.
+	if (AAIController* Controller = Pooled.Controller.Get())
+	{
+		// A dormant enemy's tree is paused, it has to come back running.
+		if (UBrainComponent* BrainComponent = Controller->GetBrainComponent())
+		{
+			BrainComponent->ResumeLogic(TEXT("Dormant"));
+			BrainComponent->StopLogic(TEXT("Pooled"));
+		}
+		Controller->ClearFocus(EAIFocusPriority::Gameplay);
+		Controller->UnPossess();
+	}
+
+	ABaseEnemy* Enemy = Pooled.Enemy.Get();
+	Enemy->SetEnemyActive(false);
+	Enemy->SetActorLocation(StorageLocation, false, nullptr, ETeleportType::TeleportPhysics);
+}
@@ -0,0 +1,78 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "EnemyPoolSubsystem.generated.h"
+
+class AAIController;
+class ABaseEnemy;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnemyReleased, ABaseEnemy* /* Enemy */);
+
+/**
+ * Keeps dead enemies and their AI controllers around to bring them back, so spawning a wave never builds a
+ * character, controller, behavior tree or mesh mid fight.
+ *
+ * Prewarm() spawns enemies up front, usually from an AEnemyWaveSpawner's BeginPlay while the level loads, and parks
+ * them hidden with their controller unpossessed. Acquire() moves one into place, restores its health and possesses
+ * it again with a cleared blackboard, which runs the controller's On Possess and restarts the behavior tree. Enemies
+ * that die go back through Release() instead of being destroyed.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Spawns enemies of EnemyClass until at least Count of them wait in the pool.
+	 */
+	void Prewarm(TSubclassOf<ABaseEnemy> EnemyClass, int32 Count);
+
+	/**
+	 * @brief Takes an enemy of EnemyClass out of the pool and activates it at Transform. Spawns one when the pool is
+	 * empty, which is the hitch the pool is there to avoid, so it is logged.
+	 */
+	ABaseEnemy* Acquire(TSubclassOf<ABaseEnemy> EnemyClass, const FTransform& Transform);
+
+	/**
+	 * @brief Deactivates Enemy and puts it back in the pool.
+	 * @return False if Enemy didn't come from the pool, the caller destroys it then.
+	 */
+	bool Release(ABaseEnemy* Enemy);
+
+	/**
+	 * @brief Collects the enemies currently out of the pool.
+	 */
+	void GetActiveEnemies(TArray<ABaseEnemy*>& OutEnemies) const;
+
+	// Enemies waiting in the pool and enemies out of it, for the overlay.
+	int32 GetFreeCount() const;
+	int32 GetActiveCount() const { return Active.Num(); }
+
+	// Broadcast when an enemy goes back into the pool, i.e. when a pooled enemy dies.
+	FOnEnemyReleased OnEnemyReleased;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPooledEnemy
+	{
+		TWeakObjectPtr<ABaseEnemy> Enemy;
+		TWeakObjectPtr<AAIController> Controller;
+	};
+
+	FPooledEnemy SpawnPooled(TSubclassOf<ABaseEnemy> EnemyClass);
+	void Deactivate(const FPooledEnemy& Pooled) const;
+
+	// Where pooled enemies are spawned and wait, out of sight and out of everyone's way.
+	UPROPERTY(Config)
+	FVector StorageLocation = FVector(0.f, 0.f, -50000.f);
+
+	TMap<FObjectKey, TArray<FPooledEnemy>> Free;
+	TMap<FObjectKey, FPooledEnemy> Active;
+};
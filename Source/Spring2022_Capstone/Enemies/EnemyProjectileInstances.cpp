@@ -0,0 +1,17 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyProjectileInstances.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+// Sets default values
+AEnemyProjectileInstances::AEnemyProjectileInstances()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Instances = CreateDefaultSubobject<UInstancedStaticMeshComponent>("EnemyProjectiles");
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetCastShadow(false);
+	RootComponent = Instances;
+}
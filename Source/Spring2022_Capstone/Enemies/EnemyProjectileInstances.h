@@ -0,0 +1,29 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "EnemyProjectileInstances.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ * Owns the one instanced static mesh component UEnemyProjectileSubsystem draws every enemy projectile with.
+ * Spawned once per world when play begins, so it can be listed as a churn free class in the benchmark.
+ */
+UCLASS(NotPlaceable, Transient)
+class SPRING2022_CAPSTONE_API AEnemyProjectileInstances : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	AEnemyProjectileInstances();
+
+	UInstancedStaticMeshComponent* GetInstances() const { return Instances; }
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "Components")
+	UInstancedStaticMeshComponent* Instances;
+};
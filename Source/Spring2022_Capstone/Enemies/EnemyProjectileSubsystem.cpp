@@ -0,0 +1,298 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyProjectileSubsystem.h"
+#include "BaseEnemy.h"
+#include "EnemyProjectileInstances.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Spring2022_Capstone/GameplaySystems/DamageableActor.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+CSV_DECLARE_CATEGORY_EXTERN(Capstone);
+
+namespace
+{
+	const float STRESS_DISTANCE = 3000.f;		// Distance from the player Capstone.Projectiles.Stress fires from.
+	const float STRESS_SPEED = 1500.f;			// Speed of the stress test projectiles.
+
+	FAutoConsoleCommandWithWorldAndArgs StressCommand(
+		TEXT("Capstone.Projectiles.Stress"),
+		TEXT("Capstone.Projectiles.Stress <Count>: fires Count harmless enemy projectiles at the player from all around."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UEnemyProjectileSubsystem* Projectiles = World ? World->GetSubsystem<UEnemyProjectileSubsystem>() : nullptr;
+			const APawn* Player = UGameplayStatics::GetPlayerPawn(World, 0);
+			if (!Projectiles || !Player)
+			{
+				return;
+			}
+
+			const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				const FVector Direction = FMath::VRand();
+				Projectiles->FireProjectile(nullptr, Player->GetActorLocation() + Direction * STRESS_DISTANCE, -Direction * STRESS_SPEED, 0.f);
+			}
+		}));
+
+	FCollisionObjectQueryParams GetSweepObjectTypes()
+	{
+		// Object types rather than a trace channel, so pawn capsules block whatever their channel responses are.
+		FCollisionObjectQueryParams ObjectTypes;
+		ObjectTypes.AddObjectTypesToQuery(ECC_WorldStatic);
+		ObjectTypes.AddObjectTypesToQuery(ECC_WorldDynamic);
+		ObjectTypes.AddObjectTypesToQuery(ECC_Pawn);
+		return ObjectTypes;
+	}
+}
+
+void UEnemyProjectileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Loaded in the background while the level loads, instead of blocking begin play.
+	if (ProjectileMesh.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No enemy projectile mesh set, projectiles won't be drawn"));
+		return;
+	}
+	ProjectileMeshHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ProjectileMesh.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &UEnemyProjectileSubsystem::OnProjectileMeshLoaded));
+}
+
+void UEnemyProjectileSubsystem::Deinitialize()
+{
+	if (ProjectileMeshHandle.IsValid())
+	{
+		ProjectileMeshHandle->CancelHandle();
+		ProjectileMeshHandle.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UEnemyProjectileSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// A transient actor at the origin owns the one component drawing every projectile.
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	AEnemyProjectileInstances* InstancesActor = InWorld.SpawnActor<AEnemyProjectileInstances>(SpawnParams);
+	if (!InstancesActor)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Enemy projectile instances could not be spawned, projectiles won't be drawn"));
+		return;
+	}
+	Instances = InstancesActor->GetInstances();
+
+	// The mesh is usually in by now, otherwise OnProjectileMeshLoaded() sets it.
+	if (UStaticMesh* Mesh = ProjectileMesh.Get())
+		Instances->SetStaticMesh(Mesh);
+}
+
+void UEnemyProjectileSubsystem::OnProjectileMeshLoaded()
+{
+	UStaticMesh* Mesh = ProjectileMesh.Get();
+	if (!Mesh)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Enemy projectile mesh %s not found, projectiles won't be drawn"), *ProjectileMesh.ToString());
+		return;
+	}
+
+	if (Instances)
+		Instances->SetStaticMesh(Mesh);
+}
+
+void UEnemyProjectileSubsystem::Tick(float DeltaTime)
+{
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyProjectiles, AI);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	CollectSweeps();
+	Integrate(DeltaTime);
+	RemoveFinished();
+	IssueSweeps();
+	UpdateInstances();
+
+	LastUpdateMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	CSV_CUSTOM_STAT(Capstone, EnemyProjectiles, Positions.Num(), ECsvCustomStatOp::Set);
+}
+
+TStatId UEnemyProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyProjectileSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemyProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UEnemyProjectileSubsystem::FireProjectile(AActor* Instigator, const FVector& Location, const FVector& Velocity, float Damage)
+{
+	if (Positions.Num() >= MaxProjectiles)
+	{
+		return false;
+	}
+
+	Positions.Add(Location);
+	Velocities.Add(Velocity);
+	SweepStarts.Add(Location);
+	Ages.Add(0.f);
+	Damages.Add(Damage);
+	Instigators.Add(Instigator);
+	SweepHandles.AddDefaulted();
+	return true;
+}
+
+void UEnemyProjectileSubsystem::ClearProjectiles()
+{
+	// Sweeps still in flight are dropped with their handles, their results are never read.
+	Positions.Reset();
+	Velocities.Reset();
+	SweepStarts.Reset();
+	Ages.Reset();
+	Damages.Reset();
+	Instigators.Reset();
+	SweepHandles.Reset();
+	NextSweepIndex = 0;
+
+	if (Instances)
+		Instances->ClearInstances();
+}
+
+void UEnemyProjectileSubsystem::CollectSweeps()
+{
+	UWorld* World = GetWorld();
+	for (int32 Index = 0; Index < SweepHandles.Num(); Index++)
+	{
+		FTraceHandle& Handle = SweepHandles[Index];
+		if (!Handle.IsValid())
+			continue;
+
+		// Async results only live for a frame or two, a path missed over a pause isn't swept again.
+		FTraceDatum Datum;
+		if (!World->QueryTraceData(Handle, Datum))
+		{
+			if (!World->IsTraceHandleValid(Handle, false))
+				Handle.Invalidate();
+			continue;
+		}
+		Handle.Invalidate();
+
+		const FHitResult* Hit = Datum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+		if (!Hit)
+			continue;
+
+		// Enemies don't hurt each other, their projectiles just stop. Harmless ones, like the stress test's, never
+		// reach the damage code, which treats any hit as a real one.
+		AActor* HitActor = Hit->GetActor();
+		IDamageableActor* Damageable = Cast<IDamageableActor>(HitActor);
+		if (Damageable && Damages[Index] > 0 && !HitActor->IsA<ABaseEnemy>())
+			Damageable->DamageActor(Instigators[Index].Get(), Damages[Index]);
+		Ages[Index] = Lifetime;
+	}
+}
+
+void UEnemyProjectileSubsystem::Integrate(float DeltaTime)
+{
+	// One flat pass over contiguous arrays that can't alias, which the compiler vectorizes.
+	const FVector GravityStep(0, 0, GetWorld()->GetGravityZ() * GravityScale * DeltaTime);
+	FVector* RESTRICT Position = Positions.GetData();
+	FVector* RESTRICT Velocity = Velocities.GetData();
+	float* RESTRICT Age = Ages.GetData();
+
+	const int32 Count = Positions.Num();
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		Velocity[Index] += GravityStep;
+		Position[Index] += Velocity[Index] * DeltaTime;
+		Age[Index] += DeltaTime;
+	}
+}
+
+void UEnemyProjectileSubsystem::RemoveFinished()
+{
+	// Hits are marked by setting their age to the lifetime.
+	for (int32 Index = Ages.Num() - 1; Index >= 0; Index--)
+	{
+		if (Ages[Index] >= Lifetime)
+			RemoveProjectile(Index);
+	}
+}
+
+void UEnemyProjectileSubsystem::IssueSweeps()
+{
+	UWorld* World = GetWorld();
+	static const FCollisionObjectQueryParams ObjectTypes = GetSweepObjectTypes();
+
+	// Round robin from where the last frame stopped, so over budget every projectile still gets its turn.
+	const int32 Count = Positions.Num();
+	if (NextSweepIndex >= Count)
+		NextSweepIndex = 0;
+
+	LastFrameSweepCount = 0;
+	int32 Checked = 0;
+	for (; Checked < Count && LastFrameSweepCount < MaxSweepsPerFrame; Checked++)
+	{
+		const int32 Index = (NextSweepIndex + Checked) % Count;
+		if (SweepHandles[Index].IsValid())
+			continue;
+
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(EnemyProjectile), false, Instigators[Index].Get());
+		SweepHandles[Index] = World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, SweepStarts[Index], Positions[Index], ObjectTypes, Params);
+		SweepStarts[Index] = Positions[Index];
+		LastFrameSweepCount++;
+	}
+	NextSweepIndex = Count > 0 ? (NextSweepIndex + Checked) % Count : 0;
+
+	INC_DWORD_STAT_BY(STAT_CapstoneSceneQueries, LastFrameSweepCount);
+	FCapstoneFrameCounters::AddSceneQueries(LastFrameSweepCount);
+}
+
+void UEnemyProjectileSubsystem::UpdateInstances()
+{
+	if (!Instances)
+	{
+		return;
+	}
+
+	const int32 Count = Positions.Num();
+	InstanceTransforms.SetNum(Count, false);
+	for (int32 Index = 0; Index < Count; Index++)
+		InstanceTransforms[Index] = FTransform(Velocities[Index].ToOrientationQuat(), Positions[Index], ProjectileScale);
+
+	// Instances are only added or removed at the end, which never shuffles the others.
+	const int32 InstanceCount = Instances->GetInstanceCount();
+	if (InstanceCount < Count)
+	{
+		Instances->AddInstances(TArray<FTransform>(InstanceTransforms.GetData() + InstanceCount, Count - InstanceCount), false, true);
+	}
+	else if (InstanceCount > Count)
+	{
+		TArray<int32> Removed;
+		for (int32 Index = InstanceCount - 1; Index >= Count; Index--)
+			Removed.Add(Index);
+		Instances->RemoveInstances(Removed);
+	}
+
+	if (Count > 0)
+		Instances->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+}
+
+void UEnemyProjectileSubsystem::RemoveProjectile(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	SweepStarts.RemoveAtSwap(Index, 1, false);
+	Ages.RemoveAtSwap(Index, 1, false);
+	Damages.RemoveAtSwap(Index, 1, false);
+	Instigators.RemoveAtSwap(Index, 1, false);
+	SweepHandles.RemoveAtSwap(Index, 1, false);
+}
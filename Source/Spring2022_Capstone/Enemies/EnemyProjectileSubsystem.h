@@ -0,0 +1,105 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "EnemyProjectileSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+struct FStreamableHandle;
+
+/**
+ * Simulates every enemy projectile in flight without an actor or component per projectile.
+ *
+ * Projectiles live in parallel arrays, one per field, and each frame they are integrated in a single pass over
+ * those arrays. Collision is swept asynchronously: a projectile's path since its last sweep is traced against
+ * world geometry and pawns, at most MaxSweepsPerFrame of them per frame, and the result is read the next frame.
+ * Hits deal damage through IDamageableActor, other enemies just stop the projectile. All projectiles are drawn by
+ * one instanced static mesh component, so thousands in flight cost one draw call.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UEnemyProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Fires a projectile from Location. A hit deals Damage, with Instigator as the damaging actor.
+	 * @return False when MaxProjectiles are already in flight and nothing was fired.
+	 */
+	bool FireProjectile(AActor* Instigator, const FVector& Location, const FVector& Velocity, float Damage);
+
+	/**
+	 * @brief Removes every projectile in flight without it hitting anything, e.g. when a snapshot is restored.
+	 */
+	void ClearProjectiles();
+
+	// Projectiles in flight, sweeps started last frame and game thread time of the last update, for the overlay.
+	int32 GetProjectileCount() const { return Positions.Num(); }
+	int32 GetLastFrameSweepCount() const { return LastFrameSweepCount; }
+	float GetLastUpdateMs() const { return LastUpdateMs; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void CollectSweeps();
+	void Integrate(float DeltaTime);
+	void RemoveFinished();
+	void IssueSweeps();
+	void UpdateInstances();
+	void RemoveProjectile(int32 Index);
+	void OnProjectileMeshLoaded();
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<UStaticMesh> ProjectileMesh;
+	UPROPERTY(Config)
+	FVector ProjectileScale = FVector(0.1f);
+
+	// Projectiles fired past this many are dropped.
+	UPROPERTY(Config)
+	int32 MaxProjectiles = 4096;
+
+	// Seconds a projectile flies before it is removed.
+	UPROPERTY(Config)
+	float Lifetime = 5.f;
+
+	// Multiplier on the world's gravity, 0 flies straight.
+	UPROPERTY(Config)
+	float GravityScale = 0.f;
+
+	// Sweeps started per frame. Projectiles that miss a frame sweep their whole path since the last one next time.
+	UPROPERTY(Config)
+	int32 MaxSweepsPerFrame = 1024;
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Instances;
+
+	// Keeps the mesh loading from Initialize() and loaded afterwards.
+	TSharedPtr<FStreamableHandle> ProjectileMeshHandle;
+
+	// One entry per projectile in each array, the same index in all of them.
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<FVector> SweepStarts;
+	TArray<float> Ages;
+	TArray<float> Damages;
+	TArray<TWeakObjectPtr<AActor>> Instigators;
+	TArray<FTraceHandle> SweepHandles;
+
+	// Reused every frame for the instance update.
+	TArray<FTransform> InstanceTransforms;
+
+	int32 NextSweepIndex = 0;
+	int32 LastFrameSweepCount = 0;
+	float LastUpdateMs = 0;
+};
@@ -0,0 +1,235 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemySignificanceSubsystem.h"
+#include "AIController.h"
+#include "BaseEnemy.h"
+#include "BrainComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarAILOD(
+		TEXT("Capstone.AILOD"),
+		true,
+		TEXT("Scales enemy, AI controller and animation update rates by significance. 0 updates every enemy every frame."),
+		ECVF_Default);
+
+	// Screen sizes below which update rate optimizations skip a further animation frame, before the tier's scale.
+	const float ANIM_SKIP_SCREEN_SIZES[] = { 0.4f, 0.2f, 0.1f };
+}
+
+void UEnemySignificanceSubsystem::Tick(float DeltaTime)
+{
+	CAPSTONE_SCOPE_COST(AI);
+
+	const bool bEnabled = CVarAILOD.GetValueOnGameThread();
+	if (bEnabled != bLODEnabled)
+	{
+		// Force every enemy to be re-applied when LOD is toggled.
+		bLODEnabled = bEnabled;
+		TimeSinceUpdate = UpdateInterval;
+		for (FEnemyEntry& Entry : Enemies)
+		{
+			if (ABaseEnemy* Enemy = Entry.Enemy.Get())
+				ApplySignificance(Enemy, EEnemySignificance::High);
+			Entry.Significance = EEnemySignificance::High;
+		}
+	}
+
+	TimeSinceUpdate += DeltaTime;
+	if (!bLODEnabled || TimeSinceUpdate < UpdateInterval)
+	{
+		return;
+	}
+	TimeSinceUpdate = 0;
+
+	UpdateSignificance();
+}
+
+TStatId UEnemySignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemySignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemySignificanceSubsystem::RegisterEnemy(ABaseEnemy* Enemy)
+{
+	// Pooled enemies come back with the tick rates of the tier they left in.
+	Enemies.Add({ Enemy, EEnemySignificance::High, 0 });
+	ApplySignificance(Enemy, EEnemySignificance::High);
+}
+
+void UEnemySignificanceSubsystem::UnregisterEnemy(ABaseEnemy* Enemy)
+{
+	Enemies.RemoveAllSwap([Enemy](const FEnemyEntry& Entry) { return Entry.Enemy.Get() == Enemy; });
+}
+
+EEnemySignificance UEnemySignificanceSubsystem::GetSignificance(const ABaseEnemy* Enemy) const
+{
+	const FEnemyEntry* Entry = Enemies.FindByPredicate([Enemy](const FEnemyEntry& Entry) { return Entry.Enemy.Get() == Enemy; });
+	return Entry ? Entry->Significance : EEnemySignificance::High;
+}
+
+int32 UEnemySignificanceSubsystem::GetEnemyCount(EEnemySignificance Significance) const
+{
+	int32 Count = 0;
+	for (const FEnemyEntry& Entry : Enemies)
+	{
+		if (Entry.Significance == Significance)
+			Count++;
+	}
+	return Count;
+}
+
+void UEnemySignificanceSubsystem::UpdateSignificance()
+{
+	const APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0);
+	if (!CameraManager)
+	{
+		return;
+	}
+
+	const FVector ViewLocation = CameraManager->GetCameraLocation();
+	const FVector ViewDirection = CameraManager->GetCameraRotation().Vector();
+	const float CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(CameraManager->GetFOVAngle() * 0.5f));
+
+	Enemies.RemoveAllSwap([](const FEnemyEntry& Entry) { return !Entry.Enemy.IsValid(); });
+	for (FEnemyEntry& Entry : Enemies)
+		Entry.Score = ScoreEnemy(Entry.Enemy.Get(), ViewLocation, ViewDirection, CosHalfFOV);
+
+	// Highest scores first so the High budget goes to the enemies that matter most.
+	Enemies.Sort([](const FEnemyEntry& A, const FEnemyEntry& B) { return A.Score > B.Score; });
+
+	const int32 HighBudget = FMath::Max(1, FMath::RoundToInt(MaxHighEnemies * BudgetScale));
+	int32 HighCount = 0;
+	for (FEnemyEntry& Entry : Enemies)
+	{
+		EEnemySignificance Significance = EEnemySignificance::Dormant;
+		if (Entry.Score >= HighScore && HighCount < HighBudget)
+		{
+			Significance = EEnemySignificance::High;
+			HighCount++;
+		}
+		// Enemies over the High budget end up here too.
+		else if (Entry.Score >= MediumScore)
+			Significance = EEnemySignificance::Medium;
+		else if (Entry.Score >= LowScore)
+			Significance = EEnemySignificance::Low;
+
+		if (Significance != Entry.Significance)
+		{
+			Entry.Significance = Significance;
+			ApplySignificance(Entry.Enemy.Get(), Significance);
+		}
+	}
+}
+
+float UEnemySignificanceSubsystem::ScoreEnemy(const ABaseEnemy* Enemy, const FVector& ViewLocation, const FVector& ViewDirection, float CosHalfFOV) const
+{
+	const FVector ToEnemy = Enemy->GetActorLocation() - ViewLocation;
+	const float Distance = ToEnemy.Size();
+	const float DistanceScore = 1.f - FMath::Clamp(Distance / (MaxSignificanceDistance * BudgetScale), 0.f, 1.f);
+
+	// Without rendering (benchmarks, replays) nothing is ever rendered, so only the view cone counts there.
+	const bool bInView = Distance <= KINDA_SMALL_NUMBER || FVector::DotProduct(ToEnemy / Distance, ViewDirection) >= CosHalfFOV;
+	const bool bVisible = bInView && (!FApp::CanEverRender() || Enemy->WasRecentlyRendered(VISIBILITY_WINDOW));
+	float Score = DistanceScore * (bVisible ? 1.f : HiddenWeight);
+
+	// Enemies attacking or focused on the player have to react on time wherever they are.
+	const AAIController* AIController = Cast<AAIController>(Enemy->GetController());
+	const bool bFocusedOnPlayer = AIController && AIController->GetFocusActor() && AIController->GetFocusActor() == UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	const bool bRecentlyAttacked = GetWorld()->GetTimeSeconds() - Enemy->GetLastAttackTime() < CombatMemory;
+	if (bFocusedOnPlayer || bRecentlyAttacked)
+		Score = FMath::Max(Score, HighScore);
+
+	return Score;
+}
+
+float UEnemySignificanceSubsystem::GetTickInterval(const AActor* Enemy) const
+{
+	const APawn* Pawn = Cast<APawn>(Enemy);
+	const FEnemyEntry* Entry = Enemies.FindByPredicate([Pawn](const FEnemyEntry& Entry) { return Entry.Enemy.Get() == Pawn; });
+	return Entry ? GetTickInterval(Entry->Significance) : 0.f;
+}
+
+void UEnemySignificanceSubsystem::ApplySignificance(ABaseEnemy* Enemy, EEnemySignificance Significance) const
+{
+	const float TickInterval = GetTickInterval(Significance);
+	USkeletalMeshComponent* Mesh = Enemy->GetMesh();
+
+	// Movement and any other ticking components follow the actor. The mesh is left to update rate optimizations.
+	Enemy->SetActorTickInterval(TickInterval);
+	for (UActorComponent* Component : Enemy->GetComponents())
+	{
+		if (Component != Mesh)
+			Component->SetComponentTickInterval(TickInterval);
+	}
+
+	if (Mesh)
+	{
+		// Off screen and far away enemies only keep their montages going, their pose isn't seen.
+		Mesh->VisibilityBasedAnimTickOption = Significance >= EEnemySignificance::Low
+			? EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered
+			: EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+		// Less significant enemies skip animation frames at larger screen sizes, interpolating the skipped ones.
+		if (FAnimUpdateRateParameters* UpdateRate = Mesh->AnimUpdateRateParams)
+		{
+			const float Scale = GetAnimScreenSizeScale(Significance);
+			UpdateRate->BaseVisibleDistanceFactorThesholds.Reset();
+			for (const float ScreenSize : ANIM_SKIP_SCREEN_SIZES)
+				UpdateRate->BaseVisibleDistanceFactorThesholds.Add(ScreenSize * Scale);
+		}
+	}
+
+	AAIController* AIController = Cast<AAIController>(Enemy->GetController());
+	if (!AIController)
+	{
+		return;
+	}
+
+	// The behavior tree component sets its own tick interval from the tree's next service or node, so it is skipped
+	// here. Native nodes space their checks with GetTickInterval(), dormant enemies have their tree paused.
+	UBrainComponent* BrainComponent = AIController->GetBrainComponent();
+	AIController->SetActorTickInterval(TickInterval);
+	for (UActorComponent* Component : AIController->GetComponents())
+	{
+		if (Component != BrainComponent)
+			Component->SetComponentTickInterval(TickInterval);
+	}
+
+	if (BrainComponent && Significance == EEnemySignificance::Dormant)
+		BrainComponent->PauseLogic(TEXT("Dormant"));
+	else if (BrainComponent)
+		BrainComponent->ResumeLogic(TEXT("Dormant"));
+}
+
+float UEnemySignificanceSubsystem::GetAnimScreenSizeScale(EEnemySignificance Significance) const
+{
+	switch (Significance)
+	{
+	case EEnemySignificance::Medium:	return MediumAnimScreenSizeScale;
+	case EEnemySignificance::Low:		return LowAnimScreenSizeScale;
+	case EEnemySignificance::Dormant:	return DormantAnimScreenSizeScale;
+	default:							return 1.f;
+	}
+}
+
+float UEnemySignificanceSubsystem::GetTickInterval(EEnemySignificance Significance) const
+{
+	switch (Significance)
+	{
+	case EEnemySignificance::Medium:	return MediumTickInterval;
+	case EEnemySignificance::Low:		return LowTickInterval;
+	case EEnemySignificance::Dormant:	return DormantTickInterval;
+	default:							return 0;
+	}
+}
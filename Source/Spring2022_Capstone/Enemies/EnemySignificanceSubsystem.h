@@ -0,0 +1,128 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySignificanceSubsystem.generated.h"
+
+class ABaseEnemy;
+
+// Update rate tiers the significance subsystem puts enemies in, most significant first.
+UENUM()
+enum class EEnemySignificance : uint8
+{
+	High,
+	Medium,
+	Low,
+	Dormant
+};
+
+/**
+ * Scores every ABaseEnemy by distance to the player's view, whether it is on screen and whether it is in combat,
+ * then moves it between EEnemySignificance tiers.
+ *
+ * A tier sets the tick interval of the enemy, its movement, its AI controller and the controller's path following.
+ * Animation is scaled through the mesh's update rate optimizations, which skip and interpolate frames by screen size,
+ * with less significant tiers skipping at larger sizes. The behavior tree component picks its own tick interval, so
+ * native nodes space their checks by GetTickInterval() and Dormant enemies have their tree paused until they rise
+ * again. Only a limited number of enemies can be High at once, the rest fall back to Medium, so large encounters keep
+ * a bounded cost.
+ *
+ * Capstone.AILOD 0 keeps every enemy at High for comparisons.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UEnemySignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterEnemy(ABaseEnemy* Enemy);
+	void UnregisterEnemy(ABaseEnemy* Enemy);
+
+	EEnemySignificance GetSignificance(const ABaseEnemy* Enemy) const;
+
+	/**
+	 * @brief Tick interval of Enemy's tier, 0 for High and for actors that aren't registered. Native behavior tree
+	 * nodes wait at least this long between checks.
+	 */
+	float GetTickInterval(const AActor* Enemy) const;
+
+	// Number of enemies currently in Significance.
+	int32 GetEnemyCount(EEnemySignificance Significance) const;
+
+	// Shrinks the High budget and the significance distance, set by the encounter director when frames get slow.
+	void SetBudgetScale(float Scale) { BudgetScale = Scale; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FEnemyEntry
+	{
+		TWeakObjectPtr<ABaseEnemy> Enemy;
+		EEnemySignificance Significance = EEnemySignificance::High;
+		float Score = 0;
+	};
+
+	void UpdateSignificance();
+	float ScoreEnemy(const ABaseEnemy* Enemy, const FVector& ViewLocation, const FVector& ViewDirection, float CosHalfFOV) const;
+	void ApplySignificance(ABaseEnemy* Enemy, EEnemySignificance Significance) const;
+	float GetTickInterval(EEnemySignificance Significance) const;
+	float GetAnimScreenSizeScale(EEnemySignificance Significance) const;
+
+	// Seconds between significance updates.
+	UPROPERTY(Config)
+	float UpdateInterval = 0.2f;
+
+	// Enemies this far from the view or further score nothing for distance.
+	UPROPERTY(Config)
+	float MaxSignificanceDistance = 8000.f;
+
+	// Distance score multiplier for enemies that are off screen.
+	UPROPERTY(Config)
+	float HiddenWeight = 0.4f;
+
+	// Seconds after attacking that an enemy still counts as in combat.
+	UPROPERTY(Config)
+	float CombatMemory = 3.f;
+
+	// Lowest scores for each tier, enemies in combat always score at least HighScore.
+	UPROPERTY(Config)
+	float HighScore = 0.6f;
+	UPROPERTY(Config)
+	float MediumScore = 0.3f;
+	UPROPERTY(Config)
+	float LowScore = 0.05f;
+
+	// Most enemies at High at once, the highest scores win.
+	UPROPERTY(Config)
+	int32 MaxHighEnemies = 16;
+
+	// Tick intervals of each tier, High always ticks every frame.
+	UPROPERTY(Config)
+	float MediumTickInterval = 0.1f;
+	UPROPERTY(Config)
+	float LowTickInterval = 0.25f;
+	UPROPERTY(Config)
+	float DormantTickInterval = 0.5f;
+
+	// Multipliers on the screen sizes below which animation frames are skipped, High uses them as they are.
+	UPROPERTY(Config)
+	float MediumAnimScreenSizeScale = 1.5f;
+	UPROPERTY(Config)
+	float LowAnimScreenSizeScale = 3.f;
+	UPROPERTY(Config)
+	float DormantAnimScreenSizeScale = 6.f;
+
+	TArray<FEnemyEntry> Enemies;
+	float TimeSinceUpdate = 0;
+	float BudgetScale = 1.f;
+	bool bLODEnabled = true;
+
+/// Const Variables ///
+	const float VISIBILITY_WINDOW = 0.25f;		// Seconds since last rendered that an enemy still counts as on screen.
+};
@@ -0,0 +1,141 @@
+// Created by Spring2022_Capstone team
+
+
+#include "EnemyWaveSpawner.h"
+#include "BaseEnemy.h"
+#include "Components/CapsuleComponent.h"
+#include "EncounterDirectorSubsystem.h"
+#include "EnemyPoolSubsystem.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+
+// Sets default values
+AEnemyWaveSpawner::AEnemyWaveSpawner()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+// Called when the game starts or when spawned
+void AEnemyWaveSpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Dead enemies go back to the pool between waves, so the biggest wave of each class is enough.
+	TMap<UClass*, int32> PoolSizes;
+	for (const FEnemyWave& Wave : Waves)
+	{
+		int32& PoolSize = PoolSizes.FindOrAdd(Wave.EnemyClass.Get());
+		PoolSize = FMath::Max(PoolSize, Wave.Count);
+	}
+
+	if (UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+	{
+		for (const TPair<UClass*, int32>& PoolSize : PoolSizes)
+			Pool->Prewarm(PoolSize.Key, PoolSize.Value);
+		Pool->OnEnemyReleased.AddUObject(this, &AEnemyWaveSpawner::OnEnemyReleased);
+	}
+
+	if (bStartOnBeginPlay)
+		StartEncounter();
+}
+
+void AEnemyWaveSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+		Pool->OnEnemyReleased.RemoveAll(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+// Called every frame
+void AEnemyWaveSpawner::Tick(float DeltaTime)
+{
+	CAPSTONE_SCOPE_COST(AI);
+	Super::Tick(DeltaTime);
+
+	if (PendingSpawns > 0)
+	{
+		// The director holds spawns back while frames are close to the target.
+		UEncounterDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEncounterDirectorSubsystem>();
+		const int32 Wanted = FMath::Min(PendingSpawns, MaxSpawnsPerFrame);
+		const int32 SpawnsThisFrame = Director ? Director->RequestSpawns(Wanted) : Wanted;
+		for (int32 Spawn = 0; Spawn < SpawnsThisFrame; Spawn++)
+			SpawnEnemy(Waves[NextWave - 1].EnemyClass);
+		PendingSpawns -= SpawnsThisFrame;
+		return;
+	}
+
+	AliveEnemies.RemoveAll([](const TWeakObjectPtr<ABaseEnemy>& Enemy) { return !Enemy.IsValid(); });
+	if (AliveEnemies.Num() > 0)
+	{
+		return;
+	}
+
+	if (NextWave >= Waves.Num())
+	{
+		bEncounterActive = false;
+		SetActorTickEnabled(false);
+		return;
+	}
+
+	TimeUntilNextWave -= DeltaTime;
+	if (TimeUntilNextWave > 0)
+	{
+		return;
+	}
+
+	// Each wave fills the spiral around the spawn points from the centre again.
+	PendingSpawns = Waves[NextWave].Count;
+	SpawnCount = 0;
+	NextWave++;
+	if (Waves.IsValidIndex(NextWave))
+		TimeUntilNextWave = Waves[NextWave].Delay;
+}
+
+void AEnemyWaveSpawner::StartEncounter()
+{
+	if (bEncounterActive || Waves.Num() == 0)
+	{
+		return;
+	}
+
+	if (UEncounterDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEncounterDirectorSubsystem>())
+		Director->NotifyEncounterStarted();
+
+	bEncounterActive = true;
+	NextWave = 0;
+	PendingSpawns = 0;
+	SpawnCount = 0;
+	TimeUntilNextWave = Waves[0].Delay;
+	SetActorTickEnabled(true);
+}
+
+void AEnemyWaveSpawner::SpawnEnemy(TSubclassOf<ABaseEnemy> EnemyClass)
+{
+	UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+	const ABaseEnemy* DefaultEnemy = EnemyClass ? EnemyClass->GetDefaultObject<ABaseEnemy>() : nullptr;
+	if (!Pool || !DefaultEnemy)
+	{
+		return;
+	}
+
+	// Spawn points are used in turn, each one filling a sunflower spiral around itself.
+	const int32 PointCount = FMath::Max(SpawnPoints.Num(), 1);
+	const AActor* SpawnPoint = SpawnPoints.IsValidIndex(SpawnCount % PointCount) && SpawnPoints[SpawnCount % PointCount] ? SpawnPoints[SpawnCount % PointCount] : this;
+	const int32 Slot = SpawnCount / PointCount;
+	const float Angle = Slot * PI * (3.f - FMath::Sqrt(5.f));
+	const FVector Offset = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * SpawnSpacing * FMath::Sqrt((float)Slot);
+	SpawnCount++;
+
+	// Spawn points sit on the ground, the capsule is centred on the actor.
+	const FVector Location = SpawnPoint->GetActorLocation() + Offset + FVector(0.f, 0.f, DefaultEnemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+	if (ABaseEnemy* Enemy = Pool->Acquire(EnemyClass, FTransform(SpawnPoint->GetActorRotation(), Location)))
+		AliveEnemies.Add(Enemy);
+}
+
+void AEnemyWaveSpawner::OnEnemyReleased(ABaseEnemy* Enemy)
+{
+	AliveEnemies.Remove(Enemy);
+}
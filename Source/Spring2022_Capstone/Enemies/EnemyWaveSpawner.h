@@ -0,0 +1,95 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "EnemyWaveSpawner.generated.h"
+
+class ABaseEnemy;
+
+USTRUCT(BlueprintType)
+struct FEnemyWave
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Wave")
+	TSubclassOf<ABaseEnemy> EnemyClass;
+
+	UPROPERTY(EditAnywhere, Category = "Wave", meta = (ClampMin = "1"))
+	int32 Count = 5;
+
+	// Seconds between the previous wave being cleared, or the encounter starting, and this wave.
+	UPROPERTY(EditAnywhere, Category = "Wave", meta = (ClampMin = "0"))
+	float Delay = 2.f;
+};
+
+/**
+ * Runs an encounter as a sequence of waves, each one starting once the previous one is dead.
+ *
+ * Enemies come from UEnemyPoolSubsystem. BeginPlay prewarms enough of each class for the biggest wave, so no
+ * enemy is built during the fight, and a wave is brought in at most MaxSpawnsPerFrame enemies a frame so even
+ * large waves stay within the frame budget. UEncounterDirectorSubsystem can hold spawns back further. Enemies
+ * appear at SpawnPoints in turn, spread around each point.
+ *
+ * FGameplaySnapshot records the encounter and the enemies still alive in it, so a retry carries on from the wave
+ * the checkpoint was saved in.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API AEnemyWaveSpawner : public AActor
+{
+	GENERATED_BODY()
+
+	friend struct FGameplaySnapshot;
+
+public:
+	// Sets default values for this actor's properties
+	AEnemyWaveSpawner();
+
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	UFUNCTION(BlueprintCallable, Category = "Encounter")
+	void StartEncounter();
+
+	UFUNCTION(BlueprintPure, Category = "Encounter")
+	bool IsEncounterActive() const { return bEncounterActive; }
+
+	// Enemies of the current wave that are still alive.
+	UFUNCTION(BlueprintPure, Category = "Encounter")
+	int32 GetAliveEnemyCount() const { return AliveEnemies.Num(); }
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(EditAnywhere, Category = "Encounter")
+	TArray<FEnemyWave> Waves;
+
+	// Where enemies appear, in turn. The spawner itself when empty.
+	UPROPERTY(EditInstanceOnly, Category = "Encounter")
+	TArray<AActor*> SpawnPoints;
+
+	// Distance between enemies sharing a spawn point.
+	UPROPERTY(EditAnywhere, Category = "Encounter", meta = (ClampMin = "0"))
+	float SpawnSpacing = 150.f;
+
+	// Enemies activated per frame while a wave comes in.
+	UPROPERTY(EditAnywhere, Category = "Encounter", meta = (ClampMin = "1"))
+	int32 MaxSpawnsPerFrame = 4;
+
+	UPROPERTY(EditAnywhere, Category = "Encounter")
+	bool bStartOnBeginPlay = false;
+
+private:
+	void SpawnEnemy(TSubclassOf<ABaseEnemy> EnemyClass);
+	void OnEnemyReleased(ABaseEnemy* Enemy);
+
+	TArray<TWeakObjectPtr<ABaseEnemy>> AliveEnemies;
+	int32 NextWave = 0;
+	int32 PendingSpawns = 0;
+	int32 SpawnCount = 0;
+	float TimeUntilNextWave = 0;
+	bool bEncounterActive = false;
+};
@@ -2,22 +2,76 @@
 
 #include "RangedEnemy.h"
 
+#include "Engine/World.h"
+#include "EncounterDirectorSubsystem.h"
+#include "EnemyProjectileSubsystem.h"
 #include "Kismet/GameplayStatics.h"
-#include "Spring2022_Capstone/Player/PlayerCharacter.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "TimerManager.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
 
 ARangedEnemy::ARangedEnemy()
 {
-    
+	MagazineSize = 6;
+	Ammo = MagazineSize;
+	ReloadTime = 2.f;
+	MuzzleFlash = nullptr;
 }
 
-void ARangedEnemy::Attack()
+void ARangedEnemy::PerformAttack()
 {
-	// Test Attack, Just here to show Damage Indicator functionality.
-	APlayerCharacter* Player = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(),0));
-	Player->DamageActor(this, 10.0f);
+	CAPSTONE_SCOPE(STAT_CapstoneEnemyAttack, AI);
+	Super::PerformAttack();
+
+	AActor* Target = GetCurrentAttackTarget();
+	UEnemyProjectileSubsystem* Projectiles = GetWorld()->GetSubsystem<UEnemyProjectileSubsystem>();
+	if (!Target || !Projectiles || Ammo <= 0)
+	{
+		return;
+	}
+
+	// Straight at the target's eyes from the muzzle.
+	FVector TargetLocation;
+	FRotator TargetRotation;
+	Target->GetActorEyesViewPoint(TargetLocation, TargetRotation);
+	const FVector Start = ProjectileSpawnPoint->GetComponentLocation();
+	Projectiles->FireProjectile(this, Start, (TargetLocation - Start).GetSafeNormal() * ProjectileSpeed, GetDamage());
+	PlayMuzzleFlash();
+
+	Ammo--;
+	if (Ammo <= 0)
+		GetWorldTimerManager().SetTimer(ReloadTimer, this, &ARangedEnemy::Reload, ReloadTime);
+}
+
+void ARangedEnemy::ResetAttackState()
+{
+	GetWorldTimerManager().ClearTimer(ReloadTimer);
+	Ammo = MagazineSize;
 }
 
 void ARangedEnemy::Reload()
 {
+	Ammo = MagazineSize;
+}
+
+void ARangedEnemy::PlayMuzzleFlash() const
+{
+	if (!MuzzleFlash)
+	{
+		return;
+	}
+
+	// Spawned inactive so a flash over the director's effect limit never starts.
+	UParticleSystemComponent* Flash = UGameplayStatics::SpawnEmitterAttached(MuzzleFlash, ProjectileSpawnPoint, NAME_None, FVector::ZeroVector,
+		FRotator::ZeroRotator, EAttachLocation::SnapToTarget, true, EPSCPoolMethod::None, false);
+	if (!Flash)
+	{
+		return;
+	}
 
+	UEncounterDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEncounterDirectorSubsystem>();
+	if (Director && !Director->RegisterEffect(Flash))
+		Flash->DestroyComponent();
+	else
+		Flash->Activate();
 }
@@ -6,6 +6,8 @@
 #include "BaseEnemy.h"
 #include "RangedEnemy.generated.h"
 
+class UParticleSystem;
+
 /**
  *
  */
@@ -14,12 +16,18 @@ class SPRING2022_CAPSTONE_API ARangedEnemy : public ABaseEnemy
 {
 	GENERATED_BODY()
 
+	friend class UCapstoneSoakTestSubsystem;
+
 public:
 	// Sets default values for this character's properties
 	ARangedEnemy();
 
+	// Out of ammo while reloading, the enemy hands its attack token on.
+	virtual bool CanAttackNow() const override { return Ammo > 0; }
+
 protected: 
-	virtual void Attack() override;
+	virtual void PerformAttack() override;
+	virtual void ResetAttackState() override;
 
 private:
 
@@ -29,6 +37,15 @@ private:
 	int Ammo;
 	UPROPERTY(EditDefaultsOnly, Category = "Stats", meta = (AllowPrivateAccess = true))
 	float ReloadTime;
+	UPROPERTY(EditDefaultsOnly, Category = "Stats", meta = (AllowPrivateAccess = true))
+	float ProjectileSpeed = 4000.f;
+
+	// Played at the muzzle on each shot while the encounter director has room for more effects.
+	UPROPERTY(EditDefaultsOnly, Category = "Effects", meta = (AllowPrivateAccess = true))
+	UParticleSystem* MuzzleFlash;
+
+	FTimerHandle ReloadTimer;
 
 	void Reload();
+	void PlayMuzzleFlash() const;
 };
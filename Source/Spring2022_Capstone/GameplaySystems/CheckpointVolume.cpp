@@ -0,0 +1,48 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CheckpointVolume.h"
+#include "Components/BoxComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Spring2022_Capstone/Spring2022_CapstoneGameModeBase.h"
+#include "Spring2022_Capstone/Player/PlayerCharacter.h"
+
+// Sets default values
+ACheckpointVolume::ACheckpointVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	CheckpointCollider = CreateDefaultSubobject<UBoxComponent>("Checkpoint Collider");
+	CheckpointCollider->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
+	RootComponent = CheckpointCollider;
+}
+
+// Called when the game starts or when spawned
+void ACheckpointVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CheckpointCollider->OnComponentBeginOverlap.AddDynamic(this, &ACheckpointVolume::OnOverlapBegin);
+
+	bTriggered = false;
+}
+
+void ACheckpointVolume::OnOverlapBegin(UPrimitiveComponent* Comp, AActor* OtherActor, UPrimitiveComponent* OtherComp,
+	int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (!OtherActor || !OtherActor->IsA(APlayerCharacter::StaticClass()))
+	{
+		return;
+	}
+
+	if (bTriggerOnce && bTriggered)
+	{
+		return;
+	}
+
+	if (ASpring2022_CapstoneGameModeBase* GameMode = Cast<ASpring2022_CapstoneGameModeBase>(UGameplayStatics::GetGameMode(this)))
+	{
+		GameMode->SaveCheckpoint();
+		bTriggered = true;
+	}
+}
@@ -0,0 +1,38 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CheckpointVolume.generated.h"
+
+class UBoxComponent;
+
+/**
+ * Saves a gameplay snapshot through the game mode when the player enters the volume.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API ACheckpointVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	ACheckpointVolume();
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	UPROPERTY(EditAnywhere, Category = "Components", meta = (AllowPrivateAccess = true))
+	UBoxComponent* CheckpointCollider;
+
+	UFUNCTION()
+	void OnOverlapBegin(UPrimitiveComponent* Comp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
+
+	// If true: the checkpoint is only saved the first time the player enters the volume.
+	UPROPERTY(EditAnywhere, Category = "Checkpoint")
+	bool bTriggerOnce = true;
+
+	bool bTriggered;
+};
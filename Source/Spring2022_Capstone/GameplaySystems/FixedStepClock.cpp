@@ -0,0 +1,85 @@
+// Created by Spring2022_Capstone team
+
+
+#include "FixedStepClock.h"
+#include "Misc/App.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarFixedStepHz(
+		TEXT("Capstone.FixedStepHz"),
+		0,
+		TEXT("Simulation rate of gameplay components in steps per second, 0 uses the frame's delta time."),
+		ECVF_Default);
+}
+
+uint32 FFixedStepClock::ResetGeneration = 0;
+
+int32 FFixedStepClock::Advance(float DeltaTime)
+{
+	if (Generation != ResetGeneration)
+	{
+		Generation = ResetGeneration;
+		Accumulator = 0;
+	}
+
+	const float FixedStepTime = GetFixedStepTime();
+	if (FixedStepTime <= 0)
+	{
+		Accumulator = 0;
+		StepTime = DeltaTime;
+		return 1;
+	}
+
+	StepTime = FixedStepTime;
+	Accumulator += DeltaTime;
+
+	int32 Steps = FMath::FloorToInt(Accumulator / StepTime + STEP_TOLERANCE);
+	if (Steps > MAX_STEPS_PER_FRAME)
+	{
+		Steps = MAX_STEPS_PER_FRAME;
+		Accumulator = Steps * StepTime;
+	}
+	Accumulator = FMath::Max(0.f, Accumulator - Steps * StepTime);
+
+	return Steps;
+}
+
+float FFixedStepClock::GetAlpha() const
+{
+	return StepTime > 0 && IsFixedStepEnabled() ? FMath::Clamp(Accumulator / StepTime, 0.f, 1.f) : 1.f;
+}
+
+int32 FFixedStepClock::GetFixedStepHz()
+{
+	return CVarFixedStepHz.GetValueOnGameThread();
+}
+
+void FFixedStepClock::SetFixedStepHz(int32 StepHz)
+{
+	CVarFixedStepHz->Set(StepHz, ECVF_SetByCode);
+}
+
+float FFixedStepClock::GetFixedStepTime()
+{
+	const int32 StepHz = GetFixedStepHz();
+	return StepHz > 0 ? 1.f / StepHz : 0.f;
+}
+
+void FFixedStepClock::InitFromCommandLine()
+{
+	int32 StepHz = 0;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("CapstoneFixedStep="), StepHz) || StepHz <= 0)
+	{
+		return;
+	}
+
+	CVarFixedStepHz->Set(StepHz, ECVF_SetByCommandline);
+
+	// One engine frame per step, fixed timestep mode also stops the engine from waiting for real time to pass.
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / StepHz);
+
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Fixed step simulation at %d Hz"), StepHz);
+}
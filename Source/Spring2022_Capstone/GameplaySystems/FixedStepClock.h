@@ -0,0 +1,64 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Splits a component's variable frame time into fixed simulation steps.
+ *
+ * Off by default, in which case every frame is a single step of the frame's DeltaTime and gameplay runs as before.
+ * Set Capstone.FixedStepHz, or launch with -CapstoneFixedStep=<Hz>, to simulate in steps of 1/Hz seconds instead.
+ * Values that are only presented (camera offsets, post process weights) should be blended between the last two steps
+ * with GetAlpha() so they stay smooth when the frame rate is higher than the step rate.
+ *
+ * -CapstoneFixedStep also puts the engine in fixed timestep mode with the same step, so every frame is exactly one
+ * step: headless runs (-nullrhi) then tick as fast as the CPU allows and replay bit-identical outcomes.
+ */
+struct SPRING2022_CAPSTONE_API FFixedStepClock
+{
+	/**
+	 * @brief Adds DeltaTime to the clock.
+	 * @return The number of steps of GetStepTime() to simulate this frame, can be 0.
+	 */
+	int32 Advance(float DeltaTime);
+
+	// Length of the steps returned by the last Advance().
+	float GetStepTime() const { return StepTime; }
+
+	// How far the frame is past the last simulated step, from 0 to 1. Always 1 when fixed steps are off.
+	float GetAlpha() const;
+
+	// Drops the time left over from earlier frames.
+	void Reset() { Accumulator = 0; }
+
+	/**
+	 * @brief Resets every clock on its next Advance(), so a recording and its replay start stepping in sync.
+	 */
+	static void ResetAll() { ResetGeneration++; }
+
+	static bool IsFixedStepEnabled() { return GetFixedStepHz() > 0; }
+
+	// Steps per second, 0 when fixed steps are off.
+	static int32 GetFixedStepHz();
+	static void SetFixedStepHz(int32 StepHz);
+
+	// Seconds per step, 0 when fixed steps are off.
+	static float GetFixedStepTime();
+
+	/**
+	 * @brief Handles -CapstoneFixedStep=<Hz>, called once on module startup.
+	 */
+	static void InitFromCommandLine();
+
+private:
+	float Accumulator = 0;
+	float StepTime = 0;
+	uint32 Generation = 0;
+
+	static uint32 ResetGeneration;
+
+/// Const Variables ///
+	static constexpr int32 MAX_STEPS_PER_FRAME = 8;		// Time past this many steps is dropped so a long hitch doesn't snowball.
+	static constexpr float STEP_TOLERANCE = 1e-3f;		// Fraction of a step treated as a whole step, absorbs float error in the accumulator.
+};
@@ -0,0 +1,285 @@
+// Created by Spring2022_Capstone team
+
+#include "GameplaySnapshot.h"
+#include "EngineUtils.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Spring2022_Capstone/BasePickup.h"
+#include "Spring2022_Capstone/HealthComponent.h"
+#include "Spring2022_Capstone/Enemies/BaseEnemy.h"
+#include "Spring2022_Capstone/Enemies/EnemyPoolSubsystem.h"
+#include "Spring2022_Capstone/Enemies/EnemyProjectileSubsystem.h"
+#include "Spring2022_Capstone/Enemies/EnemyWaveSpawner.h"
+#include "Spring2022_Capstone/Player/GrappleComponent.h"
+#include "Spring2022_Capstone/Player/PlayerCharacter.h"
+#include "Spring2022_Capstone/Weapon/WeaponBase.h"
+
+FGameplaySnapshot FGameplaySnapshot::Capture(UWorld* World)
+{
+	FGameplaySnapshot Snapshot;
+	if (!World)
+	{
+		return Snapshot;
+	}
+
+	if (APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0)))
+	{
+		Snapshot.Player.Transform = PlayerCharacter->GetActorTransform();
+		Snapshot.Player.ControlRotation = PlayerCharacter->GetControlRotation();
+		Snapshot.Player.Health = PlayerCharacter->HealthComponent->GetHealth();
+		Snapshot.Player.MaxHealth = PlayerCharacter->HealthComponent->GetMaxHealth();
+		Snapshot.Player.Speed = PlayerCharacter->Speed;
+		Snapshot.Player.JumpMaxCount = PlayerCharacter->JumpMaxCount;
+		Snapshot.Player.GrappleCooldown = PlayerCharacter->GrappleComponent->Cooldown;
+	}
+
+	for (TActorIterator<AWeaponBase> It(World); It; ++It)
+	{
+		FWeaponSnapshot& WeaponSnapshot = Snapshot.Weapons.AddDefaulted_GetRef();
+		WeaponSnapshot.WeaponName = It->GetFName();
+		WeaponSnapshot.CurrentCharge = It->CurrentCharge;
+		WeaponSnapshot.bIsOverheating = It->bIsOverheating;
+		WeaponSnapshot.MaxChargeAmount = It->MaxChargeAmount;
+		WeaponSnapshot.ChargeCooldownRate = It->ChargeCooldownRate;
+		WeaponSnapshot.ShotDamage = It->ShotDamage;
+	}
+
+	for (TActorIterator<ABasePickup> It(World); It; ++It)
+	{
+		FPickupSnapshot& PickupSnapshot = Snapshot.Pickups.AddDefaulted_GetRef();
+		PickupSnapshot.PickupName = It->GetFName();
+		PickupSnapshot.bCollected = It->IsCollected();
+	}
+
+	for (TActorIterator<ABaseEnemy> It(World); It; ++It)
+	{
+		// Enemies waiting in the pool belong to it, not to the level.
+		if (It->bIsPooled && !It->bIsActive)
+			continue;
+
+		FEnemySnapshot& EnemySnapshot = Snapshot.Enemies.AddDefaulted_GetRef();
+		EnemySnapshot.EnemyName = It->GetFName();
+		EnemySnapshot.Transform = It->GetActorTransform();
+		EnemySnapshot.Health = It->HealthComponent->GetHealth();
+	}
+
+	for (TActorIterator<AEnemyWaveSpawner> It(World); It; ++It)
+	{
+		FEncounterSnapshot& EncounterSnapshot = Snapshot.Encounters.AddDefaulted_GetRef();
+		EncounterSnapshot.SpawnerName = It->GetFName();
+		for (const TWeakObjectPtr<ABaseEnemy>& Enemy : It->AliveEnemies)
+		{
+			if (Enemy.IsValid())
+				EncounterSnapshot.AliveEnemyNames.Add(Enemy->GetFName());
+		}
+		EncounterSnapshot.NextWave = It->NextWave;
+		EncounterSnapshot.PendingSpawns = It->PendingSpawns;
+		EncounterSnapshot.SpawnCount = It->SpawnCount;
+		EncounterSnapshot.TimeUntilNextWave = It->TimeUntilNextWave;
+		EncounterSnapshot.bEncounterActive = It->bEncounterActive;
+	}
+
+	Snapshot.bIsValid = true;
+	return Snapshot;
+}
+
+void FGameplaySnapshot::Apply(UWorld* World) const
+{
+	if (!World || !bIsValid)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+
+	if (APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0)))
+	{
+		// Stop any ability that is still running before moving the player.
+		PlayerCharacter->GrappleComponent->CancelGrapple();
+		TimerManager.ClearTimer(PlayerCharacter->GrappleComponent->CooldownTimerHandle);
+		PlayerCharacter->GrappleComponent->ResetStatus();
+
+		PlayerCharacter->PlayerMantleSystemComponent->CancelMantle();
+		PlayerCharacter->bIsMantleing = false;
+
+		TimerManager.ClearTimer(PlayerCharacter->DashDirectionalMovementDelayTimerHandle);
+		TimerManager.ClearTimer(PlayerCharacter->DashCooldownTimerHandle);
+		TimerManager.ClearTimer(PlayerCharacter->DashBlurTimerHandle);
+		PlayerCharacter->bCanDash = true;
+		if (PlayerCharacter->bDashBlurFadingIn)
+			PlayerCharacter->ClearDashBlur();
+
+		UCharacterMovementComponent* MovementComponent = PlayerCharacter->GetCharacterMovement();
+		MovementComponent->StopMovementImmediately();
+		MovementComponent->SetMovementMode(MOVE_Walking);
+		PlayerCharacter->SetActorTransform(Player.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		if (AController* Controller = PlayerCharacter->GetController())
+			Controller->SetControlRotation(Player.ControlRotation);
+
+		PlayerCharacter->HealthComponent->SetMaxHealth(Player.MaxHealth);
+		PlayerCharacter->HealthComponent->SetHealth(Player.Health);
+		PlayerCharacter->UpdateHealthBar();
+
+		PlayerCharacter->Speed = Player.Speed;
+		PlayerCharacter->GetCharacterMovement()->MaxWalkSpeed = Player.Speed;
+		PlayerCharacter->JumpMaxCount = Player.JumpMaxCount;
+		PlayerCharacter->GrappleComponent->Cooldown = Player.GrappleCooldown;
+	}
+
+	// Level placed actors keep their names, so they are matched by name instead of holding pointers.
+	TMap<FName, AWeaponBase*> WeaponsByName;
+	for (TActorIterator<AWeaponBase> It(World); It; ++It)
+		WeaponsByName.Add(It->GetFName(), *It);
+
+	for (const FWeaponSnapshot& WeaponSnapshot : Weapons)
+	{
+		AWeaponBase* const* Weapon = WeaponsByName.Find(WeaponSnapshot.WeaponName);
+		if (!Weapon)
+			continue;
+
+		(*Weapon)->ClearFireTimerHandle();
+		TimerManager.ClearTimer((*Weapon)->OverheatTimerHandle);
+		(*Weapon)->bIsOverheating = false;
+		(*Weapon)->bCanFire = true;
+		if (WeaponSnapshot.bIsOverheating)
+			(*Weapon)->Overheat();
+		(*Weapon)->CurrentCharge = WeaponSnapshot.CurrentCharge;
+		(*Weapon)->MaxChargeAmount = WeaponSnapshot.MaxChargeAmount;
+		(*Weapon)->ChargeCooldownRate = WeaponSnapshot.ChargeCooldownRate;
+		(*Weapon)->ShotDamage = WeaponSnapshot.ShotDamage;
+	}
+
+	TMap<FName, ABasePickup*> PickupsByName;
+	for (TActorIterator<ABasePickup> It(World); It; ++It)
+		PickupsByName.Add(It->GetFName(), *It);
+
+	for (const FPickupSnapshot& PickupSnapshot : Pickups)
+	{
+		if (ABasePickup* const* Pickup = PickupsByName.Find(PickupSnapshot.PickupName))
+			(*Pickup)->SetCollected(PickupSnapshot.bCollected);
+	}
+
+	// Projectiles fired before the restore would still hit the restored player.
+	if (UEnemyProjectileSubsystem* Projectiles = World->GetSubsystem<UEnemyProjectileSubsystem>())
+		Projectiles->ClearProjectiles();
+
+	TMap<FName, ABaseEnemy*> EnemiesByName;
+	for (TActorIterator<ABaseEnemy> It(World); It; ++It)
+		EnemiesByName.Add(It->GetFName(), *It);
+
+	// Pooled enemies brought in since the snapshot go back to the pool.
+	if (UEnemyPoolSubsystem* Pool = World->GetSubsystem<UEnemyPoolSubsystem>())
+	{
+		TSet<FName> AliveEnemyNames;
+		for (const FEnemySnapshot& EnemySnapshot : Enemies)
+		{
+			if (EnemySnapshot.Health > 0)
+				AliveEnemyNames.Add(EnemySnapshot.EnemyName);
+		}
+
+		TArray<ABaseEnemy*> ActiveEnemies;
+		Pool->GetActiveEnemies(ActiveEnemies);
+		for (ABaseEnemy* Enemy : ActiveEnemies)
+		{
+			if (!AliveEnemyNames.Contains(Enemy->GetFName()))
+				Pool->Release(Enemy);
+		}
+	}
+
+	for (const FEnemySnapshot& EnemySnapshot : Enemies)
+	{
+		// Pooled enemies that died since went back to the pool, their encounter spawns them again below.
+		ABaseEnemy* const* Enemy = EnemiesByName.Find(EnemySnapshot.EnemyName);
+		if (!Enemy || ((*Enemy)->bIsPooled && !(*Enemy)->bIsActive))
+			continue;
+
+		// Level placed enemies are only hidden when they die, bring back the ones alive in the snapshot.
+		if (EnemySnapshot.Health <= 0)
+		{
+			if ((*Enemy)->bIsActive)
+				(*Enemy)->Die();
+			continue;
+		}
+		if (!(*Enemy)->bIsActive)
+			(*Enemy)->SetEnemyActive(true);
+
+		(*Enemy)->GetCharacterMovement()->StopMovementImmediately();
+		(*Enemy)->SetActorTransform(EnemySnapshot.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		(*Enemy)->HealthComponent->SetHealth(EnemySnapshot.Health);
+
+		// Restart the behavior tree so the blackboard starts from its initial values.
+		if (AAIController* AIController = Cast<AAIController>((*Enemy)->GetController()))
+		{
+			AIController->StopMovement();
+			if (UBrainComponent* BrainComponent = AIController->GetBrainComponent())
+				BrainComponent->RestartLogic();
+		}
+	}
+
+	TMap<FName, const FEncounterSnapshot*> EncountersByName;
+	for (const FEncounterSnapshot& EncounterSnapshot : Encounters)
+		EncountersByName.Add(EncounterSnapshot.SpawnerName, &EncounterSnapshot);
+
+	// Spawners placed after the snapshot go back to no encounter running.
+	const FEncounterSnapshot NotStarted;
+	for (TActorIterator<AEnemyWaveSpawner> It(World); It; ++It)
+	{
+		const FEncounterSnapshot* const* Found = EncountersByName.Find(It->GetFName());
+		const FEncounterSnapshot& EncounterSnapshot = Found ? **Found : NotStarted;
+
+		It->NextWave = EncounterSnapshot.NextWave;
+		It->PendingSpawns = EncounterSnapshot.PendingSpawns;
+		It->SpawnCount = EncounterSnapshot.SpawnCount;
+		It->TimeUntilNextWave = EncounterSnapshot.TimeUntilNextWave;
+		It->bEncounterActive = EncounterSnapshot.bEncounterActive;
+
+		// Alive enemies all belong to the current wave, the ones that died since are spawned again with it.
+		It->AliveEnemies.Reset();
+		for (const FName& EnemyName : EncounterSnapshot.AliveEnemyNames)
+		{
+			ABaseEnemy* const* Enemy = EnemiesByName.Find(EnemyName);
+			if (Enemy && (*Enemy)->bIsActive)
+				It->AliveEnemies.Add(*Enemy);
+			else
+				It->PendingSpawns++;
+		}
+		It->SetActorTickEnabled(EncounterSnapshot.bEncounterActive);
+	}
+}
+
+void FGameplaySnapshot::ToBytes(TArray<uint8>& OutBytes) const
+{
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+
+	// operator<< takes non-const references since the same path is used for reading.
+	FGameplaySnapshot& Snapshot = const_cast<FGameplaySnapshot&>(*this);
+	uint8 Version = SNAPSHOT_VERSION;
+	Writer << Version << Snapshot.Player << Snapshot.Weapons << Snapshot.Pickups << Snapshot.Enemies << Snapshot.Encounters;
+}
+
+bool FGameplaySnapshot::FromBytes(const TArray<uint8>& Bytes)
+{
+	bIsValid = false;
+	if (Bytes.Num() == 0)
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint8 Version = 0;
+	Reader << Version;
+	if (Version != SNAPSHOT_VERSION)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Gameplay snapshot version %d does not match %d"), Version, SNAPSHOT_VERSION);
+		return false;
+	}
+
+	Reader << Player << Weapons << Pickups << Enemies << Encounters;
+	bIsValid = !Reader.IsError();
+	return bIsValid;
+}
@@ -0,0 +1,183 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplaySnapshot.generated.h"
+
+USTRUCT()
+struct FPlayerSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FTransform Transform;
+	UPROPERTY()
+	FRotator ControlRotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	float Health = 0;
+	UPROPERTY()
+	float MaxHealth = 0;
+
+	// Values changed by UUpgradeSystemComponent.
+	UPROPERTY()
+	float Speed = 0;
+	UPROPERTY()
+	int32 JumpMaxCount = 1;
+	UPROPERTY()
+	float GrappleCooldown = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FPlayerSnapshot& Snapshot)
+	{
+		return Ar << Snapshot.Transform << Snapshot.ControlRotation << Snapshot.Health << Snapshot.MaxHealth
+			<< Snapshot.Speed << Snapshot.JumpMaxCount << Snapshot.GrappleCooldown;
+	}
+};
+
+USTRUCT()
+struct FWeaponSnapshot
+{
+	GENERATED_BODY()
+
+	// Name of the level placed weapon, used to find it again on restore.
+	UPROPERTY()
+	FName WeaponName;
+
+	UPROPERTY()
+	float CurrentCharge = 0;
+	UPROPERTY()
+	bool bIsOverheating = false;
+
+	// Values changed by UUpgradeSystemComponent.
+	UPROPERTY()
+	float MaxChargeAmount = 0;
+	UPROPERTY()
+	float ChargeCooldownRate = 0;
+	UPROPERTY()
+	float ShotDamage = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FWeaponSnapshot& Snapshot)
+	{
+		return Ar << Snapshot.WeaponName << Snapshot.CurrentCharge << Snapshot.bIsOverheating
+			<< Snapshot.MaxChargeAmount << Snapshot.ChargeCooldownRate << Snapshot.ShotDamage;
+	}
+};
+
+USTRUCT()
+struct FPickupSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName PickupName;
+	UPROPERTY()
+	bool bCollected = false;
+
+	friend FArchive& operator<<(FArchive& Ar, FPickupSnapshot& Snapshot)
+	{
+		return Ar << Snapshot.PickupName << Snapshot.bCollected;
+	}
+};
+
+USTRUCT()
+struct FEnemySnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName EnemyName;
+	UPROPERTY()
+	FTransform Transform;
+	UPROPERTY()
+	float Health = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FEnemySnapshot& Snapshot)
+	{
+		return Ar << Snapshot.EnemyName << Snapshot.Transform << Snapshot.Health;
+	}
+};
+
+USTRUCT()
+struct FEncounterSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName SpawnerName;
+	// Enemies of the current wave still alive, pooled ones that die before the restore are spawned again.
+	UPROPERTY()
+	TArray<FName> AliveEnemyNames;
+
+	UPROPERTY()
+	int32 NextWave = 0;
+	UPROPERTY()
+	int32 PendingSpawns = 0;
+	UPROPERTY()
+	int32 SpawnCount = 0;
+	UPROPERTY()
+	float TimeUntilNextWave = 0;
+	UPROPERTY()
+	bool bEncounterActive = false;
+
+	friend FArchive& operator<<(FArchive& Ar, FEncounterSnapshot& Snapshot)
+	{
+		return Ar << Snapshot.SpawnerName << Snapshot.AliveEnemyNames << Snapshot.NextWave << Snapshot.PendingSpawns
+			<< Snapshot.SpawnCount << Snapshot.TimeUntilNextWave << Snapshot.bEncounterActive;
+	}
+};
+
+/**
+ * @brief Gameplay state of a level at one point in time (player, weapons, pickups, enemies and wave encounters).
+ * Applying a snapshot resets the live actors in place, no map travel is needed.
+ */
+USTRUCT()
+struct SPRING2022_CAPSTONE_API FGameplaySnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FPlayerSnapshot Player;
+	UPROPERTY()
+	TArray<FWeaponSnapshot> Weapons;
+	UPROPERTY()
+	TArray<FPickupSnapshot> Pickups;
+	UPROPERTY()
+	TArray<FEnemySnapshot> Enemies;
+	UPROPERTY()
+	TArray<FEncounterSnapshot> Encounters;
+
+	/**
+	 * @brief Records the current state of the gameplay actors in World.
+	 * @param World World to capture.
+	 */
+	static FGameplaySnapshot Capture(UWorld* World);
+
+	/**
+	 * @brief Resets the gameplay actors in World to the recorded state. Level placed enemies that died since are
+	 * revived, pooled enemies brought in since go back to the pool and each encounter carries on from the recorded
+	 * wave, spawning again the enemies of it that died since. Enemy projectiles in flight are removed.
+	 * @param World World the snapshot was captured from.
+	 */
+	void Apply(UWorld* World) const;
+
+	/**
+	 * @brief Writes the snapshot into a compact binary buffer. Safe to call off the game thread.
+	 * @param OutBytes Buffer the snapshot is written to.
+	 */
+	void ToBytes(TArray<uint8>& OutBytes) const;
+
+	/**
+	 * @brief Reads a snapshot written by ToBytes().
+	 * @return false - buffer is empty or was written by a different snapshot version.
+	 */
+	bool FromBytes(const TArray<uint8>& Bytes);
+
+	bool IsValid() const { return bIsValid; }
+
+private:
+	bool bIsValid = false;
+
+	// Bump when the binary layout written by ToBytes() changes.
+	static constexpr uint8 SNAPSHOT_VERSION = 2;
+};
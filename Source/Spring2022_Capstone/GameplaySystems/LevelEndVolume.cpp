@@ -0,0 +1,38 @@
+// Created by Spring2022_Capstone team
+
+
+#include "LevelEndVolume.h"
+#include "Components/BoxComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Spring2022_Capstone/Spring2022_CapstoneGameModeBase.h"
+#include "Spring2022_Capstone/Player/PlayerCharacter.h"
+
+// Sets default values
+ALevelEndVolume::ALevelEndVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	LevelEndCollider = CreateDefaultSubobject<UBoxComponent>("Level End Collider");
+	LevelEndCollider->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
+	RootComponent = LevelEndCollider;
+}
+
+// Called when the game starts or when spawned
+void ALevelEndVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	LevelEndCollider->OnComponentBeginOverlap.AddDynamic(this, &ALevelEndVolume::OnOverlapBegin);
+}
+
+void ALevelEndVolume::OnOverlapBegin(UPrimitiveComponent* Comp, AActor* OtherActor, UPrimitiveComponent* OtherComp,
+	int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (!OtherActor || !OtherActor->IsA(APlayerCharacter::StaticClass()))
+	{
+		return;
+	}
+
+	if (ASpring2022_CapstoneGameModeBase* GameMode = Cast<ASpring2022_CapstoneGameModeBase>(UGameplayStatics::GetGameMode(this)))
+		GameMode->ShowEndScreen(true);
+}
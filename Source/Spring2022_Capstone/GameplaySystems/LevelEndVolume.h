@@ -0,0 +1,32 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "LevelEndVolume.generated.h"
+
+class UBoxComponent;
+
+/**
+ * Completes the level when the player enters the volume, showing the victory screen through the game mode.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API ALevelEndVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	ALevelEndVolume();
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	UPROPERTY(EditAnywhere, Category = "Components", meta = (AllowPrivateAccess = true))
+	UBoxComponent* LevelEndCollider;
+
+	UFUNCTION()
+	void OnOverlapBegin(UPrimitiveComponent* Comp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
+};
@@ -0,0 +1,677 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneBenchmarkSubsystem.h"
+#include "CapstoneChurnTracker.h"
+#include "CapstoneInputLatency.h"
+#include "CapstoneInputDriver.h"
+#include "CapstoneStats.h"
+#include "EngineUtils.h"
+#include "JsonObjectConverter.h"
+#include "RenderCore.h"
+#include "Engine/TargetPoint.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Spring2022_Capstone/BasePickup.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+#include "Spring2022_Capstone/Enemies/BaseEnemy.h"
+#include "Spring2022_Capstone/Enemies/EncounterDirectorSubsystem.h"
+#include "Spring2022_Capstone/Enemies/EnemyPoolSubsystem.h"
+#include "Spring2022_Capstone/Enemies/AI/EnemyAIController.h"
+#include "Spring2022_Capstone/Enemies/AI/EnemyPathRequestSubsystem.h"
+#include "Spring2022_Capstone/GameplaySystems/CheckpointVolume.h"
+#include "Spring2022_Capstone/GameplaySystems/FixedStepClock.h"
+#include "Spring2022_Capstone/Player/GrappleComponent.h"
+#include "Spring2022_Capstone/Player/PlayerCharacter.h"
+
+CSV_DEFINE_CATEGORY(Capstone, true);
+
+namespace
+{
+	const FName BENCHMARK_TAG = TEXT("Benchmark");
+
+	// Actions given to generated path points, in order.
+	const ECapstoneBenchmarkAction ACTION_CYCLE[] = { ECapstoneBenchmarkAction::FireWeapon1, ECapstoneBenchmarkAction::Grapple,
+		ECapstoneBenchmarkAction::FireWeapon2, ECapstoneBenchmarkAction::Dash, ECapstoneBenchmarkAction::Mantle };
+
+	float Average(const TArray<float>& Samples)
+	{
+		float Sum = 0;
+		for (const float Sample : Samples)
+			Sum += Sample;
+		return Samples.Num() > 0 ? Sum / Samples.Num() : 0.f;
+	}
+
+	float Percentile(TArray<float> Samples, float Fraction)
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0;
+		}
+		Samples.Sort();
+		return Samples[FMath::Clamp(FMath::CeilToInt(Fraction * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+	}
+
+	// LLM slows every allocation, so a run with the memory tags on is its own pass with its own outputs and
+	// baselines, and only its tags are compared.
+	FString GetBaselinePath(const FString& MapName)
+	{
+		const TCHAR* Suffix = FCapstoneMemoryTags::IsTracking() ? TEXT("_MemoryTags.json") : TEXT(".json");
+		return FPaths::ProjectDir() / TEXT("Benchmark/Baselines") / MapName + Suffix;
+	}
+
+	FString GetOutputDir()
+	{
+		const FString OutputDir = FPaths::ProjectSavedDir() / TEXT("Benchmark");
+		return FCapstoneMemoryTags::IsTracking() ? OutputDir / TEXT("MemoryTags") : OutputDir;
+	}
+
+	const float MIN_MS_REGRESSION = 0.25f;			// Frame time changes smaller than this are treated as noise.
+	const int32 MIN_HITCH_REGRESSION = 2;			// Hitch count changes smaller than this are treated as noise.
+	const float MIN_MEMORY_REGRESSION_MB = 32.f;	// Memory changes smaller than this are treated as noise.
+	const float MIN_TAG_REGRESSION_MB = 1.f;		// Memory tag changes smaller than this are treated as noise.
+}
+
+void FCapstoneFrameSampler::Reset()
+{
+	LastFrameSeconds = 0;
+	GameThreadSamples.Reset();
+	FrameSamples.Reset();
+	HitchCount = 0;
+	PeakUsedPhysical = 0;
+	PeakUObjectCount = 0;
+	for (int64& PeakBytes : PeakTagBytes)
+		PeakBytes = 0;
+}
+
+void FCapstoneFrameSampler::SampleFrame(float HitchThresholdMs)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (LastFrameSeconds > 0)
+	{
+		const float FrameMs = (Now - LastFrameSeconds) * 1000.0;
+		FrameSamples.Add(FrameMs);
+		if (FrameMs > HitchThresholdMs)
+			HitchCount++;
+	}
+	LastFrameSeconds = Now;
+
+	GameThreadSamples.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	PeakUObjectCount = FMath::Max(PeakUObjectCount, GUObjectArray.GetObjectArrayNumMinusAvailable());
+	if (FCapstoneMemoryTags::IsTracking())
+	{
+		for (int32 Index = 0; Index < (int32)ECapstoneMemoryTag::Count; Index++)
+			PeakTagBytes[Index] = FMath::Max(PeakTagBytes[Index], FCapstoneMemoryTags::GetTagBytes((ECapstoneMemoryTag)Index));
+	}
+
+	CSV_CUSTOM_STAT(Capstone, SceneQueries, FCapstoneFrameCounters::GetLastFrameSceneQueries(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Capstone, ActorSpawns, FCapstoneFrameCounters::GetLastFrameActorSpawns(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Capstone, WidgetCreations, FCapstoneFrameCounters::GetLastFrameWidgetCreations(), ECsvCustomStatOp::Set);
+}
+
+FCapstoneBenchmarkResult FCapstoneFrameSampler::BuildResult(const FString& Name) const
+{
+	FCapstoneBenchmarkResult Result;
+	Result.Name = Name;
+	Result.Frames = GameThreadSamples.Num();
+	Result.AvgGameThreadMs = Average(GameThreadSamples);
+	Result.P99GameThreadMs = Percentile(GameThreadSamples, 0.99f);
+	Result.AvgFrameMs = Average(FrameSamples);
+	Result.P99FrameMs = Percentile(FrameSamples, 0.99f);
+	Result.HitchCount = HitchCount;
+	Result.PeakUsedPhysicalMB = PeakUsedPhysical / (1024.f * 1024.f);
+	Result.PeakUObjectCount = PeakUObjectCount;
+	if (FCapstoneMemoryTags::IsTracking())
+	{
+		for (int32 Index = 0; Index < (int32)ECapstoneMemoryTag::Count; Index++)
+			Result.MemoryTagHighWaterMB.Add(FCapstoneMemoryTags::GetTagName((ECapstoneMemoryTag)Index), PeakTagBytes[Index] / (1024.f * 1024.f));
+	}
+	return Result;
+}
+
+bool FCapstoneFrameSampler::ReportResult(const FCapstoneBenchmarkResult& Result, float RegressionThreshold)
+{
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: %s  frames %d  game thread avg %.2f ms p99 %.2f ms  frame avg %.2f ms p99 %.2f ms  hitches %d  memory peak %.0f MB  UObjects peak %d"),
+		*Result.Name, Result.Frames, Result.AvgGameThreadMs, Result.P99GameThreadMs, Result.AvgFrameMs, Result.P99FrameMs,
+		Result.HitchCount, Result.PeakUsedPhysicalMB, Result.PeakUObjectCount);
+
+	FString Json;
+	FJsonObjectConverter::UStructToJsonObjectString(Result, Json);
+	FFileHelper::SaveStringToFile(Json, *(GetOutputDir() / Result.Name + TEXT(".json")));
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("UpdateBaseline")))
+	{
+		FFileHelper::SaveStringToFile(Json, *GetBaselinePath(Result.Name));
+		UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: baseline for %s updated"), *Result.Name);
+		return true;
+	}
+
+	FString BaselineJson;
+	if (!FFileHelper::LoadFileToString(BaselineJson, *GetBaselinePath(Result.Name)))
+	{
+		UE_LOG(LogCapstonePerformance, Warning, TEXT("Benchmark: no baseline for %s, run with -UpdateBaseline to record one"), *Result.Name);
+		return true;
+	}
+
+	FCapstoneBenchmarkResult Baseline;
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(BaselineJson, &Baseline))
+	{
+		UE_LOG(LogCapstonePerformance, Error, TEXT("Benchmark: baseline for %s could not be read"), *Result.Name);
+		return false;
+	}
+
+	bool bPassed = true;
+	auto CheckMetric = [RegressionThreshold, &bPassed, &Result](const TCHAR* Name, float Current, float Base, float MinRegression)
+	{
+		const bool bRegressed = Current - Base > FMath::Max(Base * RegressionThreshold, MinRegression);
+		if (bRegressed)
+		{
+			UE_LOG(LogCapstonePerformance, Error, TEXT("Benchmark: %s %s regressed %.2f -> %.2f"), *Result.Name, Name, Base, Current);
+		}
+		else
+		{
+			UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: %s %s %.2f (baseline %.2f)"), *Result.Name, Name, Current, Base);
+		}
+		bPassed &= !bRegressed;
+	};
+
+	if (!FCapstoneMemoryTags::IsTracking())
+	{
+		CheckMetric(TEXT("AvgGameThreadMs"), Result.AvgGameThreadMs, Baseline.AvgGameThreadMs, MIN_MS_REGRESSION);
+		CheckMetric(TEXT("P99GameThreadMs"), Result.P99GameThreadMs, Baseline.P99GameThreadMs, MIN_MS_REGRESSION);
+		CheckMetric(TEXT("HitchCount"), Result.HitchCount, Baseline.HitchCount, MIN_HITCH_REGRESSION);
+		CheckMetric(TEXT("PeakUsedPhysicalMB"), Result.PeakUsedPhysicalMB, Baseline.PeakUsedPhysicalMB, MIN_MEMORY_REGRESSION_MB);
+	}
+
+	// Tags are only compared when both runs tracked them.
+	for (const TPair<FString, float>& BaselineTag : Baseline.MemoryTagHighWaterMB)
+	{
+		if (const float* CurrentMB = Result.MemoryTagHighWaterMB.Find(BaselineTag.Key))
+			CheckMetric(*(TEXT("MemoryTag ") + BaselineTag.Key), *CurrentMB, BaselineTag.Value, MIN_TAG_REGRESSION_MB);
+	}
+	return bPassed;
+}
+
+bool UCapstoneBenchmarkSubsystem::IsBenchmarkRun()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("CapstoneBenchmark"));
+}
+
+bool UCapstoneBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return IsBenchmarkRun() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UCapstoneBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FString MapsParam;
+	if (FParse::Value(FCommandLine::Get(), TEXT("BenchmarkMaps="), MapsParam))
+		MapsParam.ParseIntoArray(BenchmarkMaps, TEXT("+"));
+	FParse::Value(FCommandLine::Get(), TEXT("BenchmarkThreshold="), RegressionThreshold);
+
+	// Same simulation step every run so the scripted path plays out identically, the frame times
+	// recorded are still wall clock. A -CapstoneFixedStep rate takes over so each frame stays one step.
+	// Whatever was set before, e.g. by -UseFixedTimeStep, is put back when the benchmark ends.
+	bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	bFixedTimeStepSaved = true;
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(FFixedStepClock::IsFixedStepEnabled() ? FFixedStepClock::GetFixedStepTime() : FIXED_DELTA_TIME);
+
+	if (BenchmarkMaps.Num() == 0)
+	{
+		UE_LOG(LogCapstonePerformance, Error, TEXT("Benchmark: no maps specified"));
+		bAnyFailure = true;
+		Exit();
+	}
+}
+
+void UCapstoneBenchmarkSubsystem::Deinitialize()
+{
+	if (bFixedTimeStepSaved)
+	{
+		FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+		bFixedTimeStepSaved = false;
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId UCapstoneBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCapstoneBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UCapstoneBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World || !World->HasBegunPlay())
+	{
+		return;
+	}
+
+	switch (State)
+	{
+	case EState::WaitingForMap:
+		if (UWorld::RemovePIEPrefix(World->GetMapName()) == FPackageName::GetShortName(BenchmarkMaps[MapIndex]))
+			StartMap(World);
+		else if (!bMapRequested)
+			OpenNextMap();
+		break;
+
+	case EState::WarmingUp:
+		StateTime += DeltaTime;
+		if (StateTime >= WarmupTime)
+		{
+#if CSV_PROFILER
+			FCsvProfiler::Get()->BeginCapture(-1, GetOutputDir(), FPackageName::GetShortName(BenchmarkMaps[MapIndex]) + TEXT(".csv"));
+#endif
+			FrameSampler.Reset();
+			FCapstoneChurnTracker::ResetTotals();
+			FCapstoneInputLatency::Reset();
+			if (UEncounterDirectorSubsystem* Director = World->GetSubsystem<UEncounterDirectorSubsystem>())
+				Director->ResetFrameStats();
+			if (UEnemyPathRequestSubsystem* PathRequests = World->GetSubsystem<UEnemyPathRequestSubsystem>())
+				PathRequests->ResetCostStats();
+			State = EState::Running;
+		}
+		break;
+
+	case EState::Running:
+		FrameSampler.SampleFrame(HitchThresholdMs);
+		DrivePlayer(DeltaTime);
+		if (State == EState::Running && WaypointIndex >= Path.Num() && CurrentAction == ECapstoneBenchmarkAction::None)
+			FinishMap();
+		break;
+
+	case EState::ScalingAI:
+		TickAIScaling(DeltaTime);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UCapstoneBenchmarkSubsystem::StartMap(UWorld* World)
+{
+	bMapRequested = false;
+	PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0));
+	if (!PlayerCharacter.IsValid())
+	{
+		UE_LOG(LogCapstonePerformance, Error, TEXT("Benchmark: %s has no APlayerCharacter"), *BenchmarkMaps[MapIndex]);
+		bAnyFailure = true;
+		MapIndex++;
+		if (MapIndex >= BenchmarkMaps.Num())
+			Exit();
+		return;
+	}
+
+	BuildPath(World);
+	WaypointIndex = 0;
+	SegmentTime = 0;
+	CurrentAction = ECapstoneBenchmarkAction::None;
+
+	StateTime = 0;
+	State = EState::WarmingUp;
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: starting %s with %d path points"), *BenchmarkMaps[MapIndex], Path.Num());
+}
+
+void UCapstoneBenchmarkSubsystem::FinishMap()
+{
+#if CSV_PROFILER
+	FCsvProfiler::Get()->EndCapture();
+#endif
+
+	const FCapstoneBenchmarkResult Result = FrameSampler.BuildResult(FPackageName::GetShortName(BenchmarkMaps[MapIndex]));
+	FFileHelper::SaveStringToFile(FCapstoneInputLatency::BuildCsv(), *(GetOutputDir() / Result.Name + TEXT("_Latency.csv")));
+	if (!FCapstoneFrameSampler::ReportResult(Result, RegressionThreshold))
+		bAnyRegression = true;
+	if (!ReportChurn())
+		bAnyRegression = true;
+	ReportDirector(false);
+
+	// Enemies brought in for the scaling stage would skew the path's results, so it only starts once those are written.
+	if (StartAIScaling())
+		return;
+
+	ReportPathfinding();
+	NextMap();
+}
+
+void UCapstoneBenchmarkSubsystem::NextMap()
+{
+	PlayerCharacter.Reset();
+	State = EState::WaitingForMap;
+	MapIndex++;
+	if (MapIndex >= BenchmarkMaps.Num())
+		Exit();
+	else
+		OpenNextMap();
+}
+
+bool UCapstoneBenchmarkSubsystem::ReportChurn()
+{
+	for (const FCapstoneChurnEntry& Entry : FCapstoneChurnTracker::GetTopClasses(CHURN_REPORT_CLASSES))
+	{
+		UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: %s churn %d spawns, %d destroys, %d widgets since warmup"), *Entry.ClassName.ToString(),
+			Entry.Totals[(int32)ECapstoneChurn::Spawn], Entry.Totals[(int32)ECapstoneChurn::Destroy], Entry.Totals[(int32)ECapstoneChurn::Widget]);
+	}
+
+	bool bChurnFree = true;
+	for (const FSoftClassPath& ClassPath : ChurnFreeClasses)
+	{
+		const UClass* Class = ClassPath.TryLoadClass<UObject>();
+		if (!Class)
+		{
+			UE_LOG(LogCapstonePerformance, Warning, TEXT("Benchmark: churn free class %s not found"), *ClassPath.ToString());
+			continue;
+		}
+
+		const int32 Created = FCapstoneChurnTracker::GetTotal(Class, ECapstoneChurn::Spawn) + FCapstoneChurnTracker::GetTotal(Class, ECapstoneChurn::Widget);
+		if (Created > 0)
+		{
+			UE_LOG(LogCapstonePerformance, Error, TEXT("Benchmark: %s was created %d times after warmup on %s"), *Class->GetName(), Created, *BenchmarkMaps[MapIndex]);
+			bChurnFree = false;
+		}
+	}
+	return bChurnFree;
+}
+
+bool UCapstoneBenchmarkSubsystem::ReportDirector(bool bCheckShare) const
+{
+	const UWorld* World = GetGameInstance()->GetWorld();
+	const UEncounterDirectorSubsystem* Director = World ? World->GetSubsystem<UEncounterDirectorSubsystem>() : nullptr;
+	if (!Director || Director->GetSampledFrames() == 0)
+	{
+		return true;
+	}
+
+	const float WithinTarget = (float)(Director->GetSampledFrames() - Director->GetFramesOverTarget()) / Director->GetSampledFrames();
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: director kept %.1f%% of %d frames within target, lowest budget scale %.2f"),
+		100.f * WithinTarget, Director->GetSampledFrames(), Director->GetLowestBudgetScale());
+
+	if (bCheckShare && WithinTarget < MinDirectorWithinTarget)
+	{
+		UE_LOG(LogCapstonePerformance, Error, TEXT("Benchmark: director kept %.1f%% of the AI scaling frames within target on %s, %.1f%% required"),
+			100.f * WithinTarget, *BenchmarkMaps[MapIndex], 100.f * MinDirectorWithinTarget);
+		return false;
+	}
+	return true;
+}
+
+void UCapstoneBenchmarkSubsystem::ReportPathfinding() const
+{
+	const UWorld* World = GetGameInstance()->GetWorld();
+	const UEnemyPathRequestSubsystem* PathRequests = World ? World->GetSubsystem<UEnemyPathRequestSubsystem>() : nullptr;
+	if (!PathRequests)
+	{
+		return;
+	}
+
+	FString Csv = TEXT("MinEnemies,MaxEnemies,Frames,SearchesPerEnemySecond,GameThreadUsPerEnemyFrame,Requests,Searches\n");
+	for (const FEnemyPathCost& Cost : PathRequests->GetCostByEnemyCount())
+	{
+		if (Cost.EnemyFrames == 0)
+			continue;
+
+		const int32 MaxEnemies = Cost.MinEnemies * 2 - 1;
+		UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: %d-%d enemies for %d frames, %.3f path searches per enemy second, %.2f us game thread per enemy frame, %d of %d requests shared"),
+			Cost.MinEnemies, MaxEnemies, Cost.Frames, Cost.GetSearchesPerEnemySecond(), Cost.GetGameThreadUsPerEnemyFrame(), FMath::Max(0, Cost.Requests - Cost.Searches), Cost.Requests);
+		Csv += FString::Printf(TEXT("%d,%d,%d,%.4f,%.4f,%d,%d\n"), Cost.MinEnemies, MaxEnemies, Cost.Frames,
+			Cost.GetSearchesPerEnemySecond(), Cost.GetGameThreadUsPerEnemyFrame(), Cost.Requests, Cost.Searches);
+	}
+	FFileHelper::SaveStringToFile(Csv, *(GetOutputDir() / FPackageName::GetShortName(BenchmarkMaps[MapIndex]) + TEXT("_Pathfinding.csv")));
+}
+
+void UCapstoneBenchmarkSubsystem::OpenNextMap()
+{
+	bMapRequested = true;
+	UGameplayStatics::OpenLevel(GetGameInstance(), FName(BenchmarkMaps[MapIndex]));
+}
+
+void UCapstoneBenchmarkSubsystem::Exit()
+{
+	State = EState::Finished;
+
+	const uint8 ExitCode = bAnyFailure ? 2 : (bAnyRegression ? 1 : 0);
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: finished with exit code %d"), ExitCode);
+	FPlatformMisc::RequestExitWithStatus(false, ExitCode);
+}
+
+void UCapstoneBenchmarkSubsystem::BuildPath(UWorld* World)
+{
+	Path.Reset();
+
+	TArray<AActor*> PathActors;
+	for (TActorIterator<ATargetPoint> It(World); It; ++It)
+	{
+		if (It->ActorHasTag(BENCHMARK_TAG))
+			PathActors.Add(*It);
+	}
+
+	// No authored path, visit the level's gameplay actors instead.
+	const bool bAuthoredPath = PathActors.Num() > 0;
+	if (!bAuthoredPath)
+	{
+		for (TActorIterator<ABasePickup> It(World); It; ++It)
+			PathActors.Add(*It);
+		for (TActorIterator<ACheckpointVolume> It(World); It; ++It)
+			PathActors.Add(*It);
+		for (TActorIterator<ABaseEnemy> It(World); It; ++It)
+			PathActors.Add(*It);
+	}
+
+	// Level actor names are stable, sorting by them keeps the path the same between runs.
+	PathActors.Sort([](const AActor& A, const AActor& B) { return A.GetName() < B.GetName(); });
+
+	const UEnum* ActionEnum = StaticEnum<ECapstoneBenchmarkAction>();
+	for (int32 Index = 0; Index < PathActors.Num(); Index++)
+	{
+		FCapstoneBenchmarkWaypoint& Waypoint = Path.AddDefaulted_GetRef();
+		Waypoint.Location = PathActors[Index]->GetActorLocation();
+
+		if (!bAuthoredPath)
+		{
+			Waypoint.Action = ACTION_CYCLE[Index % UE_ARRAY_COUNT(ACTION_CYCLE)];
+			continue;
+		}
+
+		for (const FName& Tag : PathActors[Index]->Tags)
+		{
+			const int64 Value = ActionEnum->GetValueByNameString(Tag.ToString());
+			if (Value != INDEX_NONE)
+				Waypoint.Action = (ECapstoneBenchmarkAction)Value;
+		}
+	}
+}
+
+void UCapstoneBenchmarkSubsystem::DrivePlayer(float DeltaTime)
+{
+	APlayerCharacter* Player = PlayerCharacter.Get();
+	if (!Player || !Player->GetController())
+	{
+		UE_LOG(LogCapstonePerformance, Error, TEXT("Benchmark: lost the player on %s"), *BenchmarkMaps[MapIndex]);
+		bAnyFailure = true;
+		FinishMap();
+		return;
+	}
+
+	if (CurrentAction != ECapstoneBenchmarkAction::None)
+	{
+		TickAction();
+		return;
+	}
+
+	if (WaypointIndex >= Path.Num())
+	{
+		return;
+	}
+
+	const FCapstoneBenchmarkWaypoint& Waypoint = Path[WaypointIndex];
+	const FVector ToWaypoint = Waypoint.Location - Player->GetActorLocation();
+	SegmentTime += DeltaTime;
+
+	const bool bTimedOut = SegmentTime >= SEGMENT_TIMEOUT;
+	if (ToWaypoint.Size2D() <= WAYPOINT_RADIUS || bTimedOut)
+	{
+		if (bTimedOut)
+			Player->TeleportTo(Waypoint.Location, Player->GetActorRotation());
+		SegmentTime = 0;
+		WaypointIndex++;
+		StartAction(Waypoint.Action);
+		return;
+	}
+
+	Player->GetController()->SetControlRotation(FRotator(0, ToWaypoint.Rotation().Yaw, 0));
+	FCapstoneInputDriver::Inject(Player, ECapstoneInput::Move, FInputActionValue(FVector2D(0, 1)));
+}
+
+void UCapstoneBenchmarkSubsystem::StartAction(ECapstoneBenchmarkAction Action)
+{
+	CurrentAction = Action;
+	ActionFrame = 0;
+}
+
+void UCapstoneBenchmarkSubsystem::TickAction()
+{
+	APlayerCharacter* Player = PlayerCharacter.Get();
+
+	switch (CurrentAction)
+	{
+	case ECapstoneBenchmarkAction::FireWeapon1:
+	case ECapstoneBenchmarkAction::FireWeapon2:
+		{
+			AWeaponBase* Weapon = CurrentAction == ECapstoneBenchmarkAction::FireWeapon1 ? Player->GetWeapon1() : Player->GetWeapon2();
+			if (!Weapon)
+				break;
+			// Switching happens on release, so press on the first frame and start firing on the third.
+			if (ActionFrame == 0 && Player->GetActiveWeapon() != Weapon)
+				FCapstoneInputDriver::Inject(Player, ECapstoneInput::SwitchWeapon, FInputActionValue(true));
+			else if (ActionFrame >= 2)
+				FCapstoneInputDriver::Inject(Player, ECapstoneInput::Attack, FInputActionValue(true));
+		}
+		break;
+
+	case ECapstoneBenchmarkAction::Grapple:
+		if (ActionFrame == 0)
+		{
+			// Aim above the next path point so the grapple has something to pull towards.
+			const FVector Target = Path.IsValidIndex(WaypointIndex) ? Path[WaypointIndex].Location : Player->GetActorLocation() + Player->GetActorForwardVector() * 1000.f;
+			Player->GetController()->SetControlRotation((Target + FVector(0, 0, 300.f) - Player->GetActorLocation()).Rotation());
+		}
+		else
+		{
+			FCapstoneInputDriver::Inject(Player, ECapstoneInput::Grapple, FInputActionValue(true));
+		}
+		if (ActionFrame == ACTION_FRAMES - 1)
+			Player->GetGrappleComponent()->CancelGrapple(false);
+		break;
+
+	case ECapstoneBenchmarkAction::Dash:
+		// Dash is a double tap of the same direction.
+		if (ActionFrame == 0 || ActionFrame == 3)
+			FCapstoneInputDriver::Inject(Player, ECapstoneInput::Dash, FInputActionValue(FVector2D(0, 1)));
+		break;
+
+	case ECapstoneBenchmarkAction::Mantle:
+		// Mantling needs the player to be moving when jump is pressed.
+		FCapstoneInputDriver::Inject(Player, ECapstoneInput::Move, FInputActionValue(FVector2D(0, 1)));
+		if (ActionFrame == 5)
+			FCapstoneInputDriver::Inject(Player, ECapstoneInput::Jump, FInputActionValue(true));
+		break;
+
+	default:
+		break;
+	}
+
+	ActionFrame++;
+	if (ActionFrame >= ACTION_FRAMES)
+		CurrentAction = ECapstoneBenchmarkAction::None;
+}
+
+bool UCapstoneBenchmarkSubsystem::StartAIScaling()
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	UEnemyPoolSubsystem* Pool = World ? World->GetSubsystem<UEnemyPoolSubsystem>() : nullptr;
+	const TSubclassOf<ABaseEnemy> EnemyClass = AIScalingEnemyClass.LoadSynchronous();
+	if (AIScalingEnemyCounts.Num() == 0 || !EnemyClass || !Pool || !PlayerCharacter.IsValid())
+	{
+		return false;
+	}
+
+	// Paths only come from the shared path requests with the native controller, without it the CSV shows the
+	// engine's own path finding.
+	const UClass* ControllerClass = EnemyClass->GetDefaultObject<ABaseEnemy>()->AIControllerClass;
+	if (!ControllerClass || !ControllerClass->IsChildOf<AEnemyAIController>())
+	{
+		UE_LOG(LogCapstonePerformance, Warning, TEXT("Benchmark: %s is controlled by %s, which doesn't derive from AEnemyAIController, so its moves bypass the shared path requests"),
+			*EnemyClass->GetName(), *GetNameSafe(ControllerClass));
+	}
+
+	// Enemies keep attacking the player standing among them, who must live through every step.
+	PlayerCharacter->SetCanBeDamaged(false);
+
+	// Everything is spawned up front, the steps only take enemies out of the pool.
+	Pool->Prewarm(EnemyClass, FMath::Max(AIScalingEnemyCounts));
+	if (UEnemyPathRequestSubsystem* PathRequests = World->GetSubsystem<UEnemyPathRequestSubsystem>())
+		PathRequests->ResetCostStats();
+	if (UEncounterDirectorSubsystem* Director = World->GetSubsystem<UEncounterDirectorSubsystem>())
+		Director->ResetFrameStats();
+
+	ScalingStep = 0;
+	ScalingEnemyCount = 0;
+	StateTime = 0;
+	State = EState::ScalingAI;
+	SpawnScalingEnemies();
+	return true;
+}
+
+void UCapstoneBenchmarkSubsystem::TickAIScaling(float DeltaTime)
+{
+	StateTime += DeltaTime;
+	if (StateTime < AIScalingStepTime)
+	{
+		return;
+	}
+
+	StateTime = 0;
+	ScalingStep++;
+	if (ScalingStep < AIScalingEnemyCounts.Num())
+	{
+		SpawnScalingEnemies();
+		return;
+	}
+
+	if (!ReportDirector(true))
+		bAnyRegression = true;
+	ReportPathfinding();
+	NextMap();
+}
+
+void UCapstoneBenchmarkSubsystem::SpawnScalingEnemies()
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	UEnemyPoolSubsystem* Pool = World ? World->GetSubsystem<UEnemyPoolSubsystem>() : nullptr;
+	const APlayerCharacter* Player = PlayerCharacter.Get();
+	if (!Pool || !Player)
+	{
+		return;
+	}
+
+	// A sunflower spiral around the player, so enemies come at it from every side and ever denser.
+	const int32 Count = AIScalingEnemyCounts[ScalingStep];
+	for (; ScalingEnemyCount < Count; ScalingEnemyCount++)
+	{
+		const float Angle = ScalingEnemyCount * PI * (3.f - FMath::Sqrt(5.f));
+		const FVector Offset = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * (AI_SCALING_MIN_RADIUS + AI_SCALING_SPACING * FMath::Sqrt((float)ScalingEnemyCount));
+		Pool->Acquire(AIScalingEnemyClass.Get(), FTransform((-Offset).Rotation(), Player->GetActorLocation() + Offset));
+	}
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Benchmark: scaling AI with %d enemies on %s"), ScalingEnemyCount, *BenchmarkMaps[MapIndex]);
+}
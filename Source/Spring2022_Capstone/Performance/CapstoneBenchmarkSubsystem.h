@@ -0,0 +1,249 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "CapstoneMemoryTags.h"
+#include "CapstoneBenchmarkSubsystem.generated.h"
+
+class ABaseEnemy;
+class APlayerCharacter;
+
+UENUM()
+enum class ECapstoneBenchmarkAction : uint8
+{
+	None,
+	FireWeapon1,
+	FireWeapon2,
+	Grapple,
+	Dash,
+	Mantle
+};
+
+/**
+ * Point on the scripted benchmark path and the action performed on arriving there.
+ */
+USTRUCT()
+struct FCapstoneBenchmarkWaypoint
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+	UPROPERTY()
+	ECapstoneBenchmarkAction Action = ECapstoneBenchmarkAction::None;
+};
+
+/**
+ * Numbers recorded for one benchmark map or replay, also the layout of the stored baseline files.
+ */
+USTRUCT()
+struct FCapstoneBenchmarkResult
+{
+	GENERATED_BODY()
+
+	// Map or replay name, also the name of the result and baseline files.
+	UPROPERTY()
+	FString Name;
+	UPROPERTY()
+	int32 Frames = 0;
+
+	UPROPERTY()
+	float AvgGameThreadMs = 0;
+	UPROPERTY()
+	float P99GameThreadMs = 0;
+	UPROPERTY()
+	float AvgFrameMs = 0;
+	UPROPERTY()
+	float P99FrameMs = 0;
+	UPROPERTY()
+	int32 HitchCount = 0;
+
+	UPROPERTY()
+	float PeakUsedPhysicalMB = 0;
+	UPROPERTY()
+	int32 PeakUObjectCount = 0;
+
+	// High-water mark of each Capstone memory tag, empty unless the run used -LLM.
+	UPROPERTY()
+	TMap<FString, float> MemoryTagHighWaterMB;
+};
+
+/**
+ * @brief Collects frame time, game thread time and memory numbers once per frame for benchmark style runs.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneFrameSampler
+{
+	void Reset();
+	void SampleFrame(float HitchThresholdMs);
+	FCapstoneBenchmarkResult BuildResult(const FString& Name) const;
+
+	/**
+	 * @brief Saves Result to Saved/Benchmark and compares it with Benchmark/Baselines/<Name>.json.
+	 * With -UpdateBaseline the baseline is replaced instead.
+	 * @return false - a metric regressed past RegressionThreshold or the baseline could not be read.
+	 */
+	static bool ReportResult(const FCapstoneBenchmarkResult& Result, float RegressionThreshold);
+
+private:
+	double LastFrameSeconds = 0;
+	TArray<float> GameThreadSamples;
+	TArray<float> FrameSamples;
+	int32 HitchCount = 0;
+	uint64 PeakUsedPhysical = 0;
+	int32 PeakUObjectCount = 0;
+	int64 PeakTagBytes[(int32)ECapstoneMemoryTag::Count] = {};
+};
+
+/**
+ * Headless performance benchmark. Only created when the game is launched with -CapstoneBenchmark.
+ *
+ * Loads each map in BenchmarkMaps, walks the player along a fixed path while firing both weapons,
+ * grappling, dashing and mantling at set points, then writes the results and a CSV profile to
+ * Saved/Benchmark and compares them with Benchmark/Baselines/<Map>.json. The input latency histograms of the
+ * actions are written to Saved/Benchmark/<Map>_Latency.csv. Classes listed in ChurnFreeClasses
+ * must not be spawned or created after the warmup. The share of frames the encounter director kept within the
+ * target frame time is logged, its load and budget are in the CSV profile.
+ * With AIScalingEnemyCounts set, the path is followed by an AI scaling stage: the player stands still and can't be
+ * damaged while pooled enemies are brought in around them, each count held for AIScalingStepTime seconds. Their
+ * moves share paths through UEnemyPathRequestSubsystem when their controller derives from AEnemyAIController, a
+ * warning is logged otherwise. The path finding cost per enemy for each range of enemy counts is logged and
+ * written to Saved/Benchmark/<Map>_Pathfinding.csv. The benchmark maps have no wave spawner, so the director is
+ * only under load here, and the run fails like a regression when it kept less than MinDirectorWithinTarget of the
+ * stage's frames within target.
+ * Run with -LLM it is a memory tag pass instead: outputs go to Saved/Benchmark/MemoryTags and only the tag
+ * high-water marks are compared, against <Map>_MemoryTags.json, since LLM slows every allocation.
+ * The process exits with 0 on success, 1 when a metric regressed past RegressionThreshold and
+ * 2 when a map could not be run.
+ *
+ * Example: Spring2022_Capstone Level -game -nullrhi -unattended -CapstoneBenchmark [-UpdateBaseline]
+ *
+ * Path points come from ATargetPoint actors tagged "Benchmark" (sorted by name, an optional second tag
+ * names the action), or from the level's pickups, checkpoints and enemies when none are placed.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UCapstoneBenchmarkSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !IsTemplate() && State != EState::Finished; }
+
+	static bool IsBenchmarkRun();
+
+private:
+	enum class EState : uint8 { WaitingForMap, WarmingUp, Running, ScalingAI, Finished };
+
+	void StartMap(UWorld* World);
+	void FinishMap();
+	/**
+	 * @brief Logs the classes that churned the most since the warmup and checks ChurnFreeClasses.
+	 * @return false - a churn free class was spawned or created.
+	 */
+	bool ReportChurn();
+	/**
+	 * @brief Logs how many frames the encounter director kept within the target frame time since the warmup or
+	 * scaling start.
+	 * @param bCheckShare Whether the share is checked against MinDirectorWithinTarget.
+	 * @return false - the share was checked and fell short.
+	 */
+	bool ReportDirector(bool bCheckShare) const;
+	// Logs and saves the path finding cost per enemy for each range of enemy counts since the warmup or scaling start.
+	void ReportPathfinding() const;
+	void NextMap();
+	void OpenNextMap();
+	void Exit();
+
+	void BuildPath(UWorld* World);
+	void DrivePlayer(float DeltaTime);
+	void StartAction(ECapstoneBenchmarkAction Action);
+	void TickAction();
+
+	/**
+	 * @brief Starts the AI scaling stage when AIScalingEnemyCounts and AIScalingEnemyClass are set.
+	 * @return false - the stage was skipped.
+	 */
+	bool StartAIScaling();
+	void TickAIScaling(float DeltaTime);
+	void SpawnScalingEnemies();
+
+	// Maps to benchmark in order, overridable with -BenchmarkMaps=Level+Dev_Map.
+	UPROPERTY(Config)
+	TArray<FString> BenchmarkMaps;
+
+	// Fraction a metric may grow over the baseline before the run fails, overridable with -BenchmarkThreshold=.
+	UPROPERTY(Config)
+	float RegressionThreshold = 0.1f;
+
+	// Seconds the map runs untouched before recording, lets streaming and first spawns settle.
+	UPROPERTY(Config)
+	float WarmupTime = 3.f;
+
+	// Frames longer than this count as hitches.
+	UPROPERTY(Config)
+	float HitchThresholdMs = 50.f;
+
+	// Classes that must not be spawned or created once the warmup is over, e.g. pooled actors. Spawning one fails the run like a regression.
+	UPROPERTY(Config)
+	TArray<FSoftClassPath> ChurnFreeClasses;
+
+	// Enemy counts the AI scaling stage goes through in ascending order, e.g. 8, 16, 32, 64. Empty skips the stage.
+	UPROPERTY(Config)
+	TArray<int32> AIScalingEnemyCounts;
+
+	UPROPERTY(Config)
+	TSoftClassPtr<ABaseEnemy> AIScalingEnemyClass;
+
+	// Seconds each enemy count is held.
+	UPROPERTY(Config)
+	float AIScalingStepTime = 10.f;
+
+	// Share of the AI scaling stage's frames the encounter director has to keep within the target frame time.
+	UPROPERTY(Config)
+	float MinDirectorWithinTarget = 0.95f;
+
+	EState State = EState::WaitingForMap;
+	int32 MapIndex = 0;
+	float StateTime = 0;
+	bool bMapRequested = false;
+	bool bAnyRegression = false;
+	bool bAnyFailure = false;
+
+	// Fixed time step settings from before the benchmark changed them.
+	bool bFixedTimeStepSaved = false;
+	bool bPreviousUseFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0;
+
+	UPROPERTY()
+	TWeakObjectPtr<APlayerCharacter> PlayerCharacter;
+
+	TArray<FCapstoneBenchmarkWaypoint> Path;
+	int32 WaypointIndex = 0;
+	float SegmentTime = 0;
+
+	ECapstoneBenchmarkAction CurrentAction = ECapstoneBenchmarkAction::None;
+	int32 ActionFrame = 0;
+
+	int32 ScalingStep = 0;
+	int32 ScalingEnemyCount = 0;
+
+	FCapstoneFrameSampler FrameSampler;
+
+/// Const Variables ///
+	const float FIXED_DELTA_TIME = 1.f / 60.f;		// Simulation step while benchmarking, keeps the path identical between runs.
+	const float WAYPOINT_RADIUS = 150.f;			// Distance at which a waypoint counts as reached.
+	const float SEGMENT_TIMEOUT = 6.f;				// Seconds before a blocked player is teleported to the next waypoint.
+	const int32 ACTION_FRAMES = 30;					// Frames each waypoint action is held for.
+	const int32 CHURN_REPORT_CLASSES = 5;			// Classes with the most churn logged after each map.
+	const float AI_SCALING_MIN_RADIUS = 1500.f;		// Distance from the player of the closest scaling enemy.
+	const float AI_SCALING_SPACING = 150.f;			// Spacing of the spiral scaling enemies are placed on.
+};
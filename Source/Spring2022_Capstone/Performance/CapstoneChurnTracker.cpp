@@ -0,0 +1,197 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneChurnTracker.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "UObject/UObjectArray.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+
+namespace
+{
+	const int32 LOGGED_CLASSES = 10;		// Classes listed by Capstone.Churn.
+
+	FAutoConsoleCommand ChurnCommand(
+		TEXT("Capstone.Churn"),
+		TEXT("Logs the classes with the most actor spawns, destroys and widget creations over the last minute."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			const TArray<FCapstoneChurnEntry> TopClasses = FCapstoneChurnTracker::GetTopClasses(LOGGED_CLASSES);
+			UE_LOG(LogCapstonePerformance, Display, TEXT("Churn per minute, %d classes:"), TopClasses.Num());
+			for (const FCapstoneChurnEntry& Entry : TopClasses)
+			{
+				UE_LOG(LogCapstonePerformance, Display, TEXT("  %s: %d spawns, %d destroys, %d widgets"), *Entry.ClassName.ToString(),
+					Entry.PerMinute[(int32)ECapstoneChurn::Spawn], Entry.PerMinute[(int32)ECapstoneChurn::Destroy], Entry.PerMinute[(int32)ECapstoneChurn::Widget]);
+			}
+		}));
+}
+
+TMap<FName, FCapstoneChurnTracker::FClassCounts> FCapstoneChurnTracker::Classes;
+int32 FCapstoneChurnTracker::CurrentBucket = 0;
+double FCapstoneChurnTracker::CurrentBucketStartTime = 0;
+
+int32 FCapstoneChurnEntry::GetPerMinuteSum() const
+{
+	int32 Sum = 0;
+	for (const int32 Count : PerMinute)
+		Sum += Count;
+	return Sum;
+}
+
+/**
+ * Counts actor spawns and destroys through the world delegates and widget creations as they are constructed.
+ */
+class FCapstoneChurnListener : public FUObjectArray::FUObjectCreateListener
+{
+public:
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+	{
+		// Templates are created when Blueprints load, they aren't churn.
+		if (IsInGameThread() && !(Object->GetFlags() & (RF_ClassDefaultObject | RF_ArchetypeObject)) && Object->GetClass()->IsChildOf(UUserWidget::StaticClass()))
+			FCapstoneChurnTracker::Add(Object->GetClass(), ECapstoneChurn::Widget);
+	}
+
+	virtual void OnUObjectArrayShutdown() override
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+	}
+
+	void OnWorldInitialized(UWorld* World, const UWorld::InitializationValues)
+	{
+		World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FCapstoneChurnListener::OnActorSpawned));
+		World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FCapstoneChurnListener::OnActorDestroyed));
+	}
+
+	void OnActorSpawned(AActor* Actor)
+	{
+		FCapstoneChurnTracker::Add(Actor->GetClass(), ECapstoneChurn::Spawn);
+	}
+
+	void OnActorDestroyed(AActor* Actor)
+	{
+		FCapstoneChurnTracker::Add(Actor->GetClass(), ECapstoneChurn::Destroy);
+	}
+
+	FDelegateHandle WorldInitializedHandle;
+};
+
+static FCapstoneChurnListener GCapstoneChurnListener;
+
+void FCapstoneChurnTracker::Startup()
+{
+	GUObjectArray.AddUObjectCreateListener(&GCapstoneChurnListener);
+	GCapstoneChurnListener.WorldInitializedHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(&GCapstoneChurnListener, &FCapstoneChurnListener::OnWorldInitialized);
+}
+
+void FCapstoneChurnTracker::Shutdown()
+{
+	FWorldDelegates::OnPostWorldInitialization.Remove(GCapstoneChurnListener.WorldInitializedHandle);
+	GUObjectArray.RemoveUObjectCreateListener(&GCapstoneChurnListener);
+	Classes.Empty();
+}
+
+void FCapstoneChurnTracker::EndFrame()
+{
+	const double Now = FApp::GetCurrentTime();
+	if (Now - CurrentBucketStartTime < 1.0)
+	{
+		return;
+	}
+
+	// Clear every bucket the window moved over, all of them after a long pause.
+	const int32 ElapsedBuckets = (int32)(Now - CurrentBucketStartTime);
+	for (int32 Step = 0; Step < FMath::Min(ElapsedBuckets, WINDOW_SECONDS); Step++)
+	{
+		CurrentBucket = (CurrentBucket + 1) % WINDOW_SECONDS;
+		for (TPair<FName, FClassCounts>& Entry : Classes)
+		{
+			for (int32& Count : Entry.Value.Buckets[CurrentBucket])
+				Count = 0;
+		}
+	}
+	CurrentBucketStartTime = ElapsedBuckets < WINDOW_SECONDS ? CurrentBucketStartTime + ElapsedBuckets : Now;
+}
+
+void FCapstoneChurnTracker::Add(const UClass* Class, ECapstoneChurn Churn)
+{
+	if (!IsInGameThread())
+	{
+		return;
+	}
+
+	FClassCounts& Counts = Classes.FindOrAdd(Class->GetFName());
+	Counts.Class = Class;
+	Counts.Buckets[CurrentBucket][(int32)Churn]++;
+	Counts.Totals[(int32)Churn]++;
+}
+
+int32 FCapstoneChurnTracker::GetPerMinute(const UClass* Class, ECapstoneChurn Churn)
+{
+	int32 Sum = 0;
+	for (const TPair<FName, FClassCounts>& Entry : Classes)
+	{
+		const UClass* EntryClass = Entry.Value.Class.Get();
+		if (!EntryClass || !EntryClass->IsChildOf(Class))
+			continue;
+
+		for (int32 Bucket = 0; Bucket < WINDOW_SECONDS; Bucket++)
+			Sum += Entry.Value.Buckets[Bucket][(int32)Churn];
+	}
+	return Sum;
+}
+
+int32 FCapstoneChurnTracker::GetTotal(const UClass* Class, ECapstoneChurn Churn)
+{
+	int32 Sum = 0;
+	for (const TPair<FName, FClassCounts>& Entry : Classes)
+	{
+		const UClass* EntryClass = Entry.Value.Class.Get();
+		if (EntryClass && EntryClass->IsChildOf(Class))
+			Sum += Entry.Value.Totals[(int32)Churn];
+	}
+	return Sum;
+}
+
+void FCapstoneChurnTracker::ResetTotals()
+{
+	for (TPair<FName, FClassCounts>& Entry : Classes)
+	{
+		for (int32& Count : Entry.Value.Totals)
+			Count = 0;
+	}
+}
+
+TArray<FCapstoneChurnEntry> FCapstoneChurnTracker::GetTopClasses(int32 MaxCount)
+{
+	TArray<FCapstoneChurnEntry> TopClasses;
+	for (const TPair<FName, FClassCounts>& Entry : Classes)
+	{
+		FCapstoneChurnEntry Churn;
+		Churn.ClassName = Entry.Key;
+		for (int32 Kind = 0; Kind < (int32)ECapstoneChurn::Count; Kind++)
+		{
+			for (int32 Bucket = 0; Bucket < WINDOW_SECONDS; Bucket++)
+				Churn.PerMinute[Kind] += Entry.Value.Buckets[Bucket][Kind];
+			Churn.Totals[Kind] = Entry.Value.Totals[Kind];
+		}
+
+		if (Churn.GetPerMinuteSum() > 0)
+			TopClasses.Add(Churn);
+	}
+
+	TopClasses.Sort([](const FCapstoneChurnEntry& A, const FCapstoneChurnEntry& B) { return A.GetPerMinuteSum() > B.GetPerMinuteSum(); });
+	if (TopClasses.Num() > MaxCount)
+		TopClasses.SetNum(MaxCount);
+	return TopClasses;
+}
+
+const TCHAR* FCapstoneChurnTracker::GetChurnName(ECapstoneChurn Churn)
+{
+	switch (Churn)
+	{
+	case ECapstoneChurn::Spawn:		return TEXT("Spawn");
+	case ECapstoneChurn::Destroy:	return TEXT("Destroy");
+	case ECapstoneChurn::Widget:	return TEXT("Widget");
+	default:						return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,86 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+// Kinds of object churn counted by FCapstoneChurnTracker.
+enum class ECapstoneChurn : uint8
+{
+	Spawn,
+	Destroy,
+	Widget,
+	Count
+};
+
+/**
+ * Churn of one class, as returned by FCapstoneChurnTracker::GetTopClasses().
+ */
+struct FCapstoneChurnEntry
+{
+	FName ClassName;
+	int32 PerMinute[(int32)ECapstoneChurn::Count] = {};
+	int32 Totals[(int32)ECapstoneChurn::Count] = {};
+
+	int32 GetPerMinuteSum() const;
+};
+
+/**
+ * Counts actor spawns, actor destroys and widget creations per class, over the last minute and since ResetTotals().
+ *
+ * Spawns and destroys are hooked through the world delegates and widget creations through the UObject create
+ * listener, so everything is counted, including Blueprint spawns and CreateWidget calls. The minute is measured in
+ * FApp time, so fixed step benchmark and replay runs count the same minute every time.
+ *
+ * The overlay shows the top classes, Capstone.Churn logs them. Automated runs call ResetTotals() after their warmup and
+ * check GetTotal() afterwards, e.g. that no ABaseEnemy is spawned once the enemy pool is warm.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneChurnTracker
+{
+	// Hooks the engine delegates. Called from module startup/shutdown.
+	static void Startup();
+	static void Shutdown();
+
+	// Moves the per minute window along. Called from FCoreDelegates::OnEndFrame.
+	static void EndFrame();
+
+	/**
+	 * @brief Count of Churn for Class and its subclasses over the last minute.
+	 */
+	static int32 GetPerMinute(const UClass* Class, ECapstoneChurn Churn);
+
+	/**
+	 * @brief Count of Churn for Class and its subclasses since the last ResetTotals().
+	 */
+	static int32 GetTotal(const UClass* Class, ECapstoneChurn Churn);
+
+	// Clears the totals, the per minute counts are kept.
+	static void ResetTotals();
+
+	/**
+	 * @brief Classes with the most churn over the last minute, most first. Classes without any are left out.
+	 */
+	static TArray<FCapstoneChurnEntry> GetTopClasses(int32 MaxCount);
+
+	static const TCHAR* GetChurnName(ECapstoneChurn Churn);
+
+private:
+	friend class FCapstoneChurnListener;
+
+	// Game thread only.
+	static void Add(const UClass* Class, ECapstoneChurn Churn);
+
+	static const int32 WINDOW_SECONDS = 60;	// Length of the per minute window, one bucket per second.
+
+	struct FClassCounts
+	{
+		TWeakObjectPtr<const UClass> Class;
+		int32 Buckets[WINDOW_SECONDS][(int32)ECapstoneChurn::Count] = {};
+		int32 Totals[(int32)ECapstoneChurn::Count] = {};
+	};
+
+	static TMap<FName, FClassCounts> Classes;
+	static int32 CurrentBucket;
+	static double CurrentBucketStartTime;
+};
@@ -0,0 +1,50 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneGameUserSettings.h"
+#include "HAL/IConsoleManager.h"
+
+UCapstoneGameUserSettings* UCapstoneGameUserSettings::GetCapstoneGameUserSettings()
+{
+	return Cast<UCapstoneGameUserSettings>(UGameUserSettings::GetGameUserSettings());
+}
+
+void UCapstoneGameUserSettings::SetToDefaults()
+{
+	Super::SetToDefaults();
+
+	TargetFrameRate = 60.f;
+	bAdaptivePerformance = true;
+	MinScreenPercentage = 50.f;
+}
+
+void UCapstoneGameUserSettings::ApplyNonResolutionSettings()
+{
+	Super::ApplyNonResolutionSettings();
+
+	// With VSync on, a frame rate limit that divides the refresh rate is paced by presenting every Nth
+	// vblank instead of sleeping, which keeps frame delivery even. Anything else uses the engine limiter.
+	static IConsoleVariable* SyncIntervalCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("rhi.SyncInterval"));
+	if (!SyncIntervalCVar)
+		return;
+
+	int32 SyncInterval = 1;
+	const int32 RefreshRate = FPlatformMisc::GetMaxRefreshRate();
+	if (IsVSyncEnabled() && FrameRateLimit > 0 && RefreshRate > 0)
+	{
+		const float Interval = RefreshRate / FrameRateLimit;
+		if (FMath::IsNearlyEqual(Interval, FMath::RoundToFloat(Interval), 0.05f))
+			SyncInterval = FMath::Max(1, FMath::RoundToInt(Interval));
+	}
+	SyncIntervalCVar->Set(SyncInterval, ECVF_SetByGameSetting);
+}
+
+void UCapstoneGameUserSettings::SetTargetFrameRate(float NewTargetFrameRate)
+{
+	TargetFrameRate = FMath::Clamp(NewTargetFrameRate, 20.f, 360.f);
+}
+
+void UCapstoneGameUserSettings::SetAdaptivePerformanceEnabled(bool bEnable)
+{
+	bAdaptivePerformance = bEnable;
+}
@@ -0,0 +1,55 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameUserSettings.h"
+#include "CapstoneGameUserSettings.generated.h"
+
+/**
+ * Game user settings with the frame pacing options used by UPerformanceGovernorSubsystem.
+ * @note Set as GameUserSettingsClassName in DefaultEngine.ini.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UCapstoneGameUserSettings : public UGameUserSettings
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Settings")
+	static UCapstoneGameUserSettings* GetCapstoneGameUserSettings();
+
+	virtual void SetToDefaults() override;
+	virtual void ApplyNonResolutionSettings() override;
+
+	/**
+	 * @brief Frame rate the performance governor aims for by scaling resolution and quality.
+	 * @param NewTargetFrameRate Frames per second, clamped to 20 - 360.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Settings")
+	void SetTargetFrameRate(float NewTargetFrameRate);
+	UFUNCTION(BlueprintPure, Category = "Settings")
+	float GetTargetFrameRate() const { return TargetFrameRate; }
+	UFUNCTION(BlueprintPure, Category = "Settings")
+	float GetTargetFrameTimeMs() const { return 1000.f / TargetFrameRate; }
+
+	// If true: the performance governor adjusts resolution and quality at runtime.
+	UFUNCTION(BlueprintCallable, Category = "Settings")
+	void SetAdaptivePerformanceEnabled(bool bEnable);
+	UFUNCTION(BlueprintPure, Category = "Settings")
+	bool IsAdaptivePerformanceEnabled() const { return bAdaptivePerformance; }
+
+	// Lowest screen percentage the performance governor may drop to.
+	UFUNCTION(BlueprintPure, Category = "Settings")
+	float GetMinScreenPercentage() const { return MinScreenPercentage; }
+
+protected:
+	UPROPERTY(Config)
+	float TargetFrameRate = 60.f;
+
+	UPROPERTY(Config)
+	bool bAdaptivePerformance = true;
+
+	UPROPERTY(Config)
+	float MinScreenPercentage = 50.f;
+};
@@ -0,0 +1,231 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneHitchDetector.h"
+#include "Async/Async.h"
+#include "CapstoneStats.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "UObject/UObjectGlobals.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarHitchBudgetMs(
+		TEXT("Capstone.HitchBudgetMs"),
+		50.f,
+		TEXT("Game thread frames longer than this are reported to Saved/Logs/CapstoneHitches.log, 0 turns the hitch detector off."),
+		ECVF_Default);
+
+	const int64 MAX_LOG_BYTES = 1024 * 1024;		// Size at which the hitch log rolls over to the backup file.
+
+	FString GetLogPath()
+	{
+		return FPaths::ProjectLogDir() / TEXT("CapstoneHitches.log");
+	}
+
+	uint64 MillisecondsToCycles(double Milliseconds)
+	{
+		return (uint64)(Milliseconds / 1000.0 / FPlatformTime::GetSecondsPerCycle64());
+	}
+}
+
+TArray<FCapstoneHitchDetector::FOperation> FCapstoneHitchDetector::CurrentFrameOperations;
+double FCapstoneHitchDetector::LastEndFrameTime = 0;
+double FCapstoneHitchDetector::LastFlushAsyncLoadingTime = 0;
+int32 FCapstoneHitchDetector::HitchCount = 0;
+TFuture<void> FCapstoneHitchDetector::ReportWriteTask;
+
+/**
+ * Times engine work that has begin and end notifications: actor spawns, blocking loads and garbage collection.
+ */
+class FCapstoneHitchListener
+{
+public:
+	void OnWorldInitialized(UWorld* World, const UWorld::InitializationValues)
+	{
+		World->AddOnActorPreSpawnInitialization(FOnActorSpawned::FDelegate::CreateRaw(this, &FCapstoneHitchListener::OnActorPreSpawn));
+		World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FCapstoneHitchListener::OnActorSpawned));
+	}
+
+	void OnActorPreSpawn(AActor* Actor)
+	{
+		PendingSpawns.Emplace(Actor, FPlatformTime::Cycles64());
+	}
+
+	void OnActorSpawned(AActor* Actor)
+	{
+		// Spawns can nest through BeginPlay, so match from the most recent.
+		for (int32 Index = PendingSpawns.Num() - 1; Index >= 0; Index--)
+		{
+			if (PendingSpawns[Index].Key == Actor)
+			{
+				FCapstoneHitchDetector::AddOperation(ECapstoneHitchOperation::Spawn, Actor->GetClass()->GetFName(), FPlatformTime::Cycles64() - PendingSpawns[Index].Value);
+				PendingSpawns.RemoveAt(Index, 1, false);
+				return;
+			}
+		}
+	}
+
+	void OnSyncLoadPackage(const FString& PackageName)
+	{
+		// The time spent blocking on loads is added per frame, see FCapstoneHitchDetector::EndFrame().
+		FCapstoneHitchDetector::AddOperation(ECapstoneHitchOperation::Load, FName(*PackageName), 0);
+	}
+
+	void OnPreGarbageCollect()
+	{
+		GCStartCycles = FPlatformTime::Cycles64();
+	}
+
+	void OnPostGarbageCollect()
+	{
+		FCapstoneHitchDetector::AddOperation(ECapstoneHitchOperation::GC, TEXT("CollectGarbage"), FPlatformTime::Cycles64() - GCStartCycles);
+	}
+
+	TArray<TPair<const AActor*, uint64>> PendingSpawns;
+	uint64 GCStartCycles = 0;
+
+	FDelegateHandle WorldInitializedHandle;
+	FDelegateHandle SyncLoadHandle;
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+};
+
+static FCapstoneHitchListener GCapstoneHitchListener;
+
+void FCapstoneHitchDetector::AddOperation(ECapstoneHitchOperation Operation, FName Name, uint64 Cycles)
+{
+	if (IsInGameThread())
+		CurrentFrameOperations.Add({ Operation, Name, Cycles });
+}
+
+const TCHAR* FCapstoneHitchDetector::GetOperationName(ECapstoneHitchOperation Operation)
+{
+	switch (Operation)
+	{
+	case ECapstoneHitchOperation::Spawn:	return TEXT("Spawn");
+	case ECapstoneHitchOperation::Widget:	return TEXT("Widget");
+	case ECapstoneHitchOperation::Load:		return TEXT("Load");
+	case ECapstoneHitchOperation::GC:		return TEXT("GC");
+	default:								return TEXT("Unknown");
+	}
+}
+
+void FCapstoneHitchDetector::Startup()
+{
+	FCapstoneHitchListener& Listener = GCapstoneHitchListener;
+	Listener.WorldInitializedHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(&Listener, &FCapstoneHitchListener::OnWorldInitialized);
+	Listener.SyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddRaw(&Listener, &FCapstoneHitchListener::OnSyncLoadPackage);
+	Listener.PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(&Listener, &FCapstoneHitchListener::OnPreGarbageCollect);
+	Listener.PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(&Listener, &FCapstoneHitchListener::OnPostGarbageCollect);
+}
+
+void FCapstoneHitchDetector::Shutdown()
+{
+	FCapstoneHitchListener& Listener = GCapstoneHitchListener;
+	FWorldDelegates::OnPostWorldInitialization.Remove(Listener.WorldInitializedHandle);
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(Listener.SyncLoadHandle);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(Listener.PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(Listener.PostGCHandle);
+
+	if (ReportWriteTask.IsValid())
+		ReportWriteTask.Wait();
+}
+
+void FCapstoneHitchDetector::EndFrame()
+{
+	const double FrameMs = (FPlatformTime::Seconds() - LastEndFrameTime) * 1000.0;
+
+	// Blocking loads flush the async loading queue, the engine keeps a running total of the time spent.
+	const double FlushMs = (GFlushAsyncLoadingTime - LastFlushAsyncLoadingTime) * 1000.0;
+	LastFlushAsyncLoadingTime = GFlushAsyncLoadingTime;
+	if (FlushMs > 0)
+		AddOperation(ECapstoneHitchOperation::Load, TEXT("FlushAsyncLoading"), MillisecondsToCycles(FlushMs));
+
+	const float BudgetMs = CVarHitchBudgetMs.GetValueOnGameThread();
+	if (LastEndFrameTime > 0 && BudgetMs > 0 && FrameMs > BudgetMs)
+	{
+		HitchCount++;
+		WriteReport(FrameMs, BudgetMs);
+	}
+
+	CurrentFrameOperations.Reset();
+	GCapstoneHitchListener.PendingSpawns.Reset();
+
+	// Taken after the report so writing it isn't blamed on the next frame.
+	LastEndFrameTime = FPlatformTime::Seconds();
+}
+
+void FCapstoneHitchDetector::WriteReport(double FrameMs, double BudgetMs)
+{
+	// Merge repeated operations, e.g. every pellet's impact effect spawning the same class.
+	struct FMergedOperation
+	{
+		ECapstoneHitchOperation Operation;
+		FName Name;
+		int32 Count;
+		uint64 Cycles;
+	};
+	TArray<FMergedOperation> Merged;
+	int32 LoadCount = 0;
+	for (const FOperation& Operation : CurrentFrameOperations)
+	{
+		if (Operation.Operation == ECapstoneHitchOperation::Load && Operation.Cycles == 0)
+			LoadCount++;
+
+		FMergedOperation* Existing = Merged.FindByPredicate([&Operation](const FMergedOperation& Entry)
+		{
+			return Entry.Operation == Operation.Operation && Entry.Name == Operation.Name;
+		});
+
+		if (Existing)
+		{
+			Existing->Count++;
+			Existing->Cycles += Operation.Cycles;
+		}
+		else
+			Merged.Add({ Operation.Operation, Operation.Name, 1, Operation.Cycles });
+	}
+	Merged.Sort([](const FMergedOperation& A, const FMergedOperation& B) { return A.Cycles > B.Cycles; });
+
+	FString Report = FString::Printf(TEXT("[%s] Frame %llu took %.1f ms, budget %.1f ms") LINE_TERMINATOR,
+		*FDateTime::Now().ToString(), (uint64)GFrameCounter, FrameMs, BudgetMs);
+
+	for (const FMergedOperation& Entry : Merged)
+	{
+		Report += FString::Printf(TEXT("\t%-8s %s x%d, %.2f ms") LINE_TERMINATOR,
+			GetOperationName(Entry.Operation), *Entry.Name.ToString(), Entry.Count, FPlatformTime::ToMilliseconds64(Entry.Cycles));
+	}
+
+	// The frame counters have already moved this frame into their last frame values.
+	Report += FString::Printf(TEXT("\tCounts   %d actor spawns, %d widget creations, %d gameplay scene queries") LINE_TERMINATOR,
+		FCapstoneFrameCounters::GetLastFrameActorSpawns(), FCapstoneFrameCounters::GetLastFrameWidgetCreations(), FCapstoneFrameCounters::GetLastFrameSceneQueries());
+
+	Report += TEXT("\tCosts   ");
+	for (int32 Index = 0; Index < (int32)ECapstoneSubsystem::Count; Index++)
+	{
+		const ECapstoneSubsystem Subsystem = (ECapstoneSubsystem)Index;
+		Report += FString::Printf(TEXT(" %s %.2f ms"), FCapstoneSubsystemCosts::GetSubsystemName(Subsystem), FCapstoneSubsystemCosts::GetLastFrameMs(Subsystem));
+	}
+	Report += LINE_TERMINATOR;
+
+	// Writing on the hitch frame would only make it longer. Each write waits for the one before it, so the
+	// reports stay in order without the game thread ever waiting.
+	const FString LogPath = GetLogPath();
+	ReportWriteTask = Async(EAsyncExecution::ThreadPool, [PreviousWrite = MoveTemp(ReportWriteTask), Report = MoveTemp(Report), LogPath]()
+	{
+		if (PreviousWrite.IsValid())
+			PreviousWrite.Wait();
+
+		IFileManager& FileManager = IFileManager::Get();
+		if (FileManager.FileSize(*LogPath) > MAX_LOG_BYTES)
+			FileManager.Move(*(FPaths::ProjectLogDir() / TEXT("CapstoneHitches-backup.log")), *LogPath, true);
+
+		FFileHelper::SaveStringToFile(Report, *LogPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &FileManager, FILEWRITE_Append);
+	});
+
+	UE_LOG(LogCapstonePerformance, Warning, TEXT("Hitch: frame took %.1f ms with %d spawns, %d loads and %d widget creations, see %s"),
+		FrameMs, FCapstoneFrameCounters::GetLastFrameActorSpawns(), LoadCount, FCapstoneFrameCounters::GetLastFrameWidgetCreations(), *LogPath);
+}
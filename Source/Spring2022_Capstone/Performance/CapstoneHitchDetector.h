@@ -0,0 +1,86 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+// Kinds of synchronous game thread work the hitch detector attributes frames to.
+enum class ECapstoneHitchOperation : uint8
+{
+	Spawn,
+	Widget,
+	Load,
+	GC,
+	Count
+};
+
+/**
+ * Flags game thread frames that run over Capstone.HitchBudgetMs and reports what ran during them.
+ *
+ * Actor spawns (by class), blocking package loads and garbage collection are hooked through engine delegates and
+ * timed automatically. Widget creation is timed where it is wrapped in CAPSTONE_HITCH_SCOPE, other widgets and the
+ * gameplay scene queries only show in the frame's counts from FCapstoneFrameCounters, next to the subsystem costs.
+ *
+ * Reports are appended to Saved/Logs/CapstoneHitches.log, which rolls over to CapstoneHitches-backup.log once it
+ * gets large, so playtesters can attach both to a bug report. The file is written on a worker thread.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneHitchDetector
+{
+	// Adds a timed operation to the current frame. Game thread only.
+	static void AddOperation(ECapstoneHitchOperation Operation, FName Name, uint64 Cycles);
+
+	static const TCHAR* GetOperationName(ECapstoneHitchOperation Operation);
+
+	static int32 GetHitchCount() { return HitchCount; }
+
+	// Hooks the engine delegates. Called from module startup/shutdown.
+	static void Startup();
+	static void Shutdown();
+
+	// Checks the frame against the budget and reports it. Called from FCoreDelegates::OnEndFrame after the counters.
+	static void EndFrame();
+
+private:
+	friend class FCapstoneHitchListener;
+
+	struct FOperation
+	{
+		ECapstoneHitchOperation Operation;
+		FName Name;
+		uint64 Cycles;
+	};
+
+	static void WriteReport(double FrameMs, double BudgetMs);
+
+	static TArray<FOperation> CurrentFrameOperations;
+	static double LastEndFrameTime;
+	static double LastFlushAsyncLoadingTime;
+	static int32 HitchCount;
+
+	// Last report handed to a worker for writing.
+	static TFuture<void> ReportWriteTask;
+};
+
+/**
+ * Adds the time between construction and destruction to the current frame as an operation.
+ */
+struct FCapstoneHitchScope
+{
+	FCapstoneHitchScope(ECapstoneHitchOperation InOperation, FName InName)
+		: Operation(InOperation), Name(InName), StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FCapstoneHitchScope()
+	{
+		FCapstoneHitchDetector::AddOperation(Operation, Name, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	ECapstoneHitchOperation Operation;
+	FName Name;
+	uint64 StartCycles;
+};
+
+#define CAPSTONE_HITCH_SCOPE(Operation, Name) FCapstoneHitchScope PREPROCESSOR_JOIN(CapstoneHitchScope_, __LINE__)(ECapstoneHitchOperation::Operation, Name)
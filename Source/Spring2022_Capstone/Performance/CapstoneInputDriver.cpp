@@ -0,0 +1,89 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneInputDriver.h"
+#include "EnhancedInputSubsystems.h"
+#include "EnhancedPlayerInput.h"
+#include "GameFramework/PlayerController.h"
+#include "Spring2022_Capstone/Player/PlayerCharacter.h"
+
+UInputAction* FCapstoneInputDriver::GetInputAction(const APlayerCharacter* Player, ECapstoneInput Input)
+{
+	switch (Input)
+	{
+	case ECapstoneInput::Move:			return Player->MoveAction;
+	case ECapstoneInput::Look:			return Player->LookAction;
+	case ECapstoneInput::Jump:			return Player->JumpAction;
+	case ECapstoneInput::Sprint:		return Player->SprintAction;
+	case ECapstoneInput::Crouch:		return Player->CrouchAction;
+	case ECapstoneInput::Grapple:		return Player->GrappleAction;
+	case ECapstoneInput::Attack:		return Player->AttackAction;
+	case ECapstoneInput::SwitchWeapon:	return Player->SwitchWeaponAction;
+	case ECapstoneInput::Dash:			return Player->DashAction;
+	default:							return nullptr;
+	}
+}
+
+namespace
+{
+	const APlayerController* GetPlayerController(const APlayerCharacter* Player)
+	{
+		return Player ? Cast<APlayerController>(Player->GetController()) : nullptr;
+	}
+
+	void InjectWithTriggers(const APlayerCharacter* Player, ECapstoneInput Input, const FInputActionValue& Value, const TArray<UInputTrigger*>& Triggers)
+	{
+		UInputAction* Action = Player ? FCapstoneInputDriver::GetInputAction(Player, Input) : nullptr;
+		const APlayerController* PlayerController = GetPlayerController(Player);
+		if (!Action || !PlayerController)
+		{
+			return;
+		}
+
+		if (UEnhancedInputLocalPlayerSubsystem* InputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
+			InputSubsystem->InjectInputForAction(Action, Value, {}, Triggers);
+	}
+}
+
+void FCapstoneInputDriver::Inject(const APlayerCharacter* Player, ECapstoneInput Input, const FInputActionValue& Value)
+{
+	InjectWithTriggers(Player, Input, Value, {});
+}
+
+void FCapstoneInputDriver::InjectMapped(const APlayerCharacter* Player, ECapstoneInput Input, const FInputActionValue& Value)
+{
+	const APlayerController* PlayerController = GetPlayerController(Player);
+	const UEnhancedPlayerInput* PlayerInput = PlayerController ? Cast<UEnhancedPlayerInput>(PlayerController->PlayerInput) : nullptr;
+	if (!PlayerInput)
+	{
+		return;
+	}
+
+	// Values are recorded after the mapping's modifiers ran, so only its triggers are passed on.
+	TArray<UInputTrigger*> Triggers;
+	const UInputAction* Action = GetInputAction(Player, Input);
+	for (const FEnhancedActionKeyMapping& Mapping : PlayerInput->GetEnhancedActionMappings())
+	{
+		if (Mapping.Action == Action)
+		{
+			for (UInputTrigger* Trigger : Mapping.Triggers)
+				Triggers.Add(Trigger);
+			break;
+		}
+	}
+
+	InjectWithTriggers(Player, Input, Value, Triggers);
+}
+
+FInputActionValue FCapstoneInputDriver::GetActionValue(const APlayerCharacter* Player, ECapstoneInput Input)
+{
+	const APlayerController* PlayerController = GetPlayerController(Player);
+	const UEnhancedPlayerInput* PlayerInput = PlayerController ? Cast<UEnhancedPlayerInput>(PlayerController->PlayerInput) : nullptr;
+	if (!PlayerInput)
+	{
+		return FInputActionValue();
+	}
+
+	const FInputActionInstance* ActionInstance = PlayerInput->FindActionInstanceData(GetInputAction(Player, Input));
+	return ActionInstance ? ActionInstance->GetValue() : FInputActionValue();
+}
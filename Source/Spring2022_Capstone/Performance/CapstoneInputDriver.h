@@ -0,0 +1,49 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionValue.h"
+
+class APlayerCharacter;
+class UInputAction;
+
+// Input actions of APlayerCharacter that automated runs can press.
+enum class ECapstoneInput : uint8
+{
+	Move,
+	Look,
+	Jump,
+	Sprint,
+	Crouch,
+	Grapple,
+	Attack,
+	SwitchWeapon,
+	Dash,
+	Count
+};
+
+/**
+ * @brief Drives APlayerCharacter through its real Enhanced Input actions, used by the benchmark and soak runs.
+ * Injected values only last one frame, so held inputs have to be injected every frame.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneInputDriver
+{
+	static UInputAction* GetInputAction(const APlayerCharacter* Player, ECapstoneInput Input);
+
+	/**
+	 * @brief Feeds Value into Input's action for this frame, as if it came from the player's device.
+	 */
+	static void Inject(const APlayerCharacter* Player, ECapstoneInput Input, const FInputActionValue& Value);
+
+	/**
+	 * @brief Like Inject(), but evaluates the triggers of the key mapping the player has for Input, so a held value
+	 * replays the same pressed and released events that the original key produced.
+	 */
+	static void InjectMapped(const APlayerCharacter* Player, ECapstoneInput Input, const FInputActionValue& Value);
+
+	/**
+	 * @brief Value of Input's action after this frame's input was processed, zero when it isn't actuated.
+	 */
+	static FInputActionValue GetActionValue(const APlayerCharacter* Player, ECapstoneInput Input);
+};
@@ -0,0 +1,141 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneInputLatency.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DECLARE_CATEGORY_EXTERN(Capstone);
+
+namespace
+{
+	// Upper bounds of the histogram buckets, roughly doubling from a millisecond to eight frames at 60 fps.
+	const float BUCKET_UPPER_MS[FCapstoneLatencyHistogram::BUCKET_COUNT - 1] = { 1.f, 2.f, 4.f, 8.f, 16.7f, 33.3f, 66.7f, 133.3f };
+
+	const double MAX_PENDING_SECONDS = 1.0;		// Inputs without an effect after this long are dropped.
+
+#if CSV_PROFILER
+	const char* CSV_STAT_NAMES[(int32)ECapstoneLatencyAction::Count] = { "AttackLatencyMs", "GrappleLatencyMs", "JumpLatencyMs", "DashLatencyMs" };
+#endif
+}
+
+FCapstoneLatencyHistogram FCapstoneInputLatency::Histograms[(int32)ECapstoneLatencyAction::Count];
+FCapstoneInputLatency::FPendingInput FCapstoneInputLatency::PendingInputs[(int32)ECapstoneLatencyAction::Count];
+double FCapstoneInputLatency::FrameStartSeconds = 0;
+
+float FCapstoneLatencyHistogram::GetPercentileMs(float Fraction) const
+{
+	const int32 Target = FMath::CeilToInt(Fraction * Count);
+	int32 Seen = 0;
+	for (int32 Bucket = 0; Bucket < BUCKET_COUNT - 1; Bucket++)
+	{
+		Seen += Buckets[Bucket];
+		if (Seen >= Target)
+			return FMath::Min(BUCKET_UPPER_MS[Bucket], MaxMs);
+	}
+	return MaxMs;
+}
+
+void FCapstoneInputLatency::MarkInput(ECapstoneLatencyAction Action)
+{
+	check(IsInGameThread());
+	FPendingInput& Pending = PendingInputs[(int32)Action];
+
+	// Held and repeated inputs, and presses still waiting on their effect, keep the time of the first one.
+	if (Pending.Seconds > 0 && FPlatformTime::Seconds() - Pending.Seconds < MAX_PENDING_SECONDS)
+	{
+		return;
+	}
+
+	// The input arrived when the frame pumped its messages, not when the handler ran.
+	Pending.Seconds = FrameStartSeconds > 0 ? FrameStartSeconds : FPlatformTime::Seconds();
+	Pending.Frame = GFrameCounter;
+}
+
+void FCapstoneInputLatency::MarkEffect(ECapstoneLatencyAction Action)
+{
+	check(IsInGameThread());
+	FPendingInput& Pending = PendingInputs[(int32)Action];
+	if (Pending.Seconds <= 0)
+	{
+		return;
+	}
+
+	const float LatencyMs = (FPlatformTime::Seconds() - Pending.Seconds) * 1000.0;
+	const uint64 LatencyFrames = GFrameCounter - Pending.Frame;
+	Pending = FPendingInput();
+	if (LatencyMs > MAX_PENDING_SECONDS * 1000.0)
+	{
+		return;
+	}
+
+	FCapstoneLatencyHistogram& Histogram = Histograms[(int32)Action];
+	int32 Bucket = 0;
+	while (Bucket < FCapstoneLatencyHistogram::BUCKET_COUNT - 1 && LatencyMs > BUCKET_UPPER_MS[Bucket])
+		Bucket++;
+
+	Histogram.Buckets[Bucket]++;
+	Histogram.Count++;
+	Histogram.SumMs += LatencyMs;
+	Histogram.MaxMs = FMath::Max(Histogram.MaxMs, LatencyMs);
+	Histogram.SumFrames += LatencyFrames;
+
+#if CSV_PROFILER
+	FCsvProfiler::RecordCustomStat(CSV_STAT_NAMES[(int32)Action], CSV_CATEGORY_INDEX(Capstone), LatencyMs, ECsvCustomStatOp::Max);
+#endif
+}
+
+void FCapstoneInputLatency::CancelInput(ECapstoneLatencyAction Action)
+{
+	check(IsInGameThread());
+	PendingInputs[(int32)Action] = FPendingInput();
+}
+
+void FCapstoneInputLatency::BeginFrame()
+{
+	FrameStartSeconds = FPlatformTime::Seconds();
+}
+
+void FCapstoneInputLatency::Reset()
+{
+	for (int32 Index = 0; Index < (int32)ECapstoneLatencyAction::Count; Index++)
+	{
+		Histograms[Index] = FCapstoneLatencyHistogram();
+		PendingInputs[Index] = FPendingInput();
+	}
+}
+
+const TCHAR* FCapstoneInputLatency::GetActionName(ECapstoneLatencyAction Action)
+{
+	switch (Action)
+	{
+	case ECapstoneLatencyAction::Attack:	return TEXT("Attack");
+	case ECapstoneLatencyAction::Grapple:	return TEXT("Grapple");
+	case ECapstoneLatencyAction::Jump:		return TEXT("Jump");
+	case ECapstoneLatencyAction::Dash:		return TEXT("Dash");
+	default:								return TEXT("Unknown");
+	}
+}
+
+float FCapstoneInputLatency::GetBucketUpperMs(int32 Bucket)
+{
+	return Bucket < FCapstoneLatencyHistogram::BUCKET_COUNT - 1 ? BUCKET_UPPER_MS[Bucket] : MAX_PENDING_SECONDS * 1000.0;
+}
+
+FString FCapstoneInputLatency::BuildCsv()
+{
+	FString Csv = TEXT("Action,Count,AvgMs,P95Ms,MaxMs,AvgFrames");
+	for (int32 Bucket = 0; Bucket < FCapstoneLatencyHistogram::BUCKET_COUNT; Bucket++)
+		Csv += FString::Printf(TEXT(",Under%.0fMs"), GetBucketUpperMs(Bucket));
+	Csv += LINE_TERMINATOR;
+
+	for (int32 Index = 0; Index < (int32)ECapstoneLatencyAction::Count; Index++)
+	{
+		const FCapstoneLatencyHistogram& Histogram = Histograms[Index];
+		Csv += FString::Printf(TEXT("%s,%d,%.2f,%.2f,%.2f,%.2f"), GetActionName((ECapstoneLatencyAction)Index),
+			Histogram.Count, Histogram.GetAverageMs(), Histogram.GetPercentileMs(0.95f), Histogram.MaxMs, Histogram.GetAverageFrames());
+		for (const int32 Count : Histogram.Buckets)
+			Csv += FString::Printf(TEXT(",%d"), Count);
+		Csv += LINE_TERMINATOR;
+	}
+	return Csv;
+}
@@ -0,0 +1,83 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Player actions whose input to effect latency is measured.
+enum class ECapstoneLatencyAction : uint8
+{
+	Attack,
+	Grapple,
+	Jump,
+	Dash,
+	Count
+};
+
+/**
+ * Latency histogram of one action. Bucket upper bounds are in FCapstoneInputLatency::GetBucketUpperMs().
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneLatencyHistogram
+{
+	static const int32 BUCKET_COUNT = 9;
+
+	int32 Buckets[BUCKET_COUNT] = {};
+	int32 Count = 0;
+	double SumMs = 0;
+	float MaxMs = 0;
+	int64 SumFrames = 0;
+
+	float GetAverageMs() const { return Count > 0 ? SumMs / Count : 0.f; }
+	float GetAverageFrames() const { return Count > 0 ? (float)SumFrames / Count : 0.f; }
+
+	/**
+	 * @brief Upper bound of the bucket holding the Fraction percentile, MaxMs for the last bucket.
+	 */
+	float GetPercentileMs(float Fraction) const;
+};
+
+/**
+ * Measures how long each ECapstoneLatencyAction takes from its input being handled to its effect, within a frame or
+ * across frames, e.g. the dash launch waiting on a timer or the mantle starting on the component's next tick.
+ *
+ * The input handler calls MarkInput() and the code applying the effect calls MarkEffect(). Inputs are timed from the
+ * start of the frame they were pumped in, so an effect applied within the handler still counts the frame's work
+ * before it. An input stays pending until its effect or a second has passed, so a press the weapon's fire rate timer
+ * ignores is timed to the shot that follows it. Input that can't have an effect at all, a jump that can't mantle, is
+ * dropped with CancelInput(). Only the first input of a held or repeated press is timed.
+ *
+ * The histograms are shown on the performance overlay, and benchmark runs write them to Saved/Benchmark/<Map>_Latency.csv
+ * next to the per action CSV profiler stats. Game thread only.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneInputLatency
+{
+	static void MarkInput(ECapstoneLatencyAction Action);
+	static void MarkEffect(ECapstoneLatencyAction Action);
+	static void CancelInput(ECapstoneLatencyAction Action);
+
+	// Stamps the time this frame's input is pumped. Called from FCoreDelegates::OnBeginFrame.
+	static void BeginFrame();
+
+	// Clears the histograms and pending inputs.
+	static void Reset();
+
+	static const FCapstoneLatencyHistogram& GetHistogram(ECapstoneLatencyAction Action) { return Histograms[(int32)Action]; }
+	static const TCHAR* GetActionName(ECapstoneLatencyAction Action);
+	static float GetBucketUpperMs(int32 Bucket);
+
+	/**
+	 * @brief Histograms as CSV, one row per action with the bucket counts as columns.
+	 */
+	static FString BuildCsv();
+
+private:
+	struct FPendingInput
+	{
+		double Seconds = 0;
+		uint64 Frame = 0;
+	};
+
+	static FCapstoneLatencyHistogram Histograms[(int32)ECapstoneLatencyAction::Count];
+	static FPendingInput PendingInputs[(int32)ECapstoneLatencyAction::Count];
+	static double FrameStartSeconds;
+};
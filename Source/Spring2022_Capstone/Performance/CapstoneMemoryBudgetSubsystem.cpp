@@ -0,0 +1,67 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneMemoryBudgetSubsystem.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+
+void UCapstoneMemoryBudgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (!FCapstoneMemoryTags::IsTracking())
+		UE_LOG(LogCapstonePerformance, Verbose, TEXT("Memory budgets: LLM is off, run with -LLM to track the Capstone memory tags"));
+}
+
+TStatId UCapstoneMemoryBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCapstoneMemoryBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UCapstoneMemoryBudgetSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceSample += DeltaTime;
+	if (TimeSinceSample >= SAMPLE_INTERVAL)
+	{
+		TimeSinceSample = 0;
+		SampleTags();
+	}
+}
+
+float UCapstoneMemoryBudgetSubsystem::GetBudgetMB(ECapstoneMemoryTag Tag) const
+{
+	switch (Tag)
+	{
+	case ECapstoneMemoryTag::Weapons:			return WeaponsBudgetMB;
+	case ECapstoneMemoryTag::PlayerAbilities:	return PlayerAbilitiesBudgetMB;
+	case ECapstoneMemoryTag::AI:				return AIBudgetMB;
+	case ECapstoneMemoryTag::UI:				return UIBudgetMB;
+	case ECapstoneMemoryTag::Pickups:			return PickupsBudgetMB;
+	case ECapstoneMemoryTag::Telemetry:			return TelemetryBudgetMB;
+	default:									return 0;
+	}
+}
+
+void UCapstoneMemoryBudgetSubsystem::SampleTags()
+{
+	for (int32 Index = 0; Index < (int32)ECapstoneMemoryTag::Count; Index++)
+	{
+		const ECapstoneMemoryTag Tag = (ECapstoneMemoryTag)Index;
+		CurrentMB[Index] = FCapstoneMemoryTags::GetTagBytes(Tag) / (1024.f * 1024.f);
+		HighWaterMB[Index] = FMath::Max(HighWaterMB[Index], CurrentMB[Index]);
+
+		const float BudgetMB = GetBudgetMB(Tag);
+		const bool bWasOverBudget = bOverBudget[Index];
+		bOverBudget[Index] = BudgetMB > 0 && CurrentMB[Index] > BudgetMB;
+
+		if (bOverBudget[Index] && !bWasOverBudget)
+			UE_LOG(LogCapstonePerformance, Warning, TEXT("Memory budgets: %s is over budget, %.1f MB of %.1f MB"), FCapstoneMemoryTags::GetTagName(Tag), CurrentMB[Index], BudgetMB);
+		else if (!bOverBudget[Index] && bWasOverBudget)
+			UE_LOG(LogCapstonePerformance, Display, TEXT("Memory budgets: %s is back within budget, %.1f MB of %.1f MB"), FCapstoneMemoryTags::GetTagName(Tag), CurrentMB[Index], BudgetMB);
+	}
+}
+
+void UCapstoneMemoryBudgetSubsystem::ResetHighWater()
+{
+	for (int32 Index = 0; Index < (int32)ECapstoneMemoryTag::Count; Index++)
+		HighWaterMB[Index] = CurrentMB[Index];
+}
@@ -0,0 +1,68 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "CapstoneMemoryTags.h"
+#include "CapstoneMemoryBudgetSubsystem.generated.h"
+
+/**
+ * Checks the game module's memory tags against their budgets once a second and keeps their high-water marks.
+ *
+ * A tag going over its budget is logged as a warning and listed on the performance overlay until it drops back.
+ * The soak and benchmark runs record the high-water marks so a memory regression points at a subsystem.
+ * Tags are only filled when the game runs with -LLM, otherwise the subsystem stays idle.
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UCapstoneMemoryBudgetSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !IsTemplate() && FCapstoneMemoryTags::IsTracking(); }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	float GetBudgetMB(ECapstoneMemoryTag Tag) const;
+	float GetCurrentMB(ECapstoneMemoryTag Tag) const { return CurrentMB[(int32)Tag]; }
+	float GetHighWaterMB(ECapstoneMemoryTag Tag) const { return HighWaterMB[(int32)Tag]; }
+	bool IsOverBudget(ECapstoneMemoryTag Tag) const { return bOverBudget[(int32)Tag]; }
+
+	/**
+	 * @brief Samples every tag now instead of waiting for the next interval.
+	 */
+	void SampleTags();
+
+	// Starts the high-water marks over, e.g. between benchmark maps.
+	void ResetHighWater();
+
+private:
+	// Budgets in MB, a budget of 0 is never warned about.
+	UPROPERTY(Config)
+	float WeaponsBudgetMB = 16.f;
+	UPROPERTY(Config)
+	float PlayerAbilitiesBudgetMB = 8.f;
+	UPROPERTY(Config)
+	float AIBudgetMB = 32.f;
+	UPROPERTY(Config)
+	float UIBudgetMB = 32.f;
+	UPROPERTY(Config)
+	float PickupsBudgetMB = 4.f;
+	UPROPERTY(Config)
+	float TelemetryBudgetMB = 4.f;
+
+	float CurrentMB[(int32)ECapstoneMemoryTag::Count] = {};
+	float HighWaterMB[(int32)ECapstoneMemoryTag::Count] = {};
+	bool bOverBudget[(int32)ECapstoneMemoryTag::Count] = {};
+
+	float TimeSinceSample = 0;
+
+/// Const Variables ///
+	const float SAMPLE_INTERVAL = 1.f;		// Seconds between budget checks.
+};
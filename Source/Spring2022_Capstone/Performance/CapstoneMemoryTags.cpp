@@ -0,0 +1,59 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneMemoryTags.h"
+
+LLM_DEFINE_TAG(Capstone_Weapons);
+LLM_DEFINE_TAG(Capstone_PlayerAbilities);
+LLM_DEFINE_TAG(Capstone_AI);
+LLM_DEFINE_TAG(Capstone_UI);
+LLM_DEFINE_TAG(Capstone_Pickups);
+LLM_DEFINE_TAG(Capstone_Telemetry);
+
+bool FCapstoneMemoryTags::IsTracking()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	return FLowLevelMemTracker::IsEnabled();
+#else
+	return false;
+#endif
+}
+
+int64 FCapstoneMemoryTags::GetTagBytes(ECapstoneMemoryTag Tag)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (!IsTracking())
+	{
+		return 0;
+	}
+
+	FName TagName;
+	switch (Tag)
+	{
+	case ECapstoneMemoryTag::Weapons:			TagName = LLM_TAGNAME(Capstone_Weapons); break;
+	case ECapstoneMemoryTag::PlayerAbilities:	TagName = LLM_TAGNAME(Capstone_PlayerAbilities); break;
+	case ECapstoneMemoryTag::AI:				TagName = LLM_TAGNAME(Capstone_AI); break;
+	case ECapstoneMemoryTag::UI:				TagName = LLM_TAGNAME(Capstone_UI); break;
+	case ECapstoneMemoryTag::Pickups:			TagName = LLM_TAGNAME(Capstone_Pickups); break;
+	case ECapstoneMemoryTag::Telemetry:			TagName = LLM_TAGNAME(Capstone_Telemetry); break;
+	default:									return 0;
+	}
+	return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, TagName, ELLMTagSet::None);
+#else
+	return 0;
+#endif
+}
+
+const TCHAR* FCapstoneMemoryTags::GetTagName(ECapstoneMemoryTag Tag)
+{
+	switch (Tag)
+	{
+	case ECapstoneMemoryTag::Weapons:			return TEXT("Weapons");
+	case ECapstoneMemoryTag::PlayerAbilities:	return TEXT("PlayerAbilities");
+	case ECapstoneMemoryTag::AI:				return TEXT("AI");
+	case ECapstoneMemoryTag::UI:				return TEXT("UI");
+	case ECapstoneMemoryTag::Pickups:			return TEXT("Pickups");
+	case ECapstoneMemoryTag::Telemetry:			return TEXT("Telemetry");
+	default:									return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,49 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Low level memory tags of the game module, shown as Capstone/<Name> in LLM reports.
+LLM_DECLARE_TAG_API(Capstone_Weapons, SPRING2022_CAPSTONE_API);
+LLM_DECLARE_TAG_API(Capstone_PlayerAbilities, SPRING2022_CAPSTONE_API);
+LLM_DECLARE_TAG_API(Capstone_AI, SPRING2022_CAPSTONE_API);
+LLM_DECLARE_TAG_API(Capstone_UI, SPRING2022_CAPSTONE_API);
+LLM_DECLARE_TAG_API(Capstone_Pickups, SPRING2022_CAPSTONE_API);
+LLM_DECLARE_TAG_API(Capstone_Telemetry, SPRING2022_CAPSTONE_API);
+
+enum class ECapstoneMemoryTag : uint8
+{
+	Weapons,
+	PlayerAbilities,
+	AI,
+	UI,
+	Pickups,
+	Telemetry,
+	Count
+};
+
+/**
+ * @brief Reads the game module's LLM tags. Tags only hold data when the game runs with -LLM.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneMemoryTags
+{
+	static bool IsTracking();
+
+	// Bytes currently allocated under Tag, 0 when LLM isn't tracking.
+	static int64 GetTagBytes(ECapstoneMemoryTag Tag);
+
+	static const TCHAR* GetTagName(ECapstoneMemoryTag Tag);
+};
+
+// Allocations until the end of the scope count towards Tag, e.g. CAPSTONE_LLM_SCOPE(Capstone_UI).
+#define CAPSTONE_LLM_SCOPE(Tag) LLM_SCOPE_BYTAG(Tag)
+
+// Tag used by CAPSTONE_SCOPE for each ECapstoneSubsystem.
+#define CAPSTONE_LLM_TAG_Weapons Capstone_Weapons
+#define CAPSTONE_LLM_TAG_Grapple Capstone_PlayerAbilities
+#define CAPSTONE_LLM_TAG_Mantle Capstone_PlayerAbilities
+#define CAPSTONE_LLM_TAG_Player Capstone_PlayerAbilities
+#define CAPSTONE_LLM_TAG_AI Capstone_AI
+#define CAPSTONE_LLM_TAG_UI Capstone_UI
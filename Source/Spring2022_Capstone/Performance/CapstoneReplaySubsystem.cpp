@@ -0,0 +1,378 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneReplaySubsystem.h"
+#include "CapstoneInputDriver.h"
+#include "EngineUtils.h"
+#include "InputAction.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+#include "Spring2022_Capstone/GameplaySystems/FixedStepClock.h"
+#include "Spring2022_Capstone/GameplaySystems/GameplaySnapshot.h"
+#include "Spring2022_Capstone/Player/PlayerCharacter.h"
+#include "Spring2022_Capstone/Weapon/ShotgunWeapon.h"
+
+static FAutoConsoleCommandWithWorld ToggleRecordingCommand(
+	TEXT("Capstone.Record"),
+	TEXT("Starts or stops recording a replay of the current session."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		if (UCapstoneReplaySubsystem* ReplaySubsystem = GameInstance ? GameInstance->GetSubsystem<UCapstoneReplaySubsystem>() : nullptr)
+		{
+			if (ReplaySubsystem->IsRecording())
+				ReplaySubsystem->StopRecording();
+			else
+				ReplaySubsystem->StartRecording();
+		}
+	}));
+
+namespace
+{
+	// Number of floats stored for a value of each EInputActionValueType, booleans are implied by being active.
+	int32 GetStoredAxisCount(EInputActionValueType ValueType)
+	{
+		switch (ValueType)
+		{
+		case EInputActionValueType::Axis1D:		return 1;
+		case EInputActionValueType::Axis2D:		return 2;
+		case EInputActionValueType::Axis3D:		return 3;
+		default:								return 0;
+		}
+	}
+
+	FString GetMapPath(const UWorld* World)
+	{
+		return UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+	}
+}
+
+void UCapstoneReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FString ReplayPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("CapstoneReplay="), ReplayPath))
+	{
+		ReplayName = FPaths::GetBaseFilename(ReplayPath);
+		if (!LoadReplay(ReplayPath))
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 2);
+			return;
+		}
+
+		// Every frame is stepped with its recorded delta time instead of the wall clock.
+		FApp::SetUseFixedTimeStep(true);
+		bReplayPending = true;
+	}
+	else if (FParse::Param(FCommandLine::Get(), TEXT("CapstoneRecord")))
+	{
+		bRecordOnBeginPlay = true;
+	}
+}
+
+void UCapstoneReplaySubsystem::Deinitialize()
+{
+	StopRecording();
+	if (bReplaying || bReplayPending)
+		FApp::SetUseFixedTimeStep(false);
+
+	Super::Deinitialize();
+}
+
+TStatId UCapstoneReplaySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCapstoneReplaySubsystem, STATGROUP_Tickables);
+}
+
+void UCapstoneReplaySubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World || !World->HasBegunPlay())
+	{
+		return;
+	}
+
+	APlayerCharacter* Player = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0));
+	const bool bPaused = UGameplayStatics::IsGamePaused(World);
+
+	if (bRecordOnBeginPlay)
+	{
+		bRecordOnBeginPlay = false;
+		StartRecording();
+	}
+	else if (bRecording)
+	{
+		if (World != RecordingWorld.Get() || bPaused || !Player)
+			StopRecording();
+		else
+			RecordFrame(Player, DeltaTime);
+	}
+	else if (bReplayPending)
+	{
+		if (GetMapPath(World) == MapPath)
+		{
+			StartReplay(World);
+		}
+		else if (!bReplayMapRequested)
+		{
+			bReplayMapRequested = true;
+			UGameplayStatics::OpenLevel(World, FName(MapPath));
+		}
+	}
+	else if (bReplaying)
+	{
+		if (bPaused || !Player)
+			FinishReplay();
+		else
+			ReplayFrame(World, Player);
+	}
+}
+
+void UCapstoneReplaySubsystem::StartRecording()
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World || bRecording || bReplaying || bReplayPending)
+	{
+		return;
+	}
+
+	// The session being played is left as it is, the snapshot is only applied when the replay starts.
+	FGameplaySnapshot::Capture(World).ToBytes(SnapshotBytes);
+	FFixedStepClock::ResetAll();
+	FixedStepHz = FFixedStepClock::GetFixedStepHz();
+
+	ShotgunNames.Reset();
+	ShotgunSeeds.Reset();
+	for (TActorIterator<AShotgunWeapon> It(World); It; ++It)
+	{
+		const int32 Seed = FMath::Rand();
+		It->SetSpreadSeed(Seed);
+		ShotgunNames.Add(It->GetFName());
+		ShotgunSeeds.Add(Seed);
+	}
+
+	GlobalSeed = FMath::Rand();
+	FMath::RandInit(GlobalSeed);
+	FMath::SRandInit(GlobalSeed);
+
+	MapPath = GetMapPath(World);
+	FrameBytes.Reset();
+	FrameCount = 0;
+	RecordCycles = 0;
+	RecordingWorld = World;
+	bRecording = true;
+
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Replay: recording %s"), *MapPath);
+}
+
+void UCapstoneReplaySubsystem::StopRecording()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+	bRecording = false;
+
+	TArray<uint8> FileBytes;
+	FMemoryWriter Writer(FileBytes);
+	uint32 Magic = REPLAY_MAGIC;
+	uint8 Version = REPLAY_VERSION;
+	Writer << Magic << Version << MapPath << GlobalSeed << FixedStepHz << ShotgunNames << ShotgunSeeds << SnapshotBytes << FrameCount << FrameBytes;
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Replays") / FString::Printf(TEXT("%s_%s.capreplay"),
+		*FPackageName::GetShortName(MapPath), *FDateTime::Now().ToString());
+	FFileHelper::SaveArrayToFile(FileBytes, *FilePath);
+
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Replay: saved %d frames (%d bytes) to %s, recording cost %.4f ms per frame"),
+		FrameCount, FileBytes.Num(), *FilePath, FrameCount > 0 ? FPlatformTime::ToMilliseconds64(RecordCycles) / FrameCount : 0.0);
+}
+
+void UCapstoneReplaySubsystem::RecordFrame(APlayerCharacter* Player, float DeltaTime)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	FInputActionValue Values[(int32)ECapstoneInput::Count];
+	uint16 ActiveMask = 0;
+	for (int32 Index = 0; Index < (int32)ECapstoneInput::Count; Index++)
+	{
+		Values[Index] = FCapstoneInputDriver::GetActionValue(Player, (ECapstoneInput)Index);
+		if (Values[Index].IsNonZero())
+			ActiveMask |= 1 << Index;
+	}
+
+	FMemoryWriter Writer(FrameBytes, false, true);
+	uint32 SyncHash = GetSyncHash(Player->GetWorld(), Player);
+	Writer << DeltaTime << SyncHash << ActiveMask;
+
+	for (int32 Index = 0; Index < (int32)ECapstoneInput::Count; Index++)
+	{
+		if (!(ActiveMask & (1 << Index)))
+			continue;
+
+		uint8 ValueType = (uint8)Values[Index].GetValueType();
+		Writer << ValueType;
+
+		const FVector Axis = Values[Index].Get<FVector>();
+		for (int32 AxisIndex = 0; AxisIndex < GetStoredAxisCount((EInputActionValueType)ValueType); AxisIndex++)
+		{
+			float AxisValue = Axis[AxisIndex];
+			Writer << AxisValue;
+		}
+	}
+
+	FrameCount++;
+	RecordCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+bool UCapstoneReplaySubsystem::LoadReplay(const FString& FilePath)
+{
+	TArray<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+	{
+		UE_LOG(LogCapstonePerformance, Error, TEXT("Replay: could not read %s"), *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(FileBytes);
+	uint32 Magic = 0;
+	uint8 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != REPLAY_MAGIC || Version != REPLAY_VERSION)
+	{
+		UE_LOG(LogCapstonePerformance, Error, TEXT("Replay: %s is not a version %d replay"), *FilePath, REPLAY_VERSION);
+		return false;
+	}
+
+	Reader << MapPath << GlobalSeed << FixedStepHz << ShotgunNames << ShotgunSeeds << SnapshotBytes << FrameCount << FrameBytes;
+	return !Reader.IsError();
+}
+
+void UCapstoneReplaySubsystem::StartReplay(UWorld* World)
+{
+	FGameplaySnapshot Snapshot;
+	if (Snapshot.FromBytes(SnapshotBytes))
+		Snapshot.Apply(World);
+	FFixedStepClock::ResetAll();
+	FFixedStepClock::SetFixedStepHz(FixedStepHz);
+
+	for (TActorIterator<AShotgunWeapon> It(World); It; ++It)
+	{
+		const int32 Index = ShotgunNames.IndexOfByKey(It->GetFName());
+		if (Index != INDEX_NONE)
+			It->SetSpreadSeed(ShotgunSeeds[Index]);
+	}
+
+	FMath::RandInit(GlobalSeed);
+	FMath::SRandInit(GlobalSeed);
+
+	bReplayPending = false;
+	bReplaying = true;
+	ReplayFrameIndex = 0;
+	FrameReadOffset = 0;
+	PreviousActiveMask = 0;
+	FirstDesyncFrame = INDEX_NONE;
+	FrameSampler.Reset();
+
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Replay: replaying %d frames of %s"), FrameCount, *MapPath);
+
+	if (APlayerCharacter* Player = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0)))
+		ReplayFrame(World, Player);
+}
+
+void UCapstoneReplaySubsystem::ReplayFrame(UWorld* World, APlayerCharacter* Player)
+{
+	// The frame that just ran used the previous entry, it has to end in the state that was recorded.
+	if (ReplayFrameIndex > 0)
+	{
+		FrameSampler.SampleFrame(HITCH_THRESHOLD_MS);
+		if (FirstDesyncFrame == INDEX_NONE && GetSyncHash(World, Player) != ExpectedSyncHash)
+		{
+			FirstDesyncFrame = ReplayFrameIndex - 1;
+			UE_LOG(LogCapstonePerformance, Warning, TEXT("Replay: desynced at frame %d"), FirstDesyncFrame);
+		}
+	}
+
+	if (ReplayFrameIndex >= FrameCount)
+	{
+		FinishReplay();
+		return;
+	}
+
+	FMemoryReader Reader(FrameBytes);
+	Reader.Seek(FrameReadOffset);
+
+	float DeltaTime = 0;
+	uint16 ActiveMask = 0;
+	Reader << DeltaTime << ExpectedSyncHash << ActiveMask;
+
+	for (int32 Index = 0; Index < (int32)ECapstoneInput::Count; Index++)
+	{
+		const ECapstoneInput Input = (ECapstoneInput)Index;
+		if (ActiveMask & (1 << Index))
+		{
+			uint8 ValueType = 0;
+			Reader << ValueType;
+
+			FVector Axis = FVector::ZeroVector;
+			for (int32 AxisIndex = 0; AxisIndex < GetStoredAxisCount((EInputActionValueType)ValueType); AxisIndex++)
+			{
+				float AxisValue = 0;
+				Reader << AxisValue;
+				Axis[AxisIndex] = AxisValue;
+			}
+			if ((EInputActionValueType)ValueType == EInputActionValueType::Boolean)
+				Axis.X = 1;
+
+			FCapstoneInputDriver::InjectMapped(Player, Input, FInputActionValue((EInputActionValueType)ValueType, Axis));
+		}
+		else if (PreviousActiveMask & (1 << Index))
+		{
+			// One zero value on release, so released triggers fire like they did for the real key.
+			if (const UInputAction* Action = FCapstoneInputDriver::GetInputAction(Player, Input))
+				FCapstoneInputDriver::InjectMapped(Player, Input, FInputActionValue(Action->ValueType, FVector::ZeroVector));
+		}
+	}
+
+	FrameReadOffset = Reader.Tell();
+	PreviousActiveMask = ActiveMask;
+	FApp::SetFixedDeltaTime(DeltaTime);
+	ReplayFrameIndex++;
+}
+
+void UCapstoneReplaySubsystem::FinishReplay()
+{
+	bReplaying = false;
+	FApp::SetUseFixedTimeStep(false);
+
+	if (ReplayFrameIndex < FrameCount)
+		UE_LOG(LogCapstonePerformance, Warning, TEXT("Replay: stopped after %d of %d frames"), ReplayFrameIndex, FrameCount);
+
+	const bool bPassed = FCapstoneFrameSampler::ReportResult(FrameSampler.BuildResult(TEXT("Replay_") + ReplayName), REGRESSION_THRESHOLD);
+	if (FirstDesyncFrame != INDEX_NONE)
+		UE_LOG(LogCapstonePerformance, Error, TEXT("Replay: %s desynced at frame %d, timings past that point are not comparable"), *ReplayName, FirstDesyncFrame);
+
+	FPlatformMisc::RequestExitWithStatus(false, FirstDesyncFrame != INDEX_NONE ? 2 : (bPassed ? 0 : 1));
+}
+
+uint32 UCapstoneReplaySubsystem::GetSyncHash(UWorld* World, const APlayerCharacter* Player)
+{
+	TArray<int32, TInlineAllocator<8>> State;
+
+	// Rounded to whole units so tiny float differences between machines don't count as a desync.
+	const FVector Location = Player->GetActorLocation();
+	State.Add(FMath::RoundToInt(Location.X));
+	State.Add(FMath::RoundToInt(Location.Y));
+	State.Add(FMath::RoundToInt(Location.Z));
+	State.Add(FMath::RoundToInt(Player->GetControlRotation().Yaw));
+
+	for (TActorIterator<AShotgunWeapon> It(World); It; ++It)
+		State.Add(It->GetSpreadState());
+
+	return FCrc::MemCrc32(State.GetData(), State.Num() * sizeof(int32));
+}
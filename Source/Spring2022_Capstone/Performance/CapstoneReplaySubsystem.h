@@ -0,0 +1,107 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "CapstoneBenchmarkSubsystem.h"
+#include "CapstoneReplaySubsystem.generated.h"
+
+class APlayerCharacter;
+
+/**
+ * Records a play session as a compact per-frame stream and replays it deterministically.
+ *
+ * A recording starts with a gameplay snapshot, the fixed step rate and the random seeds (global and the shotgun spread streams),
+ * followed by one entry per frame: the frame's delta time, the player's actuated input action values and a
+ * hash of the player transform and spread stream state used to spot desyncs on replay.
+ *
+ * Record: Capstone.Record in the console, or launch with -CapstoneRecord. Files go to Saved/Replays.
+ * Replay: Spring2022_Capstone Level -game -nullrhi -unattended -CapstoneReplay=<file> [-UpdateBaseline]
+ *
+ * The replay steps the game with the recorded delta times in fixed timestep mode and is reported like a
+ * benchmark map (Saved/Benchmark/Replay_<file>.json against Benchmark/Baselines), then exits with
+ * 0 on success, 1 on a regression and 2 when the replay desynced or could not be loaded.
+ * Recording only captures the starting snapshot, the session being played is left alone. A replay applies it in
+ * place first, which restarts the enemies' behavior trees, so AI that was mid-action when recording started can
+ * desync earlier than the player does.
+ * Pausing ends a recording, and a replay ends when it reaches a pause (for example the defeat screen).
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UCapstoneReplaySubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !IsTemplate() && (bRecording || bRecordOnBeginPlay || bReplayPending || bReplaying); }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	UFUNCTION(BlueprintCallable, Category = "Replay")
+	void StartRecording();
+
+	/**
+	 * @brief Stops the current recording and writes it to Saved/Replays.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replay")
+	void StopRecording();
+
+	UFUNCTION(BlueprintPure, Category = "Replay")
+	bool IsRecording() const { return bRecording; }
+
+	UFUNCTION(BlueprintPure, Category = "Replay")
+	bool IsReplaying() const { return bReplaying; }
+
+private:
+	void RecordFrame(APlayerCharacter* Player, float DeltaTime);
+	bool LoadReplay(const FString& FilePath);
+	void StartReplay(UWorld* World);
+	void ReplayFrame(UWorld* World, APlayerCharacter* Player);
+	void FinishReplay();
+
+	// Hash of the state a replay has to reproduce, compared frame by frame.
+	static uint32 GetSyncHash(UWorld* World, const APlayerCharacter* Player);
+
+	bool bRecording = false;
+	bool bRecordOnBeginPlay = false;
+	bool bReplayPending = false;
+	bool bReplayMapRequested = false;
+	bool bReplaying = false;
+
+	// World the recording was started in, the recording stops when it changes.
+	TWeakObjectPtr<UWorld> RecordingWorld;
+
+	// Recording or loaded replay.
+	FString MapPath;
+	int32 GlobalSeed = 0;
+	int32 FixedStepHz = 0;
+	TArray<FName> ShotgunNames;
+	TArray<int32> ShotgunSeeds;
+	TArray<uint8> SnapshotBytes;
+	TArray<uint8> FrameBytes;
+	int32 FrameCount = 0;
+
+	// Replay progress.
+	FString ReplayName;
+	int32 ReplayFrameIndex = 0;
+	int64 FrameReadOffset = 0;
+	uint32 ExpectedSyncHash = 0;
+	uint16 PreviousActiveMask = 0;
+	int32 FirstDesyncFrame = INDEX_NONE;
+	FCapstoneFrameSampler FrameSampler;
+
+	// Time spent recording, logged when the recording stops.
+	uint64 RecordCycles = 0;
+
+/// Const Variables ///
+	const uint32 REPLAY_MAGIC = 0x4C505243;		// "CRPL"
+	const uint8 REPLAY_VERSION = 2;				// Bump when the file layout changes.
+	const float HITCH_THRESHOLD_MS = 50.f;		// Replayed frames longer than this count as hitches.
+	const float REGRESSION_THRESHOLD = 0.1f;	// Fraction a replay metric may grow over its baseline.
+};
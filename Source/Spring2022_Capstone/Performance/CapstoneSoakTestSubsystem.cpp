@@ -0,0 +1,339 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneSoakTestSubsystem.h"
+#include "CapstoneChurnTracker.h"
+#include "CapstoneInputDriver.h"
+#include "CapstoneMemoryBudgetSubsystem.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Kismet/GameplayStatics.h"
+#include "UObject/UObjectIterator.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+#include "Spring2022_Capstone/Spring2022_CapstoneGameModeBase.h"
+#include "Spring2022_Capstone/Enemies/RangedEnemy.h"
+#include "Spring2022_Capstone/Player/GrappleComponent.h"
+#include "Spring2022_Capstone/Player/PlayerCharacter.h"
+#include "Spring2022_Capstone/UI/Notifications/NotificationUIManager.h"
+#include "Spring2022_Capstone/Weapon/RecoilComponent.h"
+#include "Spring2022_Capstone/Weapon/WeaponBase.h"
+
+namespace
+{
+	FString GetOutputDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Soak");
+	}
+
+	const TCHAR* TIMER_HANDLES_METRIC = TEXT("SetTimerHandles");
+}
+
+bool UCapstoneSoakTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("CapstoneSoak")) && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UCapstoneSoakTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("SoakMinutes="), SoakMinutes);
+	int32 Seed = 0;
+	FParse::Value(FCommandLine::Get(), TEXT("SoakSeed="), Seed);
+	Random.Initialize(Seed);
+
+	SamplesWriter = IFileManager::Get().CreateFileWriter(*(GetOutputDir() / TEXT("SoakSamples.csv")));
+	WriteLine(TEXT("Sample,ElapsedSeconds,Metric,Value"));
+
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Soak: running for %.0f minutes, seed %d"), SoakMinutes, Seed);
+}
+
+void UCapstoneSoakTestSubsystem::Deinitialize()
+{
+	delete SamplesWriter;
+	SamplesWriter = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UCapstoneSoakTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCapstoneSoakTestSubsystem, STATGROUP_Tickables);
+}
+
+void UCapstoneSoakTestSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World || !World->HasBegunPlay())
+	{
+		return;
+	}
+
+	// The defeat screen pauses the game, retrying also runs the snapshot restore path.
+	if (UGameplayStatics::IsGamePaused(World))
+	{
+		if (ASpring2022_CapstoneGameModeBase* GameMode = Cast<ASpring2022_CapstoneGameModeBase>(World->GetAuthGameMode()))
+			GameMode->RetryLevel();
+		return;
+	}
+
+	ElapsedTime += DeltaTime;
+	TimeSinceSample += DeltaTime;
+	if (SampleIndex == 0 || TimeSinceSample >= SampleInterval)
+	{
+		TimeSinceSample = 0;
+		TakeSample();
+	}
+
+	if (ElapsedTime >= SoakMinutes * 60.f)
+	{
+		Finish();
+		return;
+	}
+
+	APlayerCharacter* Player = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0));
+	if (!Player || !Player->GetController())
+	{
+		return;
+	}
+
+	BehaviourTimeLeft -= DeltaTime;
+	if (BehaviourTimeLeft <= 0)
+	{
+		EndBehaviour(Player);
+		PickBehaviour(Player);
+	}
+	TickBehaviour(Player);
+	BehaviourFrame++;
+}
+
+void UCapstoneSoakTestSubsystem::PickBehaviour(APlayerCharacter* Player)
+{
+	Behaviour = (EBehaviour)Random.RandRange(0, (int32)EBehaviour::Count - 1);
+	BehaviourTimeLeft = Random.FRandRange(MIN_BEHAVIOUR_TIME, MAX_BEHAVIOUR_TIME);
+	BehaviourFrame = 0;
+
+	// Dash only reads one axis, so keep directions on the axes.
+	static const FVector2D DIRECTIONS[] = { FVector2D(0, 1), FVector2D(0, -1), FVector2D(1, 0), FVector2D(-1, 0) };
+	BehaviourDirection = DIRECTIONS[Random.RandRange(0, UE_ARRAY_COUNT(DIRECTIONS) - 1)];
+}
+
+void UCapstoneSoakTestSubsystem::TickBehaviour(APlayerCharacter* Player)
+{
+	switch (Behaviour)
+	{
+	case EBehaviour::Move:
+		FCapstoneInputDriver::Inject(Player, ECapstoneInput::Move, FInputActionValue(BehaviourDirection));
+		break;
+
+	case EBehaviour::Look:
+		FCapstoneInputDriver::Inject(Player, ECapstoneInput::Look, FInputActionValue(FVector2D(BehaviourDirection.X + BehaviourDirection.Y, 0.1f * BehaviourDirection.X)));
+		break;
+
+	case EBehaviour::Fire:
+		FCapstoneInputDriver::Inject(Player, ECapstoneInput::Attack, FInputActionValue(true));
+		break;
+
+	case EBehaviour::SwitchWeapon:
+		// Switching happens when the button is released, so press for a single frame.
+		if (BehaviourFrame == 0)
+			FCapstoneInputDriver::Inject(Player, ECapstoneInput::SwitchWeapon, FInputActionValue(true));
+		break;
+
+	case EBehaviour::Dash:
+		// Dash is a double tap of the same direction.
+		if (BehaviourFrame == 0 || BehaviourFrame == 3)
+			FCapstoneInputDriver::Inject(Player, ECapstoneInput::Dash, FInputActionValue(BehaviourDirection));
+		break;
+
+	case EBehaviour::Grapple:
+		FCapstoneInputDriver::Inject(Player, ECapstoneInput::Grapple, FInputActionValue(true));
+		break;
+
+	case EBehaviour::Crouch:
+		FCapstoneInputDriver::Inject(Player, ECapstoneInput::Crouch, FInputActionValue(true));
+		break;
+
+	case EBehaviour::Jump:
+		// Moving while jumping lets the jump turn into a mantle next to ledges.
+		FCapstoneInputDriver::Inject(Player, ECapstoneInput::Move, FInputActionValue(FVector2D(0, 1)));
+		if (BehaviourFrame % 30 == 0)
+			FCapstoneInputDriver::Inject(Player, ECapstoneInput::Jump, FInputActionValue(true));
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UCapstoneSoakTestSubsystem::EndBehaviour(APlayerCharacter* Player)
+{
+	// Releases aren't sent by an injected value that stops, undo the held abilities directly.
+	if (Behaviour == EBehaviour::Grapple)
+		Player->GetGrappleComponent()->CancelGrapple(false);
+	else if (Behaviour == EBehaviour::Crouch)
+		Player->UnCrouch();
+}
+
+void UCapstoneSoakTestSubsystem::TakeSample()
+{
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	RecordValue(TEXT("UsedPhysicalMB"), MemoryStats.UsedPhysical / (1024.0 * 1024.0));
+	RecordValue(TEXT("UsedVirtualMB"), MemoryStats.UsedVirtual / (1024.0 * 1024.0));
+	RecordValue(TEXT("UObjects"), GUObjectArray.GetObjectArrayNumMinusAvailable());
+
+	if (UWorld* World = GetGameInstance()->GetWorld())
+		RecordValue(TIMER_HANDLES_METRIC, CountSetTimerHandles(World));
+
+	UCapstoneMemoryBudgetSubsystem* Budgets = GetGameInstance()->GetSubsystem<UCapstoneMemoryBudgetSubsystem>();
+	if (Budgets && FCapstoneMemoryTags::IsTracking())
+	{
+		Budgets->SampleTags();
+		for (int32 Index = 0; Index < (int32)ECapstoneMemoryTag::Count; Index++)
+			RecordValue(FString(TEXT("MemoryTagMB:")) + FCapstoneMemoryTags::GetTagName((ECapstoneMemoryTag)Index), Budgets->GetCurrentMB((ECapstoneMemoryTag)Index));
+	}
+
+	TMap<const UClass*, int32> ClassCounts;
+	for (TObjectIterator<UObject> It; It; ++It)
+		ClassCounts.FindOrAdd(It->GetClass())++;
+
+	for (const TPair<const UClass*, int32>& ClassCount : ClassCounts)
+	{
+		const FString Metric = TEXT("Class:") + ClassCount.Key->GetName();
+		if (ClassCount.Value >= MinClassInstances || History.Contains(Metric))
+			RecordValue(Metric, ClassCount.Value);
+	}
+
+	// Tracked classes with no live instances left still get a sample.
+	TArray<FString> MissingMetrics;
+	for (const TPair<FString, TArray<double>>& Entry : History)
+	{
+		if (Entry.Value.Num() <= SampleIndex)
+			MissingMetrics.Add(Entry.Key);
+	}
+	for (const FString& Metric : MissingMetrics)
+		RecordValue(Metric, 0);
+
+	if (SamplesWriter)
+		SamplesWriter->Flush();
+	SampleIndex++;
+}
+
+int32 UCapstoneSoakTestSubsystem::CountSetTimerHandles(UWorld* World) const
+{
+	const FTimerManager& TimerManager = World->GetTimerManager();
+	int32 Count = 0;
+	auto CountHandle = [&TimerManager, &Count](const FTimerHandle& Handle)
+	{
+		if (TimerManager.TimerExists(Handle))
+			Count++;
+	};
+
+	for (TActorIterator<APlayerCharacter> It(World); It; ++It)
+	{
+		CountHandle(It->DashCooldownTimerHandle);
+		CountHandle(It->DashDirectionalMovementDelayTimerHandle);
+		CountHandle(It->DashBlurTimerHandle);
+		CountHandle(It->GrappleComponent->CooldownTimerHandle);
+		CountHandle(It->GrappleComponent->MaxGrappleTimerHandle);
+	}
+	for (TActorIterator<AWeaponBase> It(World); It; ++It)
+	{
+		CountHandle(It->FireTimerHandle);
+		CountHandle(It->OverheatTimerHandle);
+		CountHandle(It->ChargeCooldownTimerHandle);
+		if (const URecoilComponent* Recoil = It->FindComponentByClass<URecoilComponent>())
+		{
+			CountHandle(Recoil->FireTimerHandle);
+			CountHandle(Recoil->BackupRecoveryTimer);
+		}
+	}
+	for (TActorIterator<ARangedEnemy> It(World); It; ++It)
+		CountHandle(It->ReloadTimer);
+	for (TActorIterator<ANotificationUIManager> It(World); It; ++It)
+		CountHandle(It->NotificationDisplayTimerHandle);
+	return Count;
+}
+
+void UCapstoneSoakTestSubsystem::RecordValue(const FString& Metric, double Value)
+{
+	TArray<double>& Values = History.FindOrAdd(Metric);
+
+	// Classes that appear late are padded so every series lines up with the sample index.
+	while (Values.Num() < SampleIndex)
+		Values.Add(0);
+	Values.Add(Value);
+
+	WriteLine(FString::Printf(TEXT("%d,%.1f,%s,%.2f"), SampleIndex, ElapsedTime, *Metric, Value));
+}
+
+void UCapstoneSoakTestSubsystem::WriteLine(const FString& Line)
+{
+	if (!SamplesWriter)
+	{
+		return;
+	}
+
+	const FTCHARToUTF8 Utf8Line(*(Line + LINE_TERMINATOR));
+	SamplesWriter->Serialize((void*)Utf8Line.Get(), Utf8Line.Length());
+}
+
+void UCapstoneSoakTestSubsystem::Finish()
+{
+	bFinished = true;
+
+	FString Report = TEXT("Metric,WindowStart,WindowEnd,GrowthPerHour,Flagged") LINE_TERMINATOR;
+	const double WindowHours = FMath::Max(1, MONOTONIC_WINDOW - 1) * SampleInterval / 3600.0;
+	int32 FlaggedCount = 0;
+
+	for (const TPair<FString, TArray<double>>& Entry : History)
+	{
+		// Bounded by the actor count, its growth says nothing about leaks.
+		const TArray<double>& Values = Entry.Value;
+		if (Values.Num() < MONOTONIC_WINDOW || Entry.Key == TIMER_HANDLES_METRIC)
+			continue;
+
+		const int32 WindowStart = Values.Num() - MONOTONIC_WINDOW;
+		bool bNeverShrank = true;
+		for (int32 Index = WindowStart + 1; Index < Values.Num() && bNeverShrank; Index++)
+			bNeverShrank = Values[Index] >= Values[Index - 1];
+
+		const double First = Values[WindowStart];
+		const double Last = Values.Last();
+		const bool bFlagged = bNeverShrank && Last - First > FMath::Max(1.0, First * MIN_GROWTH_FRACTION);
+		if (bFlagged)
+		{
+			FlaggedCount++;
+			UE_LOG(LogCapstonePerformance, Warning, TEXT("Soak: %s grew every sample from %.2f to %.2f"), *Entry.Key, First, Last);
+		}
+
+		Report += FString::Printf(TEXT("%s,%.2f,%.2f,%.2f,%d") LINE_TERMINATOR, *Entry.Key, First, Last, (Last - First) / WindowHours, bFlagged ? 1 : 0);
+	}
+
+	FFileHelper::SaveStringToFile(Report, *(GetOutputDir() / TEXT("SoakReport.csv")));
+
+	// High-water marks of the memory tags, only available with -LLM.
+	const UCapstoneMemoryBudgetSubsystem* Budgets = GetGameInstance()->GetSubsystem<UCapstoneMemoryBudgetSubsystem>();
+	if (Budgets && FCapstoneMemoryTags::IsTracking())
+	{
+		FString TagReport = TEXT("Tag,HighWaterMB,BudgetMB") LINE_TERMINATOR;
+		for (int32 Index = 0; Index < (int32)ECapstoneMemoryTag::Count; Index++)
+		{
+			const ECapstoneMemoryTag Tag = (ECapstoneMemoryTag)Index;
+			TagReport += FString::Printf(TEXT("%s,%.2f,%.2f") LINE_TERMINATOR, FCapstoneMemoryTags::GetTagName(Tag), Budgets->GetHighWaterMB(Tag), Budgets->GetBudgetMB(Tag));
+			UE_LOG(LogCapstonePerformance, Display, TEXT("Soak: %s memory high-water %.2f MB (budget %.2f MB)"), FCapstoneMemoryTags::GetTagName(Tag), Budgets->GetHighWaterMB(Tag), Budgets->GetBudgetMB(Tag));
+		}
+		FFileHelper::SaveStringToFile(TagReport, *(GetOutputDir() / TEXT("SoakMemoryTags.csv")));
+	}
+
+	// Steady spawning and destroying doesn't grow any value above, but still costs GC time.
+	for (const FCapstoneChurnEntry& Entry : FCapstoneChurnTracker::GetTopClasses(CHURN_REPORT_CLASSES))
+	{
+		UE_LOG(LogCapstonePerformance, Display, TEXT("Soak: %s churn over the last minute %d spawns, %d destroys, %d widgets"), *Entry.ClassName.ToString(),
+			Entry.PerMinute[(int32)ECapstoneChurn::Spawn], Entry.PerMinute[(int32)ECapstoneChurn::Destroy], Entry.PerMinute[(int32)ECapstoneChurn::Widget]);
+	}
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Soak: finished after %d samples, %d values flagged"), SampleIndex, FlaggedCount);
+
+	FPlatformMisc::RequestExitWithStatus(false, FlaggedCount > 0 ? 1 : 0);
+}
@@ -0,0 +1,93 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "CapstoneSoakTestSubsystem.generated.h"
+
+class APlayerCharacter;
+
+/**
+ * Long running soak test. Only created when the game is launched with -CapstoneSoak.
+ *
+ * A bot plays the current map through the player's real input actions (move, look, fire, switch weapon,
+ * dash, grapple, crouch and jump) and retries whenever it dies. Every SampleInterval seconds it records
+ * memory, UObject counts per class and how many of the game's own timer handles are set to
+ * Saved/Soak/SoakSamples.csv. At the end, any memory or UObject value that grew over the whole of its last
+ * MONOTONIC_WINDOW samples is flagged in Saved/Soak/SoakReport.csv and the log, and the process exits with 1.
+ *
+ * Example: Spring2022_Capstone Level -game -nullrhi -unattended -CapstoneSoak -SoakMinutes=240 [-SoakSeed=7]
+ */
+UCLASS(Config = Game)
+class SPRING2022_CAPSTONE_API UCapstoneSoakTestSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !IsTemplate() && !bFinished; }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+private:
+	// What the bot is doing, picked at random when the previous behaviour runs out.
+	enum class EBehaviour : uint8 { Move, Look, Fire, SwitchWeapon, Dash, Grapple, Crouch, Jump, Count };
+
+	void PickBehaviour(APlayerCharacter* Player);
+	void TickBehaviour(APlayerCharacter* Player);
+	void EndBehaviour(APlayerCharacter* Player);
+
+	void TakeSample();
+
+	/**
+	 * @brief Counts the game's own C++ timer handles that have a timer set. Each handle holds at most one timer, so
+	 * this follows the actor count rather than showing leaked timers, and Blueprint, engine and lambda timers
+	 * aren't seen. It is recorded for context and never flagged.
+	 */
+	int32 CountSetTimerHandles(UWorld* World) const;
+	void RecordValue(const FString& Metric, double Value);
+	void WriteLine(const FString& Line);
+	void Finish();
+
+	// Total soak length, overridable with -SoakMinutes=.
+	UPROPERTY(Config)
+	float SoakMinutes = 120.f;
+
+	// Seconds between samples.
+	UPROPERTY(Config)
+	float SampleInterval = 30.f;
+
+	// UObject classes with fewer live instances than this are left out of the samples until they grow.
+	UPROPERTY(Config)
+	int32 MinClassInstances = 20;
+
+	FRandomStream Random;
+	bool bFinished = false;
+	float ElapsedTime = 0;
+	float TimeSinceSample = 0;
+	int32 SampleIndex = 0;
+
+	EBehaviour Behaviour = EBehaviour::Look;
+	float BehaviourTimeLeft = 0;
+	int32 BehaviourFrame = 0;
+	FVector2D BehaviourDirection = FVector2D::ZeroVector;
+
+	// Values of every recorded metric in sample order, a class stays tracked once it was recorded.
+	TMap<FString, TArray<double>> History;
+
+	FArchive* SamplesWriter = nullptr;
+
+/// Const Variables ///
+	const int32 MONOTONIC_WINDOW = 10;				// Samples a value has to keep growing over to be flagged.
+	const double MIN_GROWTH_FRACTION = 0.02;		// Growth across the window smaller than this fraction is ignored.
+	const float MIN_BEHAVIOUR_TIME = 0.5f;			// Shortest time a behaviour runs for.
+	const float MAX_BEHAVIOUR_TIME = 3.f;			// Longest time a behaviour runs for.
+	const int32 CHURN_REPORT_CLASSES = 10;			// Classes with the most churn logged at the end.
+};
@@ -0,0 +1,145 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneStats.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "UObject/UObjectArray.h"
+
+DEFINE_STAT(STAT_CapstoneWeaponShoot);
+DEFINE_STAT(STAT_CapstoneRecoilTick);
+DEFINE_STAT(STAT_CapstoneGrappleTick);
+DEFINE_STAT(STAT_CapstoneGrappleFire);
+DEFINE_STAT(STAT_CapstoneMantleAttempt);
+DEFINE_STAT(STAT_CapstoneMantleTick);
+DEFINE_STAT(STAT_CapstonePlayerTick);
+DEFINE_STAT(STAT_CapstonePlayerDash);
+DEFINE_STAT(STAT_CapstonePlayerMove);
+DEFINE_STAT(STAT_CapstonePlayerLook);
+DEFINE_STAT(STAT_CapstoneEnemyTick);
+DEFINE_STAT(STAT_CapstoneEnemyAttack);
+DEFINE_STAT(STAT_CapstoneEnemyBehavior);
+DEFINE_STAT(STAT_CapstoneEnemyProjectiles);
+DEFINE_STAT(STAT_CapstoneHUDTick);
+DEFINE_STAT(STAT_CapstoneDamageIndicatorTick);
+DEFINE_STAT(STAT_CapstoneDamage);
+DEFINE_STAT(STAT_CapstoneSceneQueries);
+DEFINE_STAT(STAT_CapstoneActorSpawns);
+DEFINE_STAT(STAT_CapstoneWidgetCreations);
+DEFINE_STAT(STAT_CapstoneLineOfSightTraces);
+DEFINE_STAT(STAT_CapstoneEnvQueries);
+DEFINE_STAT(STAT_CapstonePathSearches);
+
+uint64 FCapstoneSubsystemCosts::CurrentFrameCycles[(int32)ECapstoneSubsystem::Count] = {};
+uint64 FCapstoneSubsystemCosts::LastFrameCycles[(int32)ECapstoneSubsystem::Count] = {};
+
+void FCapstoneSubsystemCosts::AddCycles(ECapstoneSubsystem Subsystem, uint64 Cycles)
+{
+	check(IsInGameThread());
+	CurrentFrameCycles[(int32)Subsystem] += Cycles;
+}
+
+void FCapstoneSubsystemCosts::EndFrame()
+{
+	for (int32 Index = 0; Index < (int32)ECapstoneSubsystem::Count; Index++)
+	{
+		LastFrameCycles[Index] = CurrentFrameCycles[Index];
+		CurrentFrameCycles[Index] = 0;
+	}
+}
+
+float FCapstoneSubsystemCosts::GetLastFrameMs(ECapstoneSubsystem Subsystem)
+{
+	return FPlatformTime::ToMilliseconds64(LastFrameCycles[(int32)Subsystem]);
+}
+
+const TCHAR* FCapstoneSubsystemCosts::GetSubsystemName(ECapstoneSubsystem Subsystem)
+{
+	switch (Subsystem)
+	{
+	case ECapstoneSubsystem::Weapons:	return TEXT("Weapons");
+	case ECapstoneSubsystem::Grapple:	return TEXT("Grapple");
+	case ECapstoneSubsystem::Mantle:	return TEXT("Mantle");
+	case ECapstoneSubsystem::Player:	return TEXT("Player");
+	case ECapstoneSubsystem::AI:		return TEXT("AI");
+	case ECapstoneSubsystem::UI:		return TEXT("UI");
+	default:							return TEXT("Unknown");
+	}
+}
+
+FCapstoneFrameCounters::FCounts FCapstoneFrameCounters::CurrentFrame;
+FCapstoneFrameCounters::FCounts FCapstoneFrameCounters::LastFrame;
+int32 FCapstoneFrameCounters::TotalWidgetCreations = 0;
+
+/**
+ * Counts widget creations as they are constructed. CreateWidget has no engine delegate, and this
+ * also catches widgets created from Blueprint.
+ */
+class FCapstoneObjectListener : public FUObjectArray::FUObjectCreateListener
+{
+public:
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+	{
+		if (IsInGameThread() && Object->GetClass()->IsChildOf(UUserWidget::StaticClass()))
+		{
+			INC_DWORD_STAT(STAT_CapstoneWidgetCreations);
+			FCapstoneFrameCounters::CurrentFrame.WidgetCreations++;
+			FCapstoneFrameCounters::TotalWidgetCreations++;
+		}
+	}
+
+	virtual void OnUObjectArrayShutdown() override
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+	}
+
+	void OnWorldInitialized(UWorld* World, const UWorld::InitializationValues)
+	{
+		SpawnedHandles.Add(World, World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateLambda([](AActor*)
+		{
+			INC_DWORD_STAT(STAT_CapstoneActorSpawns);
+			FCapstoneFrameCounters::CurrentFrame.ActorSpawns++;
+		})));
+	}
+
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+	{
+		FDelegateHandle Handle;
+		if (SpawnedHandles.RemoveAndCopyValue(World, Handle))
+			World->RemoveOnActorSpawnedHandler(Handle);
+	}
+
+	FDelegateHandle WorldInitializedHandle;
+	FDelegateHandle WorldCleanupHandle;
+
+private:
+	TMap<UWorld*, FDelegateHandle> SpawnedHandles;
+};
+
+static FCapstoneObjectListener GCapstoneObjectListener;
+
+void FCapstoneFrameCounters::AddSceneQueries(int32 Count)
+{
+	check(IsInGameThread());
+	CurrentFrame.SceneQueries += Count;
+}
+
+void FCapstoneFrameCounters::Startup()
+{
+	GUObjectArray.AddUObjectCreateListener(&GCapstoneObjectListener);
+	GCapstoneObjectListener.WorldInitializedHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(&GCapstoneObjectListener, &FCapstoneObjectListener::OnWorldInitialized);
+	GCapstoneObjectListener.WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(&GCapstoneObjectListener, &FCapstoneObjectListener::OnWorldCleanup);
+}
+
+void FCapstoneFrameCounters::Shutdown()
+{
+	FWorldDelegates::OnPostWorldInitialization.Remove(GCapstoneObjectListener.WorldInitializedHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(GCapstoneObjectListener.WorldCleanupHandle);
+	GUObjectArray.RemoveUObjectCreateListener(&GCapstoneObjectListener);
+}
+
+void FCapstoneFrameCounters::EndFrame()
+{
+	LastFrame = CurrentFrame;
+	CurrentFrame = FCounts();
+}
@@ -0,0 +1,149 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "CapstoneMemoryTags.h"
+
+DECLARE_STATS_GROUP(TEXT("Capstone"), STATGROUP_Capstone, STATCAT_Advanced);
+
+// Hot path scopes, see `stat Capstone` or the CPU track in Unreal Insights.
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon Shoot"), STAT_CapstoneWeaponShoot, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Recoil Tick"), STAT_CapstoneRecoilTick, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grapple Tick"), STAT_CapstoneGrappleTick, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grapple Fire"), STAT_CapstoneGrappleFire, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mantle Attempt"), STAT_CapstoneMantleAttempt, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mantle Tick"), STAT_CapstoneMantleTick, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Tick"), STAT_CapstonePlayerTick, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Dash"), STAT_CapstonePlayerDash, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Move"), STAT_CapstonePlayerMove, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Look"), STAT_CapstonePlayerLook, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Tick"), STAT_CapstoneEnemyTick, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Attack"), STAT_CapstoneEnemyAttack, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Behavior Tree"), STAT_CapstoneEnemyBehavior, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Projectiles"), STAT_CapstoneEnemyProjectiles, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD Widget Tick"), STAT_CapstoneHUDTick, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Indicator Tick"), STAT_CapstoneDamageIndicatorTick, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Dispatch"), STAT_CapstoneDamage, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+
+// Per frame counters, reset every frame.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scene Queries"), STAT_CapstoneSceneQueries, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actor Spawns"), STAT_CapstoneActorSpawns, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widget Creations"), STAT_CapstoneWidgetCreations, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Line Of Sight Traces"), STAT_CapstoneLineOfSightTraces, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Environment Queries"), STAT_CapstoneEnvQueries, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Searches"), STAT_CapstonePathSearches, STATGROUP_Capstone, SPRING2022_CAPSTONE_API);
+
+/**
+ * Gameplay subsystems with their own cost line in the performance overlay.
+ */
+enum class ECapstoneSubsystem : uint8
+{
+	Weapons,
+	Grapple,
+	Mantle,
+	Player,
+	AI,
+	UI,
+	Count
+};
+
+/**
+ * Per frame game thread time spent in each ECapstoneSubsystem. Unlike the stats system this is
+ * available in every build configuration, so the overlay can show it during playtests.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneSubsystemCosts
+{
+	// Adds time to the current frame. Game thread only.
+	static void AddCycles(ECapstoneSubsystem Subsystem, uint64 Cycles);
+
+	// Moves the current frame's totals to the last frame values. Called from FCoreDelegates::OnEndFrame.
+	static void EndFrame();
+
+	static float GetLastFrameMs(ECapstoneSubsystem Subsystem);
+	static const TCHAR* GetSubsystemName(ECapstoneSubsystem Subsystem);
+
+private:
+	static uint64 CurrentFrameCycles[(int32)ECapstoneSubsystem::Count];
+	static uint64 LastFrameCycles[(int32)ECapstoneSubsystem::Count];
+};
+
+/**
+ * Adds the time between construction and destruction to a subsystem's frame cost.
+ */
+struct FCapstoneScopeCost
+{
+	explicit FCapstoneScopeCost(ECapstoneSubsystem InSubsystem)
+		: Subsystem(InSubsystem), StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FCapstoneScopeCost()
+	{
+		FCapstoneSubsystemCosts::AddCycles(Subsystem, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	ECapstoneSubsystem Subsystem;
+	uint64 StartCycles;
+};
+
+#define CAPSTONE_SCOPE_COST(Subsystem) FCapstoneScopeCost PREPROCESSOR_JOIN(CapstoneScopeCost_, __LINE__)(ECapstoneSubsystem::Subsystem)
+
+/**
+ * Per frame counts of work that tends to cause hitches. Available in every build configuration.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneFrameCounters
+{
+	// Counts gameplay line traces and sweeps. Game thread only.
+	static void AddSceneQueries(int32 Count = 1);
+
+	// Hooks actor spawn and widget creation counting. Called from module startup/shutdown.
+	static void Startup();
+	static void Shutdown();
+
+	// Moves the current frame's counts to the last frame values. Called from FCoreDelegates::OnEndFrame.
+	static void EndFrame();
+
+	static int32 GetLastFrameSceneQueries() { return LastFrame.SceneQueries; }
+	static int32 GetLastFrameActorSpawns() { return LastFrame.ActorSpawns; }
+	static int32 GetLastFrameWidgetCreations() { return LastFrame.WidgetCreations; }
+
+	// Widgets created since startup, for the overlay without walking every object.
+	static int32 GetTotalWidgetCreations() { return TotalWidgetCreations; }
+
+private:
+	friend class FCapstoneObjectListener;
+
+	struct FCounts
+	{
+		int32 SceneQueries = 0;
+		int32 ActorSpawns = 0;
+		int32 WidgetCreations = 0;
+	};
+
+	static FCounts CurrentFrame;
+	static FCounts LastFrame;
+	static int32 TotalWidgetCreations;
+};
+
+// Named trace scope and stat for a hot path, without adding to a subsystem's overlay cost. With stats compiled
+// in the cycle counter already emits the CPU trace event, so the trace scope is only used without them.
+#if STATS
+#define CAPSTONE_TRACE_SCOPE(StatName) SCOPE_CYCLE_COUNTER(StatName)
+#else
+#define CAPSTONE_TRACE_SCOPE(StatName) TRACE_CPUPROFILER_EVENT_SCOPE(StatName)
+#endif
+
+// Named trace scope and stat for a hot path, also counted towards Subsystem's cost in the overlay
+// and its allocations towards the subsystem's memory tag.
+#define CAPSTONE_SCOPE(StatName, Subsystem) \
+	CAPSTONE_TRACE_SCOPE(StatName); \
+	CAPSTONE_SCOPE_COST(Subsystem); \
+	CAPSTONE_LLM_SCOPE(PREPROCESSOR_JOIN(CAPSTONE_LLM_TAG_, Subsystem))
+
+#define CAPSTONE_COUNT_SCENE_QUERY() \
+	INC_DWORD_STAT(STAT_CapstoneSceneQueries); \
+	FCapstoneFrameCounters::AddSceneQueries()
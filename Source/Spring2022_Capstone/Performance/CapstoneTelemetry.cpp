@@ -0,0 +1,314 @@
+// Created by Spring2022_Capstone team
+
+
+#include "CapstoneTelemetry.h"
+#include "HAL/FileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "CapstoneMemoryTags.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+#include <atomic>
+
+namespace
+{
+	const uint32 RING_CAPACITY = 4096;			// Events per thread between flushes, must be a power of two.
+	const uint32 FLUSH_INTERVAL_MS = 250;		// How often the writer thread drains the ring buffers.
+	const double RECORD_BUDGET_MS = 0.05;		// Per frame recording cost that is warned about when the session ends.
+
+	struct FTelemetryRecord
+	{
+		double Time;
+		uint64 Frame;
+		FName Source;
+		FName Detail;
+		FVector3f Location;
+		float Value;
+		uint32 Session;
+		ECapstoneTelemetryEvent Event;
+	};
+
+	// Written only by the thread that owns it and read only by the writer thread.
+	struct FTelemetryRingBuffer
+	{
+		FTelemetryRecord Records[RING_CAPACITY];
+		std::atomic<uint32> Head { 0 };				// Next record the owning thread writes.
+		std::atomic<uint32> Tail { 0 };				// Next record the writer thread reads.
+		std::atomic<uint32> Dropped { 0 };
+		std::atomic<uint64> RecordCycles { 0 };
+	};
+
+	std::atomic<bool> bRecording { false };
+
+	// Bumped for every session. An event that passed the recording check just before a session stopped still
+	// carries that session's number, so the next session's writer drops it instead of writing it to its file.
+	std::atomic<uint32> SessionIndex { 0 };
+	double SessionStartTime = 0;
+	uint64 SessionStartFrame = 0;
+
+	// Buffers live until module shutdown so the thread local pointers to them stay valid between sessions.
+	FCriticalSection BuffersLock;
+	TArray<TUniquePtr<FTelemetryRingBuffer>> Buffers;
+	thread_local FTelemetryRingBuffer* ThreadBuffer = nullptr;
+
+	FTelemetryRingBuffer* GetThreadBuffer()
+	{
+		if (!ThreadBuffer)
+		{
+			CAPSTONE_LLM_SCOPE(Capstone_Telemetry);
+			FScopeLock Lock(&BuffersLock);
+			ThreadBuffer = Buffers.Add_GetRef(MakeUnique<FTelemetryRingBuffer>()).Get();
+		}
+		return ThreadBuffer;
+	}
+
+	class FTelemetryWriter : public FRunnable
+	{
+	public:
+		FTelemetryWriter(const FString& InFilePath, uint32 InSession)
+			: FilePath(InFilePath), Session(InSession), WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+		{
+		}
+
+		virtual ~FTelemetryWriter() override
+		{
+			FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		}
+
+		virtual bool Init() override
+		{
+			CAPSTONE_LLM_SCOPE(Capstone_Telemetry);
+			File = IFileManager::Get().CreateFileWriter(*FilePath);
+			WriteLine(TEXT("Time,Frame,Event,Source,Detail,Value,X,Y,Z"));
+			return File != nullptr;
+		}
+
+		virtual uint32 Run() override
+		{
+			CAPSTONE_LLM_SCOPE(Capstone_Telemetry);
+			while (!bStopping)
+			{
+				WakeEvent->Wait(FLUSH_INTERVAL_MS);
+				Drain();
+			}
+			Drain();
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping = true;
+			WakeEvent->Trigger();
+		}
+
+		virtual void Exit() override
+		{
+			delete File;
+			File = nullptr;
+		}
+
+		int64 GetWrittenCount() const { return WrittenCount; }
+		int64 GetDiscardedCount() const { return DiscardedCount; }
+
+	private:
+		void Drain()
+		{
+			FString Lines;
+			{
+				FScopeLock Lock(&BuffersLock);
+				for (const TUniquePtr<FTelemetryRingBuffer>& Buffer : Buffers)
+				{
+					const uint32 Head = Buffer->Head.load(std::memory_order_acquire);
+					uint32 Tail = Buffer->Tail.load(std::memory_order_relaxed);
+					for (; Tail != Head; Tail++)
+					{
+						const FTelemetryRecord& Record = Buffer->Records[Tail & (RING_CAPACITY - 1)];
+						if (Record.Session != Session)
+						{
+							DiscardedCount++;
+							continue;
+						}
+
+						Lines += FString::Printf(TEXT("%.4f,%llu,%s,%s,%s,%.2f,%.1f,%.1f,%.1f") LINE_TERMINATOR,
+							Record.Time, Record.Frame, FCapstoneTelemetry::GetEventName(Record.Event), *Record.Source.ToString(), *Record.Detail.ToString(),
+							Record.Value, Record.Location.X, Record.Location.Y, Record.Location.Z);
+						WrittenCount++;
+					}
+					Buffer->Tail.store(Tail, std::memory_order_release);
+				}
+			}
+
+			if (!Lines.IsEmpty())
+			{
+				WriteLine(Lines, false);
+				File->Flush();
+			}
+		}
+
+		void WriteLine(const FString& Line, bool bAddTerminator = true)
+		{
+			if (!File)
+			{
+				return;
+			}
+
+			const FTCHARToUTF8 Utf8Line(bAddTerminator ? *(Line + LINE_TERMINATOR) : *Line);
+			File->Serialize((void*)Utf8Line.Get(), Utf8Line.Length());
+		}
+
+		FString FilePath;
+		uint32 Session;
+		FArchive* File = nullptr;
+		FEvent* WakeEvent;
+		std::atomic<bool> bStopping { false };
+		int64 WrittenCount = 0;
+		int64 DiscardedCount = 0;
+	};
+
+	FTelemetryWriter* Writer = nullptr;
+	FRunnableThread* WriterThread = nullptr;
+
+	FAutoConsoleCommand TelemetryCommand(
+		TEXT("Capstone.Telemetry"),
+		TEXT("Starts or stops recording gameplay telemetry to Saved/Telemetry."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (FCapstoneTelemetry::IsRecording())
+				FCapstoneTelemetry::StopRecording();
+			else
+				FCapstoneTelemetry::StartRecording();
+		}));
+}
+
+void FCapstoneTelemetry::Record(ECapstoneTelemetryEvent Event, const UObject* Source, float Value, const FVector& Location, FName Detail)
+{
+	// The session is read first, so an event can't be stamped with a session that started after the check.
+	const uint32 Session = SessionIndex.load(std::memory_order_acquire);
+	if (!bRecording.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	FTelemetryRingBuffer* Buffer = GetThreadBuffer();
+
+	const uint32 Head = Buffer->Head.load(std::memory_order_relaxed);
+	if (Head - Buffer->Tail.load(std::memory_order_acquire) >= RING_CAPACITY)
+	{
+		Buffer->Dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	FTelemetryRecord& Record = Buffer->Records[Head & (RING_CAPACITY - 1)];
+	Record.Time = FPlatformTime::Seconds() - SessionStartTime;
+	Record.Frame = GFrameCounter - SessionStartFrame;
+	Record.Source = Source ? Source->GetFName() : NAME_None;
+	Record.Detail = Detail;
+	Record.Location = FVector3f(Location);
+	Record.Value = Value;
+	Record.Session = Session;
+	Record.Event = Event;
+	Buffer->Head.store(Head + 1, std::memory_order_release);
+
+	// Only this thread writes its cycle count, the writer reads it when the session ends.
+	Buffer->RecordCycles.store(Buffer->RecordCycles.load(std::memory_order_relaxed) + FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+}
+
+bool FCapstoneTelemetry::IsRecording()
+{
+	return bRecording.load(std::memory_order_relaxed);
+}
+
+void FCapstoneTelemetry::StartRecording()
+{
+	if (IsRecording())
+	{
+		return;
+	}
+
+	{
+		FScopeLock Lock(&BuffersLock);
+		for (const TUniquePtr<FTelemetryRingBuffer>& Buffer : Buffers)
+		{
+			Buffer->Dropped = 0;
+			Buffer->RecordCycles = 0;
+		}
+	}
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Telemetry") / FString::Printf(TEXT("Telemetry_%s.csv"), *FDateTime::Now().ToString());
+	const uint32 Session = SessionIndex.fetch_add(1, std::memory_order_acq_rel) + 1;
+	Writer = new FTelemetryWriter(FilePath, Session);
+	WriterThread = FRunnableThread::Create(Writer, TEXT("CapstoneTelemetryWriter"), 0, TPri_BelowNormal);
+
+	SessionStartTime = FPlatformTime::Seconds();
+	SessionStartFrame = GFrameCounter;
+	bRecording.store(true, std::memory_order_release);
+
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Telemetry: recording to %s"), *FilePath);
+}
+
+void FCapstoneTelemetry::StopRecording()
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+	bRecording.store(false, std::memory_order_release);
+
+	WriterThread->Kill(true);
+	const int64 WrittenCount = Writer->GetWrittenCount();
+	const int64 DiscardedCount = Writer->GetDiscardedCount();
+	delete WriterThread;
+	delete Writer;
+	WriterThread = nullptr;
+	Writer = nullptr;
+
+	uint32 Dropped = 0;
+	uint64 RecordCycles = 0;
+	{
+		FScopeLock Lock(&BuffersLock);
+		for (const TUniquePtr<FTelemetryRingBuffer>& Buffer : Buffers)
+		{
+			Dropped += Buffer->Dropped;
+			RecordCycles += Buffer->RecordCycles;
+		}
+	}
+
+	const uint64 Frames = FMath::Max<uint64>(1, GFrameCounter - SessionStartFrame);
+	const double MsPerFrame = FPlatformTime::ToMilliseconds64(RecordCycles) / Frames;
+	UE_LOG(LogCapstonePerformance, Display, TEXT("Telemetry: wrote %lld events, dropped %u, discarded %lld from an earlier session, %.4f ms per frame recording"),
+		WrittenCount, Dropped, DiscardedCount, MsPerFrame);
+	if (MsPerFrame > RECORD_BUDGET_MS)
+		UE_LOG(LogCapstonePerformance, Warning, TEXT("Telemetry: recording cost %.4f ms per frame, over the %.2f ms budget"), MsPerFrame, RECORD_BUDGET_MS);
+}
+
+const TCHAR* FCapstoneTelemetry::GetEventName(ECapstoneTelemetryEvent Event)
+{
+	switch (Event)
+	{
+	case ECapstoneTelemetryEvent::ShotFired:		return TEXT("ShotFired");
+	case ECapstoneTelemetryEvent::ShotHit:			return TEXT("ShotHit");
+	case ECapstoneTelemetryEvent::DamageTaken:		return TEXT("DamageTaken");
+	case ECapstoneTelemetryEvent::GrappleFired:		return TEXT("GrappleFired");
+	case ECapstoneTelemetryEvent::GrappleAttached:	return TEXT("GrappleAttached");
+	case ECapstoneTelemetryEvent::GrappleCancelled:	return TEXT("GrappleCancelled");
+	case ECapstoneTelemetryEvent::Dash:				return TEXT("Dash");
+	case ECapstoneTelemetryEvent::Mantle:			return TEXT("Mantle");
+	case ECapstoneTelemetryEvent::PickupCollected:	return TEXT("PickupCollected");
+	case ECapstoneTelemetryEvent::UpgradeApplied:	return TEXT("UpgradeApplied");
+	default:										return TEXT("Unknown");
+	}
+}
+
+void FCapstoneTelemetry::Startup()
+{
+	if (FParse::Param(FCommandLine::Get(), TEXT("CapstoneTelemetry")))
+		StartRecording();
+}
+
+void FCapstoneTelemetry::Shutdown()
+{
+	StopRecording();
+
+	FScopeLock Lock(&BuffersLock);
+	Buffers.Empty();
+}
@@ -0,0 +1,56 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Gameplay events recorded by FCapstoneTelemetry.
+enum class ECapstoneTelemetryEvent : uint8
+{
+	ShotFired,
+	ShotHit,
+	DamageTaken,
+	GrappleFired,
+	GrappleAttached,
+	GrappleCancelled,
+	Dash,
+	Mantle,
+	PickupCollected,
+	UpgradeApplied,
+	Count
+};
+
+/**
+ * Records gameplay events for playtest analysis.
+ *
+ * Record() copies the event into a ring buffer owned by the calling thread, without locks or allocations after
+ * the thread's first event. A background thread drains the buffers a few times a second and appends them to
+ * Saved/Telemetry/Telemetry_<date>.csv, so no file I/O happens on the game thread. Events are dropped and counted
+ * when a buffer is full rather than making the game wait for the writer.
+ *
+ * Off by default, start with -CapstoneTelemetry or toggle with the Capstone.Telemetry console command.
+ */
+struct SPRING2022_CAPSTONE_API FCapstoneTelemetry
+{
+	/**
+	 * @brief Records an event when telemetry is on, safe to call from any thread.
+	 * @param Source Object the event came from, stored by name.
+	 * @param Value Event specific amount, e.g. damage for ShotHit and DamageTaken.
+	 * @param Detail Extra name, e.g. the actor hit or the upgrade applied.
+	 */
+	static void Record(ECapstoneTelemetryEvent Event, const UObject* Source, float Value = 0, const FVector& Location = FVector::ZeroVector, FName Detail = NAME_None);
+
+	static bool IsRecording();
+	static void StartRecording();
+
+	/**
+	 * @brief Stops the writer thread once it wrote everything recorded so far.
+	 */
+	static void StopRecording();
+
+	static const TCHAR* GetEventName(ECapstoneTelemetryEvent Event);
+
+	// Handles -CapstoneTelemetry and frees the ring buffers. Called from module startup/shutdown.
+	static void Startup();
+	static void Shutdown();
+};
@@ -0,0 +1,245 @@
+// Created by Spring2022_Capstone team
+
+
+#include "PerformanceGovernorSubsystem.h"
+#include "CapstoneGameUserSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "Spring2022_Capstone/Spring2022_Capstone.h"
+
+namespace
+{
+	// Scalability groups the governor may lower. GPU bound frames drop the first list, game or render
+	// thread bound frames drop the second since resolution doesn't help there.
+	enum class EGovernedGroup : uint8 { ViewDistance, Shadow, GlobalIllumination, Reflection, PostProcess, Effects, Foliage };
+
+	const EGovernedGroup GPU_BOUND_GROUPS[] = { EGovernedGroup::Shadow, EGovernedGroup::GlobalIllumination, EGovernedGroup::Reflection, EGovernedGroup::PostProcess, EGovernedGroup::Effects };
+	const EGovernedGroup CPU_BOUND_GROUPS[] = { EGovernedGroup::ViewDistance, EGovernedGroup::Foliage, EGovernedGroup::Shadow };
+
+	int32& GetGroupLevel(Scalability::FQualityLevels& Levels, EGovernedGroup Group)
+	{
+		switch (Group)
+		{
+		case EGovernedGroup::ViewDistance:			return Levels.ViewDistanceQuality;
+		case EGovernedGroup::Shadow:				return Levels.ShadowQuality;
+		case EGovernedGroup::GlobalIllumination:	return Levels.GlobalIlluminationQuality;
+		case EGovernedGroup::Reflection:			return Levels.ReflectionQuality;
+		case EGovernedGroup::PostProcess:			return Levels.PostProcessQuality;
+		case EGovernedGroup::Effects:				return Levels.EffectsQuality;
+		default:									return Levels.FoliageQuality;
+		}
+	}
+
+	const TCHAR* GetGroupName(EGovernedGroup Group)
+	{
+		switch (Group)
+		{
+		case EGovernedGroup::ViewDistance:			return TEXT("ViewDistance");
+		case EGovernedGroup::Shadow:				return TEXT("Shadow");
+		case EGovernedGroup::GlobalIllumination:	return TEXT("GlobalIllumination");
+		case EGovernedGroup::Reflection:			return TEXT("Reflection");
+		case EGovernedGroup::PostProcess:			return TEXT("PostProcess");
+		case EGovernedGroup::Effects:				return TEXT("Effects");
+		default:									return TEXT("Foliage");
+		}
+	}
+
+	IConsoleVariable* GetScreenPercentageCVar()
+	{
+		static IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ScreenPercentage"));
+		return CVar;
+	}
+}
+
+void UPerformanceGovernorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Nothing to govern without a renderer (dedicated server, -nullrhi benchmarks).
+	bInitialized = FApp::CanEverRender();
+	UserQualityLevels = Scalability::GetQualityLevels();
+	AppliedQualityLevels = UserQualityLevels;
+	Stats.ScreenPercentage = UserQualityLevels.ResolutionQuality;
+}
+
+void UPerformanceGovernorSubsystem::Deinitialize()
+{
+	ResetAdjustments();
+	bInitialized = false;
+
+	Super::Deinitialize();
+}
+
+TStatId UPerformanceGovernorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPerformanceGovernorSubsystem, STATGROUP_Tickables);
+}
+
+void UPerformanceGovernorSubsystem::Tick(float DeltaTime)
+{
+	SampleFrameTimes(DeltaTime);
+
+	UCapstoneGameUserSettings* Settings = UCapstoneGameUserSettings::GetCapstoneGameUserSettings();
+	if (!Settings || !Settings->IsAdaptivePerformanceEnabled())
+	{
+		if (bAdjusting)
+			ResetAdjustments();
+		return;
+	}
+
+	// Levels changed outside the governor (settings menu, console), take them as the new user levels.
+	const Scalability::FQualityLevels CurrentLevels = Scalability::GetQualityLevels();
+	if (CurrentLevels != AppliedQualityLevels)
+	{
+		UserQualityLevels = CurrentLevels;
+		AppliedQualityLevels = CurrentLevels;
+		Stats.QualityStepsDropped = 0;
+		Stats.ScreenPercentage = UserQualityLevels.ResolutionQuality;
+	}
+
+	bAdjusting = true;
+	Stats.TargetFrameTimeMs = Settings->GetTargetFrameTimeMs();
+
+	AdjustScreenPercentage();
+	AdjustQuality(DeltaTime);
+}
+
+void UPerformanceGovernorSubsystem::SampleFrameTimes(float DeltaTime)
+{
+	const float GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	const float RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	const float GPUMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+
+	Stats.FrameTimeMs = FMath::Lerp(Stats.FrameTimeMs, DeltaTime * 1000.f, SMOOTHING);
+	Stats.GameThreadTimeMs = FMath::Lerp(Stats.GameThreadTimeMs, GameThreadMs, SMOOTHING);
+	Stats.RenderThreadTimeMs = FMath::Lerp(Stats.RenderThreadTimeMs, RenderThreadMs, SMOOTHING);
+	Stats.GPUTimeMs = FMath::Lerp(Stats.GPUTimeMs, GPUMs, SMOOTHING);
+
+	TimeSinceResolutionChange += DeltaTime;
+}
+
+void UPerformanceGovernorSubsystem::AdjustScreenPercentage()
+{
+	if (TimeSinceResolutionChange < RESOLUTION_ADJUST_INTERVAL || Stats.GPUTimeMs <= 0)
+		return;
+
+	UCapstoneGameUserSettings* Settings = UCapstoneGameUserSettings::GetCapstoneGameUserSettings();
+	const float MaxScreenPercentage = UserQualityLevels.ResolutionQuality;
+	const float MinScreenPercentage = FMath::Min(Settings->GetMinScreenPercentage(), MaxScreenPercentage);
+
+	const float Ratio = Stats.TargetFrameTimeMs / Stats.GPUTimeMs;
+	if (FMath::Abs(1.f - Ratio) < BUDGET_TOLERANCE)
+		return;
+
+	// GPU cost scales with pixel count, which scales with the square of the screen percentage.
+	// Only move half way to the estimate so noisy timings don't make the resolution oscillate.
+	const float Estimate = Stats.ScreenPercentage * FMath::Sqrt(Ratio);
+	const float NewScreenPercentage = FMath::Clamp(FMath::Lerp(Stats.ScreenPercentage, Estimate, 0.5f), MinScreenPercentage, MaxScreenPercentage);
+
+	if (!FMath::IsNearlyEqual(NewScreenPercentage, Stats.ScreenPercentage, 1.f))
+		SetScreenPercentage(NewScreenPercentage);
+}
+
+void UPerformanceGovernorSubsystem::AdjustQuality(float DeltaTime)
+{
+	UCapstoneGameUserSettings* Settings = UCapstoneGameUserSettings::GetCapstoneGameUserSettings();
+	const float MinScreenPercentage = FMath::Min(Settings->GetMinScreenPercentage(), (float)UserQualityLevels.ResolutionQuality);
+	const float FrameCostMs = FMath::Max3(Stats.GameThreadTimeMs, Stats.RenderThreadTimeMs, Stats.GPUTimeMs);
+	const bool bGPUBound = Stats.GPUTimeMs >= FMath::Max(Stats.GameThreadTimeMs, Stats.RenderThreadTimeMs);
+
+	// Resolution is the cheaper knob, only touch quality once it can't go lower (or can't help).
+	const bool bResolutionExhausted = !bGPUBound || Stats.ScreenPercentage <= MinScreenPercentage + 1.f;
+	const bool bOverBudget = FrameCostMs > Stats.TargetFrameTimeMs * (1.f + BUDGET_TOLERANCE);
+	const bool bHasHeadroom = FrameCostMs < Stats.TargetFrameTimeMs * QUALITY_RESTORE_HEADROOM
+		&& Stats.ScreenPercentage >= UserQualityLevels.ResolutionQuality - 1.f;
+
+	TimeOverBudget = bOverBudget && bResolutionExhausted ? TimeOverBudget + DeltaTime : 0;
+	TimeUnderBudget = bHasHeadroom && Stats.QualityStepsDropped > 0 ? TimeUnderBudget + DeltaTime : 0;
+
+	Scalability::FQualityLevels Levels = Scalability::GetQualityLevels();
+
+	if (TimeOverBudget > QUALITY_DROP_DELAY)
+	{
+		TimeOverBudget = 0;
+
+		TArrayView<const EGovernedGroup> Groups = bGPUBound ? TArrayView<const EGovernedGroup>(GPU_BOUND_GROUPS) : TArrayView<const EGovernedGroup>(CPU_BOUND_GROUPS);
+		for (int32 Attempt = 0; Attempt < Groups.Num(); Attempt++)
+		{
+			const EGovernedGroup Group = Groups[NextQualityGroup++ % Groups.Num()];
+			int32& Level = GetGroupLevel(Levels, Group);
+			if (Level > 0)
+			{
+				Level--;
+				ApplyQualityLevels(Levels);
+				Stats.QualityStepsDropped++;
+				LogDecision(FString::Printf(TEXT("%s bound at %.1f ms, lowered %s quality to %d"), bGPUBound ? TEXT("GPU") : TEXT("CPU"), FrameCostMs, GetGroupName(Group), Level));
+				break;
+			}
+		}
+	}
+	else if (TimeUnderBudget > QUALITY_RESTORE_DELAY)
+	{
+		TimeUnderBudget = 0;
+
+		// Give levels back in the reverse order of the groups, never above the user's choice.
+		const EGovernedGroup AllGroups[] = { EGovernedGroup::Foliage, EGovernedGroup::Effects, EGovernedGroup::PostProcess, EGovernedGroup::Reflection,
+			EGovernedGroup::GlobalIllumination, EGovernedGroup::Shadow, EGovernedGroup::ViewDistance };
+		for (EGovernedGroup Group : AllGroups)
+		{
+			int32& Level = GetGroupLevel(Levels, Group);
+			if (Level < GetGroupLevel(UserQualityLevels, Group))
+			{
+				Level++;
+				ApplyQualityLevels(Levels);
+				Stats.QualityStepsDropped--;
+				LogDecision(FString::Printf(TEXT("Headroom at %.1f ms, raised %s quality to %d"), FrameCostMs, GetGroupName(Group), Level));
+				break;
+			}
+		}
+	}
+}
+
+void UPerformanceGovernorSubsystem::ResetAdjustments()
+{
+	if (!bAdjusting)
+		return;
+
+	bAdjusting = false;
+	TimeOverBudget = 0;
+	TimeUnderBudget = 0;
+
+	Stats.QualityStepsDropped = 0;
+	ApplyQualityLevels(UserQualityLevels);
+	SetScreenPercentage(UserQualityLevels.ResolutionQuality);
+	LogDecision(TEXT("Restored user resolution and quality"));
+}
+
+void UPerformanceGovernorSubsystem::ApplyQualityLevels(const Scalability::FQualityLevels& Levels)
+{
+	Scalability::SetQualityLevels(Levels);
+	AppliedQualityLevels = Levels;
+
+	// Setting the levels re-applies sg.ResolutionQuality, put the governed screen percentage back.
+	if (IConsoleVariable* CVar = GetScreenPercentageCVar())
+		CVar->Set(Stats.ScreenPercentage, ECVF_SetByScalability);
+}
+
+void UPerformanceGovernorSubsystem::SetScreenPercentage(float NewScreenPercentage)
+{
+	if (IConsoleVariable* CVar = GetScreenPercentageCVar())
+		CVar->Set(NewScreenPercentage, ECVF_SetByScalability);
+
+	UE_LOG(LogCapstonePerformance, Verbose, TEXT("Screen percentage %.0f -> %.0f (GPU %.2f ms, target %.2f ms)"),
+		Stats.ScreenPercentage, NewScreenPercentage, Stats.GPUTimeMs, Stats.TargetFrameTimeMs);
+
+	Stats.ScreenPercentage = NewScreenPercentage;
+	TimeSinceResolutionChange = 0;
+}
+
+void UPerformanceGovernorSubsystem::LogDecision(const FString& Decision)
+{
+	Stats.LastDecision = Decision;
+	UE_LOG(LogCapstonePerformance, Log, TEXT("Governor: %s (game %.2f ms, render %.2f ms, GPU %.2f ms, %.0f%% resolution)"),
+		*Decision, Stats.GameThreadTimeMs, Stats.RenderThreadTimeMs, Stats.GPUTimeMs, Stats.ScreenPercentage);
+}
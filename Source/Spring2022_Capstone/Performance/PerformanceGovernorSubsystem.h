@@ -0,0 +1,104 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "Scalability.h"
+#include "PerformanceGovernorSubsystem.generated.h"
+
+/**
+ * Smoothed frame timings and the current state of the performance governor.
+ */
+USTRUCT(BlueprintType)
+struct FPerformanceGovernorStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	float FrameTimeMs = 0;
+	UPROPERTY(BlueprintReadOnly)
+	float GameThreadTimeMs = 0;
+	UPROPERTY(BlueprintReadOnly)
+	float RenderThreadTimeMs = 0;
+	UPROPERTY(BlueprintReadOnly)
+	float GPUTimeMs = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float TargetFrameTimeMs = 0;
+	UPROPERTY(BlueprintReadOnly)
+	float ScreenPercentage = 100;
+
+	// Number of scalability levels the governor has currently taken away from the user's settings.
+	UPROPERTY(BlueprintReadOnly)
+	int32 QualityStepsDropped = 0;
+
+	// Last change the governor made, for the stats overlay.
+	UPROPERTY(BlueprintReadOnly)
+	FString LastDecision;
+};
+
+/**
+ * Measures game, render and GPU frame times and steers screen percentage and a few scalability
+ * groups towards the target frame time from UCapstoneGameUserSettings.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UPerformanceGovernorSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !IsTemplate() && bInitialized; }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	UFUNCTION(BlueprintPure, Category = "Performance")
+	const FPerformanceGovernorStats& GetStats() const { return Stats; }
+
+	/**
+	 * @brief Gives back every quality level and resolution the governor took away.
+	 * @note Called when adaptive performance is turned off or settings are re-applied.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance")
+	void ResetAdjustments();
+
+private:
+	void SampleFrameTimes(float DeltaTime);
+	void AdjustScreenPercentage();
+	void AdjustQuality(float DeltaTime);
+	void ApplyQualityLevels(const Scalability::FQualityLevels& Levels);
+	void SetScreenPercentage(float NewScreenPercentage);
+	void LogDecision(const FString& Decision);
+
+	FPerformanceGovernorStats Stats;
+
+	// Scalability levels chosen by the user, the governor never goes above these.
+	Scalability::FQualityLevels UserQualityLevels;
+
+	// Scalability levels last set by the governor, used to notice changes made elsewhere.
+	Scalability::FQualityLevels AppliedQualityLevels;
+
+	bool bInitialized = false;
+	bool bAdjusting = false;
+
+	float TimeSinceResolutionChange = 0;
+	float TimeOverBudget = 0;
+	float TimeUnderBudget = 0;
+
+	// Scalability group lowered next, cycles through the groups that cost the most GPU time.
+	int32 NextQualityGroup = 0;
+
+/// Const Variables ///
+	const float SMOOTHING = 0.1f;						// Weight of the newest sample in the frame time moving averages.
+	const float RESOLUTION_ADJUST_INTERVAL = 0.25f;		// Seconds between screen percentage changes, lets the GPU timing catch up.
+	const float BUDGET_TOLERANCE = 0.05f;				// Frame times within this fraction of the target are left alone.
+	const float QUALITY_DROP_DELAY = 2.0f;				// Seconds over budget at minimum resolution before a quality level is dropped.
+	const float QUALITY_RESTORE_DELAY = 5.0f;			// Seconds with headroom at full resolution before a quality level is restored.
+	const float QUALITY_RESTORE_HEADROOM = 0.75f;		// Frame time must be under this fraction of the target to restore quality.
+};
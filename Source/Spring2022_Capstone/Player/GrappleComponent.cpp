@@ -9,6 +9,9 @@
 #include "Components/SphereComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
+#include "Spring2022_Capstone/Performance/CapstoneInputLatency.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+#include "Spring2022_Capstone/Performance/CapstoneTelemetry.h"
 
 UGrappleComponent::UGrappleComponent()
 {
@@ -22,6 +25,7 @@ void UGrappleComponent::BeginPlay()
 
 void UGrappleComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+	CAPSTONE_SCOPE(STAT_CapstoneGrappleTick, Grapple);
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (GrappleState == EGrappleState::Firing && FMath::Abs(FVector::Dist(GetStartLocation(), _GrappleHook->GetActorLocation())) > GrappleRange)
@@ -34,7 +38,10 @@ void UGrappleComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 		{
 			UCharacterMovementComponent *MovementComponent = PlayerCharacter->GetCharacterMovement();
 			FVector ToGrappleHookDirection = GetToGrappleHookDirection();
-			MovementComponent->AddForce(ToGrappleHookDirection * 10000);
+
+			// The pull is applied as impulses of whole steps, the same as AddForce() for one step of the frame's DeltaTime.
+			const int32 Steps = PullClock.Advance(DeltaTime);
+			MovementComponent->AddImpulse(ToGrappleHookDirection * 10000 * Steps * PullClock.GetStepTime());
 			if (FVector::Distance(_GrappleHook->GetActorLocation(), GetOwner()->GetActorLocation()) < 250 ||
 				FVector::DotProduct(InitialHookDirection2D, FVector(ToGrappleHookDirection.X, ToGrappleHookDirection.Y, 0)) < 0)
 			{
@@ -46,8 +53,10 @@ void UGrappleComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 
 void UGrappleComponent::Fire(FVector TargetLocation)
 {
+	CAPSTONE_SCOPE(STAT_CapstoneGrappleFire, Grapple);
 	OnGrappleActivatedDelegate.ExecuteIfBound();
 	GrappleState = EGrappleState::Firing;
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::GrappleFired, GetOwner(), 0, TargetLocation);
 
 	FVector StartLocation = GetStartLocation();
 	FVector VectorDirection = (TargetLocation - StartLocation);
@@ -58,10 +67,18 @@ void UGrappleComponent::Fire(FVector TargetLocation)
 	FActorSpawnParameters SpawnInfo;
 	FTransform ActorTransform = FTransform(StartLocation);
 	_GrappleHook = GetWorld()->SpawnActorDeferred<AGrappleHook>(GrappleHookType, ActorTransform);
+	if (!_GrappleHook)
+	{
+		// Nothing fired, the press must not be matched with a later, unrelated grapple.
+		FCapstoneInputLatency::CancelInput(ECapstoneLatencyAction::Grapple);
+		GrappleState = EGrappleState::ReadyToFire;
+		return;
+	}
 	_GrappleHook->FireVelocity = VectorDirection * FireSpeed;
 	_GrappleHook->OnActorHit.AddDynamic(this, &UGrappleComponent::OnHit);
 	_GrappleHook->SphereCollider->SetCollisionProfileName(TEXT("OverlapAll"));
 	UGameplayStatics::FinishSpawningActor(_GrappleHook, ActorTransform);
+	FCapstoneInputLatency::MarkEffect(ECapstoneLatencyAction::Grapple);
 
 	// Spawn and attach cable
 
@@ -97,10 +114,11 @@ void UGrappleComponent::OnHit(AActor *SelfActor, AActor *OtherActor, FVector Nor
 		return;
 	}
 
-	FTimerHandle handle;
-	GetWorld()->GetTimerManager().SetTimer(handle, this, &UGrappleComponent::MaxGrappleTimeReached, MaximumGrappleTime, false);
+	GetWorld()->GetTimerManager().SetTimer(MaxGrappleTimerHandle, this, &UGrappleComponent::MaxGrappleTimeReached, MaximumGrappleTime, false);
 
 	GrappleState = EGrappleState::Attached;
+	PullClock.Reset();
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::GrappleAttached, GetOwner(), 0, Hit.Location, OtherActor->GetFName());
 
 	if (APlayerCharacter *PlayerCharacter = Cast<APlayerCharacter>(GetOwner()))
 	{
@@ -124,6 +142,7 @@ void UGrappleComponent::CancelGrapple(bool ShouldTriggerCooldown)
 {
 	if (_GrappleHook && Cable)
 	{
+		FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::GrappleCancelled, GetOwner(), ShouldTriggerCooldown ? 1 : 0, _GrappleHook->GetActorLocation());
 		_GrappleHook->Destroy();
 		_GrappleHook = nullptr;
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GrappleState.h"
+#include "Spring2022_Capstone/GameplaySystems/FixedStepClock.h"
 #include "Components/ActorComponent.h"
 #include "GrappleComponent.generated.h"
 
@@ -20,10 +21,13 @@ class SPRING2022_CAPSTONE_API UGrappleComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	friend struct FGameplaySnapshot;
+
 public:
 	UGrappleComponent();
 
 	FTimerHandle CooldownTimerHandle;
+	FTimerHandle MaxGrappleTimerHandle;
 	FOnGrappleActivated OnGrappleActivatedDelegate;
 	FOnGrappleCooldownStart OnGrappleCooldownStartDelegate;
 	FOnGrappleCooldownEnd OnGrappleCooldownEndDelegate;
@@ -55,6 +59,9 @@ private:
 	FVector InitialHookDirection2D;
 	FVector GetToGrappleHookDirection();
 
+	// Steps the pull while attached, so the same grapple covers the same distance at any frame rate.
+	FFixedStepClock PullClock;
+
 	UPROPERTY(EditAnywhere)
 	float MinimumGrappleCooldown = 1;
 
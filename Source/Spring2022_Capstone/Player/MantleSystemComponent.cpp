@@ -6,6 +6,9 @@
 #include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Spring2022_Capstone/Performance/CapstoneInputLatency.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+#include "Spring2022_Capstone/Performance/CapstoneTelemetry.h"
 
 UMantleSystemComponent::UMantleSystemComponent()
 {
@@ -37,6 +40,7 @@ void UMantleSystemComponent::BeginPlay()
 
 void UMantleSystemComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	CAPSTONE_SCOPE(STAT_CapstoneMantleTick, Mantle);
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// Advance Timeline (Does not play timeline)
@@ -46,6 +50,7 @@ void UMantleSystemComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	{
 		MantleTimeline.PlayFromStart();
 		UGameplayStatics::GetPlayerCameraManager(GetWorld(),0)->StartCameraShake(ClimbingCameraShake);
+		FCapstoneInputLatency::MarkEffect(ECapstoneLatencyAction::Jump);
 	}
 	
 	if(MantleTimeline.IsPlaying())
@@ -55,6 +60,7 @@ void UMantleSystemComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 
 bool UMantleSystemComponent::AttemptMantle()
 {
+	CAPSTONE_SCOPE(STAT_CapstoneMantleAttempt, Mantle);
 	if(!CheckForBlockingWall())
 		return false;
 
@@ -67,6 +73,7 @@ bool UMantleSystemComponent::AttemptMantle()
 	TargetLocation.Z += MANTLE_VERTICAL_KNOCK;
 	InitialPlayerPosition = Player->GetActorLocation();
 	bCanMantle = true;
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::Mantle, Player, TargetLocation.Z - InitialPlayerPosition.Z, TargetLocation);
 	return true;
 }
 
@@ -79,6 +86,7 @@ bool UMantleSystemComponent::CheckForBlockingWall()
 
 	FVector BlockingWallCheckEndLocation = BlockingWallCheckStartLocation + (GetOwner()->GetActorForwardVector() * CAPSULE_TRACE_REACH); 
 
+	CAPSTONE_COUNT_SCENE_QUERY();
 	if(GetWorld()->SweepSingleByChannel(BlockingWallHitResult, BlockingWallCheckStartLocation, BlockingWallCheckEndLocation, FQuat::Identity, ECC_Visibility,
 		FCollisionShape::MakeCapsule(CAPSULE_TRACE_RADIUS, PlayerCapsuleComponent->GetScaledCapsuleHalfHeight()), TraceParams))
 	{
@@ -109,6 +117,7 @@ bool UMantleSystemComponent::TraceDownForMantleSurface()
 	
 	FVector SurfaceCheckEndLocation = FVector(InitialPoint.X, InitialPoint.Y, PlayerCharacterMovementComponent->GetActorLocation().Z - CAPSULE_TRACE_ZAXIS_RAISE) + InitialNormal * MANTLE_SURFACE_DEPTH; // Subtracting to account for raise above.
 	
+	CAPSTONE_COUNT_SCENE_QUERY();
 	if(GetWorld()->SweepSingleByChannel(SurfaceCheckHitResult, SurfaceCheckStartLocation, SurfaceCheckEndLocation, FQuat::Identity, ECC_Visibility,
 		FCollisionShape::MakeSphere(CAPSULE_TRACE_RADIUS), TraceParams))
 	{
@@ -151,6 +160,16 @@ void UMantleSystemComponent::SetTraceParams()
 	// ToDo: Ensure weapons are ignored when meshes added
 }
 
+void UMantleSystemComponent::CancelMantle()
+{
+	if(!bCanMantle && !MantleTimeline.IsPlaying())
+		return;
+
+	MantleTimeline.Stop();
+	bCanMantle = false;
+	PlayerCharacterMovementComponent->SetMovementMode(MOVE_Walking);
+}
+
 void UMantleSystemComponent::TimelineFinishedCallback()
 {
 	PlayerCharacterMovementComponent->SetMovementMode(MOVE_Walking);
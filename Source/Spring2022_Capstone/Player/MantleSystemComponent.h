@@ -29,6 +29,9 @@ public:
 	// Attempt to start the mantle process
 	bool AttemptMantle(); // ToDo: Rename? AttemptMantle()?
 
+	// Stops a mantle in progress and gives movement back to the player.
+	void CancelMantle();
+
 private:
 	
 	UPROPERTY()
@@ -15,6 +15,12 @@
 #include "Kismet/GameplayStatics.h"
 #include "Spring2022_Capstone/HealthComponent.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Spring2022_Capstone/Spring2022_CapstoneGameModeBase.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+#include "Spring2022_Capstone/Performance/CapstoneHitchDetector.h"
+#include "Spring2022_Capstone/Performance/CapstoneInputLatency.h"
+#include "Spring2022_Capstone/Performance/CapstoneMemoryTags.h"
+#include "Spring2022_Capstone/Performance/CapstoneTelemetry.h"
 
 APlayerCharacter::APlayerCharacter()
 {
@@ -34,6 +40,7 @@ APlayerCharacter::APlayerCharacter()
 	PlayerMantleSystemComponent = CreateDefaultSubobject<UMantleSystemComponent>(TEXT("Mantle"));
 
 	CrouchEyeOffset = FVector(0.f);
+	PreviousCrouchEyeOffset = FVector(0.f);
 	CrouchSpeed = 12.f;
 }
 
@@ -82,27 +89,46 @@ void APlayerCharacter::BeginPlay()
 	// Create and add Damage Indicator Widget
 	if(DamageIndicatorWidgetBP)
 	{
-		DirectionalDamageIndicatorWidget = Cast<UDirectionalDamageIndicatorWidget>(CreateWidget(GetWorld(), DamageIndicatorWidgetBP));
+		{
+			CAPSTONE_LLM_SCOPE(Capstone_UI);
+			CAPSTONE_HITCH_SCOPE(Widget, DamageIndicatorWidgetBP->GetFName());
+			DirectionalDamageIndicatorWidget = Cast<UDirectionalDamageIndicatorWidget>(CreateWidget(GetWorld(), DamageIndicatorWidgetBP));
+		}
 		DirectionalDamageIndicatorWidget->AddToViewport(1);
 	}
 
 	bDashBlurFadingIn = false;
+	DashBlurWeight = 0;
+	PreviousDashBlurWeight = 0;
 	
 }
 
 void APlayerCharacter::Tick(float DeltaTime)
 {
+	CAPSTONE_SCOPE(STAT_CapstonePlayerTick, Player);
 	Super::Tick(DeltaTime);
-	float CrouchInterpTime = FMath::Min(1.f, CrouchSpeed * DeltaTime);
-	CrouchEyeOffset = (1.f - CrouchInterpTime) * CrouchEyeOffset;
+
+	const int32 Steps = CameraEffectsClock.Advance(DeltaTime);
+	const float StepTime = CameraEffectsClock.GetStepTime();
+	for (int32 Step = 0; Step < Steps; Step++)
+	{
+		float CrouchInterpTime = FMath::Min(1.f, CrouchSpeed * StepTime);
+		PreviousCrouchEyeOffset = CrouchEyeOffset;
+		CrouchEyeOffset = (1.f - CrouchInterpTime) * CrouchEyeOffset;
+
+		PreviousDashBlurWeight = DashBlurWeight;
+		if(bDashBlurFadingIn)
+			DashBlurWeight = FMath::FInterpTo(DashBlurWeight, 1, StepTime, DASH_BLUR_FADEIN_SPEED);
+	}
 
 	if(bDashBlurFadingIn)
-		Camera->PostProcessSettings.WeightedBlendables.Array[0].Weight = FMath::FInterpTo(Camera->PostProcessSettings.WeightedBlendables.Array[0].Weight, 1, DeltaTime, DASH_BLUR_FADEIN_SPEED);
+		Camera->PostProcessSettings.WeightedBlendables.Array[0].Weight = FMath::Lerp(PreviousDashBlurWeight, DashBlurWeight, CameraEffectsClock.GetAlpha());
 	
 }
 
 void APlayerCharacter::Move(const FInputActionValue &Value)
 {
+	CAPSTONE_SCOPE(STAT_CapstonePlayerMove, Player);
 	
 	const FVector2D DirectionalValue = Value.Get<FVector2D>();
 	if (GetController() && (DirectionalValue.X != 0.f || DirectionalValue.Y != 0.f))
@@ -123,11 +149,14 @@ void APlayerCharacter::Jump()
 	{
 		if(bIsMoving)
 		{
+			// The mantle starts on the component's next tick, which completes the measurement.
+			FCapstoneInputLatency::MarkInput(ECapstoneLatencyAction::Jump);
 			if(PlayerMantleSystemComponent->AttemptMantle())
 			{
 				bIsMantleing = true;
 				return;
 			}
+			FCapstoneInputLatency::CancelInput(ECapstoneLatencyAction::Jump);
 		}
 	}
 
@@ -136,6 +165,7 @@ void APlayerCharacter::Jump()
 
 void APlayerCharacter::Dash(const FInputActionValue &Value)
 {
+	CAPSTONE_SCOPE(STAT_CapstonePlayerDash, Player);
 	const float CurrentTime = GetWorld()->GetRealTimeSeconds();
 
 	if (bCanDash)
@@ -145,6 +175,8 @@ void APlayerCharacter::Dash(const FInputActionValue &Value)
 		if (CurrentTime - LastDashActionTappedTime < DoubleTapActivationDelay && Value.GetMagnitude() == PreviousDashDirection)
 		{
 
+			FCapstoneInputLatency::MarkInput(ECapstoneLatencyAction::Dash);
+
 			// Knock the actor up slightly to prevent ground collision
 			LaunchCharacter(FVector(0, 0, 250), false, true); // Note: I like the feel of true Overrides but we can come back later.
 
@@ -185,6 +217,9 @@ void APlayerCharacter::DashDirectionalLaunch()
 	PostDashDirection *= PreDashSpeed;
 	GetCharacterMovement()->Velocity = PostDashDirection;
 
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::Dash, this, PreDashSpeed, GetActorLocation());
+	FCapstoneInputLatency::MarkEffect(ECapstoneLatencyAction::Dash);
+
 	// Handle Dash Cooldown
 	bCanDash = false;
 	GetWorld()->GetTimerManager().SetTimer(DashCooldownTimerHandle, this, &APlayerCharacter::ResetDashCooldown, DashCooldownTime, false);
@@ -195,6 +230,8 @@ void APlayerCharacter::DashDirectionalLaunch()
 void APlayerCharacter::ClearDashBlur()
 {
 	bDashBlurFadingIn = false;
+	DashBlurWeight = 0;
+	PreviousDashBlurWeight = 0;
 	Camera->PostProcessSettings.WeightedBlendables.Array[0].Weight = 0;
 }
 
@@ -205,6 +242,7 @@ void APlayerCharacter::ResetDashCooldown()
 
 void APlayerCharacter::Look(const FInputActionValue &Value)
 {
+	CAPSTONE_SCOPE(STAT_CapstonePlayerLook, Player);
 	const FVector2D LookAxisValue = Value.Get<FVector2D>();
 	if (GetController())
 	{
@@ -240,6 +278,7 @@ void APlayerCharacter::OnStartCrouch(float HalfHeightAdjust, float ScaledHalfHei
 	float StartBaseEyeHeight = BaseEyeHeight;
 	Super::OnStartCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
 	CrouchEyeOffset.Z += StartBaseEyeHeight - BaseEyeHeight + HalfHeightAdjust;
+	PreviousCrouchEyeOffset.Z += StartBaseEyeHeight - BaseEyeHeight + HalfHeightAdjust;
 	Camera->SetRelativeLocation(FVector(0.f, 0.f, BaseEyeHeight), false);
 }
 
@@ -248,6 +287,7 @@ void APlayerCharacter::OnEndCrouch(float HalfHeightAdjust, float ScaledHalfHeigh
 	float StartBaseEyeHeight = BaseEyeHeight;
 	Super::OnEndCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
 	CrouchEyeOffset.Z += StartBaseEyeHeight - BaseEyeHeight - HalfHeightAdjust;
+	PreviousCrouchEyeOffset.Z += StartBaseEyeHeight - BaseEyeHeight - HalfHeightAdjust;
 	Camera->SetRelativeLocation(FVector(0.f, 0.f, BaseEyeHeight), false);
 }
 
@@ -256,7 +296,7 @@ void APlayerCharacter::CalcCamera(float DeltaTime, FMinimalViewInfo &OutResult)
 	if (Camera)
 	{
 		Camera->GetCameraView(DeltaTime, OutResult);
-		OutResult.Location += CrouchEyeOffset;
+		OutResult.Location += FMath::Lerp(PreviousCrouchEyeOffset, CrouchEyeOffset, CameraEffectsClock.GetAlpha());
 	}
 }
 
@@ -264,6 +304,8 @@ void APlayerCharacter::Attack(const FInputActionValue &Value)
 {
 	if (bIsSprinting)
 		return;
+	// Shoot() completes the measurement when it fires. A press the fire rate timer ignores stays pending until a shot does.
+	FCapstoneInputLatency::MarkInput(ECapstoneLatencyAction::Attack);
 	ActiveWeapon->Shoot();
 }
 
@@ -283,6 +325,7 @@ void APlayerCharacter::Grapple(const FInputActionValue &Value)
 	FVector EndLocation = Camera->GetForwardVector() * GrappleComponent->GrappleRange + StartLocation;
 	FCollisionQueryParams TraceParams;
 
+	CAPSTONE_COUNT_SCENE_QUERY();
 	GetWorld()->LineTraceSingleByChannel(HitResult, StartLocation, EndLocation, ECC_Visibility);
 	// DrawDebugLine(GetWorld(), StartLocation, EndLocation, FColor::Red, false, 5.f);
 	FVector TargetLocation = EndLocation;
@@ -290,6 +333,8 @@ void APlayerCharacter::Grapple(const FInputActionValue &Value)
 	{
 		TargetLocation = HitResult.ImpactPoint;
 	}
+	// Marked once the grapple is sure to fire, the time still counts from the start of the frame.
+	FCapstoneInputLatency::MarkInput(ECapstoneLatencyAction::Grapple);
 	GrappleComponent->Fire(TargetLocation);
 }
 
@@ -327,8 +372,16 @@ void APlayerCharacter::SetIsMantleing(bool IsMantleingStatus)
 
 void APlayerCharacter::DamageActor(AActor* DamagingActor, const float DamageAmount)
 {
+	CAPSTONE_TRACE_SCOPE(STAT_CapstoneDamage);
+
+	// Switched off while the benchmark holds the player among enemies.
+	if (!CanBeDamaged())
+	{
+		return;
+	}
 
 	IDamageableActor::DamageActor(DamagingActor, DamageAmount);
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::DamageTaken, DamagingActor, DamageAmount, GetActorLocation(), GetFName());
 	
 	if (HealthComponent)
 	{
@@ -341,6 +394,13 @@ void APlayerCharacter::DamageActor(AActor* DamagingActor, const float DamageAmou
 		DirectionalDamageIndicatorWidget->SetDamagingActor(DamagingActor);
 	
 	HealthComponent->SetHealth(HealthComponent->GetHealth() - DamageAmount);
+
+	// Show the defeat screen over the level instead of travelling to DefeatLevel.
+	if (HealthComponent->GetHealth() <= 0)
+	{
+		if (ASpring2022_CapstoneGameModeBase* GameMode = Cast<ASpring2022_CapstoneGameModeBase>(UGameplayStatics::GetGameMode(this)))
+			GameMode->ShowEndScreen(false);
+	}
 }
 
 void APlayerCharacter::Heal(int Value)
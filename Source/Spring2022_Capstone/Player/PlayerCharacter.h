@@ -8,6 +8,7 @@
 #include "MantleSystemComponent.h"
 #include "UpgradeSystemComponent.h"
 #include "Spring2022_Capstone/GameplaySystems/DamageableActor.h"
+#include "Spring2022_Capstone/GameplaySystems/FixedStepClock.h"
 #include "Spring2022_Capstone/UI/HUD/DirectionalDamageIndicatorWidget.h"
 #include "PlayerCharacter.generated.h"
 
@@ -29,6 +30,9 @@ class SPRING2022_CAPSTONE_API APlayerCharacter : public ACharacter, public IDama
 	GENERATED_BODY()
 
 	friend class UUpgradeSystemComponent;
+	friend struct FGameplaySnapshot;
+	friend struct FCapstoneInputDriver;
+	friend class UCapstoneSoakTestSubsystem;
 
 public:
 	APlayerCharacter();
@@ -188,6 +192,10 @@ protected:
 
 	bool bDashBlurFadingIn;
 
+	// Dash blur weight of the last two steps, the camera shows a blend of them.
+	float DashBlurWeight;
+	float PreviousDashBlurWeight;
+
 	/**
 	 * @brief Sets post process blur effect weight to 0. Turning off
 	 * the effect. Called automatically for Timer set in Dash().
@@ -258,6 +266,12 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = Crouch)
 	float CrouchSpeed;
 
+	// CrouchEyeOffset before the last step, the camera shows a blend of the two.
+	FVector PreviousCrouchEyeOffset;
+
+	// Steps the crouch eye offset and dash blur fade, see FFixedStepClock.
+	FFixedStepClock CameraEffectsClock;
+
 	void SetIsMantleing(bool IsMantleingStatus);
 	
 	// Testing
@@ -6,6 +6,7 @@
 #include "GrappleComponent.h"
 #include "PlayerCharacter.h"
 #include "Spring2022_Capstone/HealthComponent.h"
+#include "Spring2022_Capstone/Performance/CapstoneTelemetry.h"
 
 // Sets default values for this component's properties
 UUpgradeSystemComponent::UUpgradeSystemComponent()
@@ -39,6 +40,7 @@ void UUpgradeSystemComponent::IncreaseMaxChargeAmount(AWeaponBase* WeaponToUpgra
 	if(WeaponToUpgrade)
 	{
 		WeaponToUpgrade->MaxChargeAmount += Amount;
+		FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::UpgradeApplied, WeaponToUpgrade, Amount, FVector::ZeroVector, TEXT("MaxChargeAmount"));
 		GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Green, FString::Printf(TEXT("%s Max Charge Amount Increased"), *WeaponToUpgrade->GetName()));
 	}
 }
@@ -49,6 +51,7 @@ void UUpgradeSystemComponent::IncreaseMaxHealthByAmount(float Amount)
 	{
 		PlayerToUpgrade->HealthComponent->SetMaxHealth(PlayerToUpgrade->HealthComponent->GetMaxHealth() + Amount);
 		PlayerToUpgrade->HealthComponent->SetHealth(PlayerToUpgrade->HealthComponent->GetHealth() + Amount);
+		FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::UpgradeApplied, PlayerToUpgrade, Amount, FVector::ZeroVector, TEXT("MaxHealth"));
 		GEngine->AddOnScreenDebugMessage(0, 4.f, FColor::Red, FString::Printf(TEXT("Your new max health is: %f"), PlayerToUpgrade->HealthComponent->GetMaxHealth()));
 	}
 }
@@ -58,12 +61,14 @@ void UUpgradeSystemComponent::IncreaseMaxHealthByPercentage(float PercentageAmou
 	float HealthIncrease = PlayerToUpgrade->HealthComponent->GetMaxHealth() * PercentageAmount / 100;
 	PlayerToUpgrade->HealthComponent->SetMaxHealth(PlayerToUpgrade->HealthComponent->GetMaxHealth() + HealthIncrease);
 	PlayerToUpgrade->HealthComponent->SetHealth(PlayerToUpgrade->HealthComponent->GetHealth() + HealthIncrease);
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::UpgradeApplied, PlayerToUpgrade, HealthIncrease, FVector::ZeroVector, TEXT("MaxHealth"));
 	GEngine->AddOnScreenDebugMessage(0, 4.f, FColor::Red, FString::Printf(TEXT("Your new max health is: %f"), PlayerToUpgrade->HealthComponent->GetMaxHealth()));
 }
 
 void UUpgradeSystemComponent::IncreaseMovementSpeedByAmount(int Amount)
 {
 	PlayerToUpgrade->Speed += Amount;
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::UpgradeApplied, PlayerToUpgrade, Amount, FVector::ZeroVector, TEXT("MovementSpeed"));
 	GEngine->AddOnScreenDebugMessage(0, 4.f, FColor::Red, FString::Printf(TEXT("Your new Movement Speed is: %f"), PlayerToUpgrade->Speed));
 }
 
@@ -72,6 +77,7 @@ void UUpgradeSystemComponent::IncreaseWeaponDamageByAmount(AWeaponBase* WeaponTo
 	if(WeaponToUpgrade)
 	{
 		WeaponToUpgrade->SetDamage(WeaponToUpgrade->GetDamage() + Amount);
+		FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::UpgradeApplied, WeaponToUpgrade, Amount, FVector::ZeroVector, TEXT("WeaponDamage"));
 		GEngine->AddOnScreenDebugMessage(-1, 2.f, FColor::Green, FString::Printf(TEXT("%s Damage is now: %f"), *WeaponToUpgrade->GetName(), WeaponToUpgrade->GetDamage()));
 	}
 }
@@ -79,18 +85,21 @@ void UUpgradeSystemComponent::IncreaseWeaponDamageByAmount(AWeaponBase* WeaponTo
 void UUpgradeSystemComponent::UnlockDoubleJump()
 {
 	PlayerToUpgrade->JumpMaxCount = PlayerToUpgrade->JumpMaxCount == 1 ? 2 : 1;
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::UpgradeApplied, PlayerToUpgrade, PlayerToUpgrade->JumpMaxCount, FVector::ZeroVector, TEXT("DoubleJump"));
 	GEngine->AddOnScreenDebugMessage(0, 2.f, FColor::Green, FString::Printf(TEXT("Your max jumps are: %i"), PlayerToUpgrade->JumpMaxCount));
 }
 
 void UUpgradeSystemComponent::DecreaseGrappleCooldownBySeconds(const float Seconds)
 {
 	PlayerToUpgrade->GrappleComponent->DecrementGrappleCooldown(Seconds);
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::UpgradeApplied, PlayerToUpgrade, Seconds, FVector::ZeroVector, TEXT("GrappleCooldown"));
 	GEngine->AddOnScreenDebugMessage(0, 2.f, FColor::Green, FString::Printf(TEXT("Your grapple cooldown is: %f"), PlayerToUpgrade->GrappleComponent->GetCooldown()));
 }
 
 void UUpgradeSystemComponent::IncreaseChargeCooldownRate(AWeaponBase* WeaponToUpgrade, float Amount)
 {
 	WeaponToUpgrade->ChargeCooldownRate += Amount;
+	FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::UpgradeApplied, WeaponToUpgrade, Amount, FVector::ZeroVector, TEXT("ChargeCooldownRate"));
 	GEngine->AddOnScreenDebugMessage(0, 2.f, FColor::Green, FString::Printf(TEXT("%s Charge cooldown rate is: %f"), *WeaponToUpgrade->GetName(), WeaponToUpgrade->ChargeCooldownRate));
 }
 
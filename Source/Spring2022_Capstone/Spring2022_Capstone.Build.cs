@@ -8,7 +8,7 @@ public class Spring2022_Capstone : ModuleRules
     {
         PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-        PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "UMG", "AIModule" });
+        PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "UMG", "AIModule", "GameplayTasks", "NavigationSystem", "RenderCore", "RHI", "Json", "JsonUtilities" });
 
         // PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 
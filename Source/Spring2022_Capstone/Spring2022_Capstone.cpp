@@ -2,5 +2,49 @@
 
 #include "Spring2022_Capstone.h"
 #include "Modules/ModuleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "GameplaySystems/FixedStepClock.h"
+#include "Performance/CapstoneChurnTracker.h"
+#include "Performance/CapstoneHitchDetector.h"
+#include "Performance/CapstoneInputLatency.h"
+#include "Performance/CapstoneStats.h"
+#include "Performance/CapstoneTelemetry.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Spring2022_Capstone, "Spring2022_Capstone" );
+class FSpring2022_CapstoneModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		FCapstoneFrameCounters::Startup();
+		FCapstoneHitchDetector::Startup();
+		FCapstoneChurnTracker::Startup();
+		FFixedStepClock::InitFromCommandLine();
+		FCapstoneTelemetry::Startup();
+		BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddStatic(&FCapstoneInputLatency::BeginFrame);
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddLambda([]()
+		{
+			FCapstoneSubsystemCosts::EndFrame();
+			FCapstoneFrameCounters::EndFrame();
+			FCapstoneHitchDetector::EndFrame();
+			FCapstoneChurnTracker::EndFrame();
+		});
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+		FCapstoneTelemetry::Shutdown();
+		FCapstoneChurnTracker::Shutdown();
+		FCapstoneHitchDetector::Shutdown();
+		FCapstoneFrameCounters::Shutdown();
+	}
+
+private:
+	FDelegateHandle BeginFrameHandle;
+	FDelegateHandle EndFrameHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FSpring2022_CapstoneModule, Spring2022_Capstone, "Spring2022_Capstone" );
+
+DEFINE_LOG_CATEGORY(LogCapstonePerformance);
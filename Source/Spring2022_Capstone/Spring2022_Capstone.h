@@ -4,3 +4,5 @@
 
 #include "CoreMinimal.h"
 
+// Performance tooling (governor, overlay, benchmarks).
+DECLARE_LOG_CATEGORY_EXTERN(LogCapstonePerformance, Log, All);
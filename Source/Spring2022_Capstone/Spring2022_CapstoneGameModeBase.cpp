@@ -2,4 +2,131 @@
 
 
 #include "Spring2022_CapstoneGameModeBase.h"
+#include "Async/Async.h"
+#include "Kismet/GameplayStatics.h"
+#include "UI/EndScreens/EndScreenUserWidget.h"
+#include "Performance/CapstoneHitchDetector.h"
+#include "Performance/CapstoneMemoryTags.h"
 
+void ASpring2022_CapstoneGameModeBase::StartPlay()
+{
+	Super::StartPlay();
+
+	// All actors have run BeginPlay at this point, so weapons are attached and health is initialized.
+	LevelStartSnapshot = FGameplaySnapshot::Capture(GetWorld());
+
+	// Create end screens up front so showing one doesn't hitch.
+	if (VictoryScreenWidget)
+	{
+		CAPSTONE_LLM_SCOPE(Capstone_UI);
+		CAPSTONE_HITCH_SCOPE(Widget, VictoryScreenWidget->GetFName());
+		_VictoryScreenWidget = CreateWidget<UEndScreenUserWidget>(GetWorld(), VictoryScreenWidget);
+	}
+	if (DefeatScreenWidget)
+	{
+		CAPSTONE_LLM_SCOPE(Capstone_UI);
+		CAPSTONE_HITCH_SCOPE(Widget, DefeatScreenWidget->GetFName());
+		_DefeatScreenWidget = CreateWidget<UEndScreenUserWidget>(GetWorld(), DefeatScreenWidget);
+	}
+}
+
+void ASpring2022_CapstoneGameModeBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Don't let the worker write into a game mode that is going away.
+	if (CheckpointWriteTask.IsValid())
+		CheckpointWriteTask.Wait();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASpring2022_CapstoneGameModeBase::ShowEndScreen(bool bVictory)
+{
+	if (_ActiveEndScreenWidget)
+	{
+		return;
+	}
+
+	_ActiveEndScreenWidget = bVictory ? _VictoryScreenWidget : _DefeatScreenWidget;
+	if (!_ActiveEndScreenWidget)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Type not specified for %s Screen Widget"), bVictory ? TEXT("Victory") : TEXT("Defeat"));
+		return;
+	}
+
+	_ActiveEndScreenWidget->AddToViewport(3);
+	UGameplayStatics::SetGamePaused(this, true);
+
+	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		FInputModeUIOnly InputMode;
+		InputMode.SetWidgetToFocus(_ActiveEndScreenWidget->TakeWidget());
+		PC->SetInputMode(InputMode);
+	}
+}
+
+void ASpring2022_CapstoneGameModeBase::RetryLevel()
+{
+	if (_ActiveEndScreenWidget)
+	{
+		_ActiveEndScreenWidget->RemoveFromParent();
+		_ActiveEndScreenWidget = nullptr;
+	}
+
+	// Respawn at the last checkpoint when there is one, otherwise at the start of the level.
+	if (!RestoreCheckpoint())
+		LevelStartSnapshot.Apply(GetWorld());
+
+	UGameplayStatics::SetGamePaused(this, false);
+
+	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		PC->SetInputMode(FInputModeGameOnly());
+		PC->bShowMouseCursor = false;
+		PC->bEnableClickEvents = false;
+		PC->bEnableMouseOverEvents = false;
+	}
+}
+
+void ASpring2022_CapstoneGameModeBase::SaveCheckpoint()
+{
+	// Reading actor state has to happen on the game thread, only the binary write is moved off it.
+	const double StartTime = FPlatformTime::Seconds();
+	FGameplaySnapshot Snapshot = FGameplaySnapshot::Capture(GetWorld());
+	UE_LOG(LogTemp, Log, TEXT("Checkpoint captured in %.3f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	if (CheckpointWriteTask.IsValid())
+		CheckpointWriteTask.Wait();
+
+	CheckpointWriteTask = Async(EAsyncExecution::ThreadPool, [this, Snapshot = MoveTemp(Snapshot)]()
+	{
+		Snapshot.ToBytes(CheckpointBytes);
+	});
+}
+
+bool ASpring2022_CapstoneGameModeBase::RestoreCheckpoint()
+{
+	if (!HasCheckpoint())
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// A checkpoint saved this frame may still be writing.
+	CheckpointWriteTask.Wait();
+
+	FGameplaySnapshot Snapshot;
+	if (!Snapshot.FromBytes(CheckpointBytes))
+	{
+		return false;
+	}
+	Snapshot.Apply(GetWorld());
+
+	UE_LOG(LogTemp, Log, TEXT("Checkpoint restored in %.3f ms (%d bytes)"), (FPlatformTime::Seconds() - StartTime) * 1000.0, CheckpointBytes.Num());
+	return true;
+}
+
+bool ASpring2022_CapstoneGameModeBase::HasCheckpoint() const
+{
+	return CheckpointWriteTask.IsValid();
+}
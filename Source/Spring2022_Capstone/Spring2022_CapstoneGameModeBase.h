@@ -3,15 +3,80 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "GameFramework/GameModeBase.h"
+#include "GameplaySystems/GameplaySnapshot.h"
 #include "Spring2022_CapstoneGameModeBase.generated.h"
 
+class UEndScreenUserWidget;
+
 /**
- * 
+ * Shows the victory and defeat screens on top of the gameplay map and resets the level in place on retry.
+ * Also keeps the last checkpoint as a binary snapshot so it can be restored without reloading the map.
  */
 UCLASS()
 class SPRING2022_CAPSTONE_API ASpring2022_CapstoneGameModeBase : public AGameModeBase
 {
 	GENERATED_BODY()
-	
+
+public:
+	virtual void StartPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * @brief Pauses gameplay and displays the victory or defeat screen over the level.
+	 * @param bVictory true - shows VictoryScreenWidget, false - shows DefeatScreenWidget.
+	 * @note Called with true from ALevelEndVolume and with false when the player dies.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "End Screens")
+	void ShowEndScreen(bool bVictory);
+
+	/**
+	 * @brief Removes the end screen and resets the player, weapons, pickups and enemies to
+	 * the last checkpoint, or to the snapshot taken when the level started if none was saved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "End Screens")
+	void RetryLevel();
+
+	/**
+	 * @brief Captures the current gameplay state. The binary write runs on a worker thread.
+	 * @note Called from ACheckpointVolume when the player enters it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Checkpoints")
+	void SaveCheckpoint();
+
+	/**
+	 * @brief Applies the last saved checkpoint in place.
+	 * @return false - no checkpoint has been saved yet.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Checkpoints")
+	bool RestoreCheckpoint();
+
+	UFUNCTION(BlueprintCallable, Category = "Checkpoints")
+	bool HasCheckpoint() const;
+
+protected:
+	UPROPERTY(EditDefaultsOnly, Category = "End Screens")
+	TSubclassOf<UEndScreenUserWidget> VictoryScreenWidget;
+
+	UPROPERTY(EditDefaultsOnly, Category = "End Screens")
+	TSubclassOf<UEndScreenUserWidget> DefeatScreenWidget;
+
+	// State of the level right after every actor has begun play. Applied by RetryLevel() while no checkpoint was saved.
+	FGameplaySnapshot LevelStartSnapshot;
+
+	// Last checkpoint, written by a worker thread. Only read after the future is ready.
+	TArray<uint8> CheckpointBytes;
+	TFuture<void> CheckpointWriteTask;
+
+private:
+	// End screens are created once and re-added on every show.
+	UPROPERTY()
+	UEndScreenUserWidget* _VictoryScreenWidget;
+
+	UPROPERTY()
+	UEndScreenUserWidget* _DefeatScreenWidget;
+
+	UPROPERTY()
+	UEndScreenUserWidget* _ActiveEndScreenWidget;
 };
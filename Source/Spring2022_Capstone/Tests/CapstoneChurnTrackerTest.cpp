@@ -0,0 +1,63 @@
+// Created by Spring2022_Capstone team
+
+
+#include "Misc/AutomationTest.h"
+#include "Camera/CameraActor.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Spring2022_Capstone/Performance/CapstoneChurnTracker.h"
+#include "Spring2022_Capstone/UI/HUD/PerformanceOverlayWidget.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const int32 SPAWN_COUNT = 5;		// Static mesh actors spawned, cameras get one less so the counts can't mix up.
+	const int32 WIDGET_COUNT = 3;		// Widgets created.
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCapstoneChurnTrackerTest, "Capstone.Churn.Totals",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCapstoneChurnTrackerTest::RunTest(const FString& Parameters)
+{
+	// The tracker hooks worlds as they are initialized, so a fresh world counts like a loaded map.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// Whatever was spawned before the reset, e.g. by the world itself, must not show up.
+	FCapstoneChurnTracker::ResetTotals();
+
+	TArray<AActor*> Spawned;
+	for (int32 Index = 0; Index < SPAWN_COUNT; Index++)
+		Spawned.Add(World->SpawnActor<AStaticMeshActor>());
+	for (int32 Index = 0; Index < SPAWN_COUNT - 1; Index++)
+		Spawned.Add(World->SpawnActor<ACameraActor>());
+	for (AActor* Actor : Spawned)
+		World->DestroyActor(Actor);
+	for (int32 Index = 0; Index < WIDGET_COUNT; Index++)
+		NewObject<UPerformanceOverlayWidget>(GetTransientPackage());
+
+	TestEqual(TEXT("Static mesh actor spawns"), FCapstoneChurnTracker::GetTotal(AStaticMeshActor::StaticClass(), ECapstoneChurn::Spawn), SPAWN_COUNT);
+	TestEqual(TEXT("Camera spawns"), FCapstoneChurnTracker::GetTotal(ACameraActor::StaticClass(), ECapstoneChurn::Spawn), SPAWN_COUNT - 1);
+	TestEqual(TEXT("Static mesh actor destroys"), FCapstoneChurnTracker::GetTotal(AStaticMeshActor::StaticClass(), ECapstoneChurn::Destroy), SPAWN_COUNT);
+	TestTrue(TEXT("Subclasses count towards their parent"),
+		FCapstoneChurnTracker::GetTotal(AActor::StaticClass(), ECapstoneChurn::Spawn) >= SPAWN_COUNT * 2 - 1);
+	TestEqual(TEXT("Widget creations"), FCapstoneChurnTracker::GetTotal(UPerformanceOverlayWidget::StaticClass(), ECapstoneChurn::Widget), WIDGET_COUNT);
+	TestEqual(TEXT("Actors aren't widgets"), FCapstoneChurnTracker::GetTotal(AStaticMeshActor::StaticClass(), ECapstoneChurn::Widget), 0);
+	TestTrue(TEXT("Spawns are in the last minute"),
+		FCapstoneChurnTracker::GetPerMinute(AStaticMeshActor::StaticClass(), ECapstoneChurn::Spawn) >= SPAWN_COUNT);
+
+	FCapstoneChurnTracker::ResetTotals();
+	TestEqual(TEXT("Reset clears the totals"), FCapstoneChurnTracker::GetTotal(AStaticMeshActor::StaticClass(), ECapstoneChurn::Spawn), 0);
+	TestTrue(TEXT("Reset keeps the last minute"),
+		FCapstoneChurnTracker::GetPerMinute(AStaticMeshActor::StaticClass(), ECapstoneChurn::Spawn) >= SPAWN_COUNT);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -0,0 +1,28 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CapstoneTest
+{
+	const double FRAME_BUDGET_MS = 1000.0 / 60.0;	// Work timed by the tests has to fit in one frame at 60 fps.
+	const TCHAR* const LEVEL_MAP = TEXT("/Game/Maps/Level");
+
+	// World of the map opened by AutomationOpenMap, in a packaged game or in PIE.
+	inline UWorld* GetGameWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World())
+				return Context.World();
+		}
+		return nullptr;
+	}
+}
+
+#endif
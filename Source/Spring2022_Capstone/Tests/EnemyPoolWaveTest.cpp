@@ -0,0 +1,242 @@
+// Created by Spring2022_Capstone team
+
+
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+#include "CapstoneTestHelpers.h"
+#include "Components/CapsuleComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "UObject/UnrealType.h"
+#include "Spring2022_Capstone/Spring2022_CapstoneGameModeBase.h"
+#include "Spring2022_Capstone/Enemies/BaseEnemy.h"
+#include "Spring2022_Capstone/Enemies/EnemyPoolSubsystem.h"
+#include "Spring2022_Capstone/Enemies/EnemyWaveSpawner.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace CapstoneTest;
+
+namespace
+{
+	const int32 WAVE_SIZE = 30;					// Enemies in each wave.
+	const int32 WAVE_COUNT = 2;					// The second wave has to start its spiral from the centre again.
+	const int32 MAX_FRAMES = 120;				// Frames a wave gets to come in before the test gives up.
+	const float SPAWN_DISTANCE = 1500.f;		// Distance from the player the spawner is placed at.
+	const float SPAWN_SPACING = 150.f;			// AEnemyWaveSpawner's default SpawnSpacing.
+	const float POSITION_TOLERANCE = 1.f;
+	const TCHAR* ENEMY_CLASS = TEXT("/Game/Blueprints/Enemies/BP_RangedEnemy.BP_RangedEnemy_C");
+
+	/**
+	 * @brief Spawns a wave spawner in front of the player with WaveCount waves of WAVE_SIZE enemies and no delay.
+	 * BeginPlay prewarms the pool for it, as it does for the placed ones.
+	 */
+	AEnemyWaveSpawner* SpawnTestSpawner(FAutomationTestBase* Test, UWorld* World, int32 WaveCount)
+	{
+		const APawn* Player = UGameplayStatics::GetPlayerPawn(World, 0);
+		const TSubclassOf<ABaseEnemy> EnemyClass = LoadClass<ABaseEnemy>(nullptr, ENEMY_CLASS);
+		FArrayProperty* WavesProperty = FindFProperty<FArrayProperty>(AEnemyWaveSpawner::StaticClass(), TEXT("Waves"));
+		if (!Test->TestNotNull(TEXT("Player"), Player) || !Test->TestNotNull(TEXT("Enemy class"), EnemyClass.Get())
+			|| !Test->TestNotNull(TEXT("Waves property"), WavesProperty))
+		{
+			return nullptr;
+		}
+
+		const FTransform Transform(Player->GetActorLocation() + Player->GetActorForwardVector() * SPAWN_DISTANCE);
+		AEnemyWaveSpawner* Spawner = World->SpawnActorDeferred<AEnemyWaveSpawner>(AEnemyWaveSpawner::StaticClass(), Transform);
+		if (!Test->TestNotNull(TEXT("Spawner"), Spawner))
+		{
+			return nullptr;
+		}
+
+		// Waves are only edited on placed spawners, the test fills them in the same way.
+		TArray<FEnemyWave>& Waves = *WavesProperty->ContainerPtrToValuePtr<TArray<FEnemyWave>>(Spawner);
+		for (int32 Wave = 0; Wave < WaveCount; Wave++)
+		{
+			FEnemyWave& EnemyWave = Waves.AddDefaulted_GetRef();
+			EnemyWave.EnemyClass = EnemyClass;
+			EnemyWave.Count = WAVE_SIZE;
+			EnemyWave.Delay = 0.f;
+		}
+		Spawner->FinishSpawning(Transform);
+		return Spawner;
+	}
+}
+
+/**
+ * Runs an encounter on a real AEnemyWaveSpawner, ticking it from the test so each batch it brings in can be timed.
+ * Every enemy has to land on the spawner's spiral, each wave starting from its centre.
+ */
+class FSpawnPooledWavesCommand : public IAutomationLatentCommand
+{
+public:
+	explicit FSpawnPooledWavesCommand(FAutomationTestBase* InTest)
+		: Test(InTest)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		UWorld* World = GetGameWorld();
+		UEnemyPoolSubsystem* Pool = World ? World->GetSubsystem<UEnemyPoolSubsystem>() : nullptr;
+		if (!Test->TestNotNull(TEXT("Enemy pool"), Pool))
+		{
+			return true;
+		}
+
+		if (!Spawner.IsValid())
+		{
+			Spawner = SpawnTestSpawner(Test, World, WAVE_COUNT);
+			if (!Spawner.IsValid())
+			{
+				return true;
+			}
+			FreeBefore = Pool->GetFreeCount();
+			ActiveBefore = Pool->GetActiveCount();
+			Spawner->StartEncounter();
+			Spawner->SetActorTickEnabled(false);
+			return false;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		Spawner->Tick(World->GetDeltaSeconds());
+		MaxBatchMs = FMath::Max(MaxBatchMs, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+		// Positions are read the frame enemies come in, before their AI moves them.
+		TArray<ABaseEnemy*> ActiveEnemies;
+		Pool->GetActiveEnemies(ActiveEnemies);
+		for (ABaseEnemy* Enemy : ActiveEnemies)
+		{
+			if (WaveEnemies.Contains(Enemy))
+				continue;
+			WaveEnemies.Add(Enemy);
+			WaveOffsets.Add(Enemy->GetActorLocation() - Spawner->GetActorLocation() - FVector(0.f, 0.f, Enemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()));
+		}
+
+		if (Spawner->GetAliveEnemyCount() < WAVE_SIZE)
+		{
+			return !Test->TestTrue(TEXT("Wave comes in within the frame limit"), ++WaveFrames < MAX_FRAMES);
+		}
+
+		Test->TestEqual(TEXT("The whole wave came from the pool"), FreeBefore - Pool->GetFreeCount(), WAVE_SIZE);
+		Test->TestEqual(TEXT("Enemies out of the pool"), Pool->GetActiveCount() - ActiveBefore, WAVE_SIZE);
+		CheckPositions();
+
+		// Killing the wave sends it back to the pool, which starts the next one.
+		for (ABaseEnemy* Enemy : WaveEnemies)
+			Pool->Release(Enemy);
+		Test->TestEqual(TEXT("Alive enemies after the wave died"), Spawner->GetAliveEnemyCount(), 0);
+		WaveEnemies.Reset();
+		WaveOffsets.Reset();
+		FreeBefore = Pool->GetFreeCount();
+		WaveFrames = 0;
+		if (++WavesDone < WAVE_COUNT)
+		{
+			return false;
+		}
+
+		Test->AddInfo(FString::Printf(TEXT("%d waves of %d enemies, slowest batch took %.3f ms"), WAVE_COUNT, WAVE_SIZE, MaxBatchMs));
+		Test->TestTrue(TEXT("Bringing a batch in stays well under one frame"), MaxBatchMs < FRAME_BUDGET_MS);
+		Spawner->Destroy();
+		return true;
+	}
+
+private:
+	// Every slot of the spawner's sunflower spiral, from its centre out, has to hold one enemy of the wave.
+	void CheckPositions() const
+	{
+		for (int32 Slot = 0; Slot < WAVE_SIZE; Slot++)
+		{
+			const float Angle = Slot * PI * (3.f - FMath::Sqrt(5.f));
+			const FVector Expected = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * SPAWN_SPACING * FMath::Sqrt((float)Slot);
+			const bool bFilled = WaveOffsets.ContainsByPredicate([&Expected](const FVector& Offset) { return Offset.Equals(Expected, POSITION_TOLERANCE); });
+			Test->TestTrue(FString::Printf(TEXT("Wave %d has an enemy in slot %d"), WavesDone + 1, Slot), bFilled);
+		}
+	}
+
+	FAutomationTestBase* Test;
+	TWeakObjectPtr<AEnemyWaveSpawner> Spawner;
+	TArray<ABaseEnemy*> WaveEnemies;
+	TArray<FVector> WaveOffsets;
+	int32 FreeBefore = 0;
+	int32 ActiveBefore = 0;
+	int32 WaveFrames = 0;
+	int32 WavesDone = 0;
+	double MaxBatchMs = 0;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyPoolWaveTest, "Capstone.Enemies.PooledWave",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEnemyPoolWaveTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(LEVEL_MAP);
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(1.f));
+	ADD_LATENT_AUTOMATION_COMMAND(FSpawnPooledWavesCommand(this));
+	return true;
+}
+
+/**
+ * Starts an encounter, lets its first wave come in and retries the level, which has to send every pooled enemy back
+ * and stop the encounter.
+ */
+class FRetryPooledWaveCommand : public IAutomationLatentCommand
+{
+public:
+	explicit FRetryPooledWaveCommand(FAutomationTestBase* InTest)
+		: Test(InTest)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		UWorld* World = GetGameWorld();
+		UEnemyPoolSubsystem* Pool = World ? World->GetSubsystem<UEnemyPoolSubsystem>() : nullptr;
+		ASpring2022_CapstoneGameModeBase* GameMode = World ? World->GetAuthGameMode<ASpring2022_CapstoneGameModeBase>() : nullptr;
+		if (!Test->TestNotNull(TEXT("Enemy pool"), Pool) || !Test->TestNotNull(TEXT("Game mode"), GameMode))
+		{
+			return true;
+		}
+
+		if (!Spawner.IsValid())
+		{
+			Spawner = SpawnTestSpawner(Test, World, 1);
+			if (!Spawner.IsValid())
+			{
+				return true;
+			}
+			Spawner->StartEncounter();
+			return false;
+		}
+
+		if (Spawner->GetAliveEnemyCount() < WAVE_SIZE)
+		{
+			return !Test->TestTrue(TEXT("Wave comes in within the frame limit"), ++WaveFrames < MAX_FRAMES);
+		}
+
+		GameMode->RetryLevel();
+
+		Test->TestEqual(TEXT("Pooled enemies active after the retry"), Pool->GetActiveCount(), 0);
+		Test->TestEqual(TEXT("Alive enemies after the retry"), Spawner->GetAliveEnemyCount(), 0);
+		Test->TestFalse(TEXT("Encounter active after the retry"), Spawner->IsEncounterActive());
+		Spawner->Destroy();
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	TWeakObjectPtr<AEnemyWaveSpawner> Spawner;
+	int32 WaveFrames = 0;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyPoolRetryTest, "Capstone.Enemies.PooledWaveRetry",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEnemyPoolRetryTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(LEVEL_MAP);
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(1.f));
+	ADD_LATENT_AUTOMATION_COMMAND(FRetryPooledWaveCommand(this));
+	return true;
+}
+
+#endif
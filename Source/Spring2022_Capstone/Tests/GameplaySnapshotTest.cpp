@@ -0,0 +1,125 @@
+// Created by Spring2022_Capstone team
+
+
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+#include "CapstoneTestHelpers.h"
+#include "Spring2022_Capstone/GameplaySystems/GameplaySnapshot.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const int32 ACTOR_COUNT = 256;	// Weapons, pickups and enemies each, well above what Level holds.
+}
+
+using namespace CapstoneTest;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplaySnapshotBytesTest, "Capstone.Snapshot.Bytes",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGameplaySnapshotBytesTest::RunTest(const FString& Parameters)
+{
+	FGameplaySnapshot Snapshot;
+	Snapshot.Player.Health = 42.f;
+	Snapshot.Player.JumpMaxCount = 2;
+	for (int32 Index = 0; Index < ACTOR_COUNT; Index++)
+	{
+		FWeaponSnapshot& Weapon = Snapshot.Weapons.AddDefaulted_GetRef();
+		Weapon.WeaponName = FName(TEXT("Weapon"), Index);
+		Weapon.CurrentCharge = Index;
+		Weapon.bIsOverheating = Index % 2 == 0;
+
+		FPickupSnapshot& Pickup = Snapshot.Pickups.AddDefaulted_GetRef();
+		Pickup.PickupName = FName(TEXT("Pickup"), Index);
+		Pickup.bCollected = Index % 3 == 0;
+
+		FEnemySnapshot& Enemy = Snapshot.Enemies.AddDefaulted_GetRef();
+		Enemy.EnemyName = FName(TEXT("Enemy"), Index);
+		Enemy.Transform = FTransform(FVector(Index, 0, 0));
+		Enemy.Health = Index;
+	}
+	FEncounterSnapshot& Encounter = Snapshot.Encounters.AddDefaulted_GetRef();
+	Encounter.SpawnerName = TEXT("Spawner");
+	Encounter.AliveEnemyNames.Add(FName(TEXT("Enemy"), 1));
+	Encounter.NextWave = 2;
+	Encounter.bEncounterActive = true;
+
+	TArray<uint8> Bytes;
+	const double StartTime = FPlatformTime::Seconds();
+	Snapshot.ToBytes(Bytes);
+	FGameplaySnapshot Restored;
+	const bool bRead = Restored.FromBytes(Bytes);
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	TestTrue(TEXT("Snapshot reads back"), bRead);
+	TestEqual(TEXT("Player health"), Restored.Player.Health, 42.f);
+	TestEqual(TEXT("Player jump count"), Restored.Player.JumpMaxCount, 2);
+	TestEqual(TEXT("Weapon count"), Restored.Weapons.Num(), ACTOR_COUNT);
+	TestEqual(TEXT("Pickup count"), Restored.Pickups.Num(), ACTOR_COUNT);
+	TestEqual(TEXT("Enemy count"), Restored.Enemies.Num(), ACTOR_COUNT);
+	if (Restored.Enemies.Num() == ACTOR_COUNT)
+	{
+		TestEqual(TEXT("Enemy name"), Restored.Enemies.Last().EnemyName, FName(TEXT("Enemy"), ACTOR_COUNT - 1));
+		TestEqual(TEXT("Weapon overheating"), Restored.Weapons[2].bIsOverheating, true);
+		TestEqual(TEXT("Pickup collected"), Restored.Pickups[3].bCollected, true);
+	}
+	if (TestEqual(TEXT("Encounter count"), Restored.Encounters.Num(), 1))
+	{
+		TestEqual(TEXT("Encounter alive enemies"), Restored.Encounters[0].AliveEnemyNames.Num(), 1);
+		TestEqual(TEXT("Encounter wave"), Restored.Encounters[0].NextWave, 2);
+		TestTrue(TEXT("Encounter active"), Restored.Encounters[0].bEncounterActive);
+	}
+
+	// A buffer from another version or an empty one must not be applied.
+	Bytes[0]++;
+	TestFalse(TEXT("Other version is rejected"), FGameplaySnapshot().FromBytes(Bytes));
+	TestFalse(TEXT("Empty buffer is rejected"), FGameplaySnapshot().FromBytes(TArray<uint8>()));
+
+	AddInfo(FString::Printf(TEXT("%d bytes written and read in %.3f ms"), Bytes.Num(), ElapsedMs));
+	TestTrue(TEXT("Write and read stay under one frame"), ElapsedMs < FRAME_BUDGET_MS);
+	return true;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FTimeSnapshotInLevelCommand, FAutomationTestBase*, Test);
+
+bool FTimeSnapshotInLevelCommand::Update()
+{
+	UWorld* World = GetGameWorld();
+	if (!Test->TestNotNull(TEXT("Game world"), World))
+	{
+		return true;
+	}
+
+	// The full checkpoint path: capture and apply on the game thread, the bytes in between.
+	double StartTime = FPlatformTime::Seconds();
+	const FGameplaySnapshot Snapshot = FGameplaySnapshot::Capture(World);
+	const double CaptureMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	TArray<uint8> Bytes;
+	Snapshot.ToBytes(Bytes);
+
+	StartTime = FPlatformTime::Seconds();
+	FGameplaySnapshot Restored;
+	Test->TestTrue(TEXT("Snapshot reads back"), Restored.FromBytes(Bytes));
+	Restored.Apply(World);
+	const double RestoreMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	Test->AddInfo(FString::Printf(TEXT("Capture %.3f ms, restore %.3f ms, %d bytes, %d enemies"), CaptureMs, RestoreMs, Bytes.Num(), Snapshot.Enemies.Num()));
+	Test->TestTrue(TEXT("Capture stays under one frame"), CaptureMs < FRAME_BUDGET_MS);
+	Test->TestTrue(TEXT("Restore stays under one frame"), RestoreMs < FRAME_BUDGET_MS);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplaySnapshotLevelTest, "Capstone.Snapshot.Level",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGameplaySnapshotLevelTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(LEVEL_MAP);
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(1.f));
+	ADD_LATENT_AUTOMATION_COMMAND(FTimeSnapshotInLevelCommand(this));
+	return true;
+}
+
+#endif
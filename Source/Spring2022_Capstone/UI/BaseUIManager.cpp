@@ -3,16 +3,41 @@
 #include "MainMenu/MainMenuWidget.h"
 #include "MainMenu/MainMenuManager.h"
 #include "Blueprint/UserWidget.h"
+#include "EngineUtils.h"
+#include "HUD/PerformanceOverlayWidget.h"
+#include "Spring2022_Capstone/Performance/CapstoneHitchDetector.h"
+#include "Spring2022_Capstone/Performance/CapstoneMemoryTags.h"
+
+static FAutoConsoleCommandWithWorld TogglePerformanceOverlayCommand(
+	TEXT("Capstone.PerfOverlay"),
+	TEXT("Toggles the performance overlay owned by the level's UI manager."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld *World)
+	{
+		for (TActorIterator<ABaseUIManager> It(World); It; ++It)
+		{
+			if (It->PerformanceOverlayWidget)
+			{
+				It->TogglePerformanceOverlay();
+				return;
+			}
+		}
+	}));
 
 ABaseUIManager::ABaseUIManager()
 {
 	PrimaryActorTick.bCanEverTick = true;
+
+	// The overlay lays itself out, a widget Blueprint subclass is only needed to restyle it.
+	PerformanceOverlayWidget = UPerformanceOverlayWidget::StaticClass();
 }
 
 void ABaseUIManager::BeginPlay()
 {
 	Super::BeginPlay();
 	DisplayWidget();
+
+	if (PerformanceOverlayWidget && FParse::Param(FCommandLine::Get(), TEXT("PerfOverlay")))
+		TogglePerformanceOverlay();
 }
 
 void ABaseUIManager::Tick(float DeltaTime)
@@ -23,7 +48,11 @@ void ABaseUIManager::Tick(float DeltaTime)
 void ABaseUIManager::DisplayWidget()
 {
 	if (RootWidget) {
-		_RootWidget = CreateWidget(GetWorld(), RootWidget);
+		{
+			CAPSTONE_LLM_SCOPE(Capstone_UI);
+			CAPSTONE_HITCH_SCOPE(Widget, RootWidget->GetFName());
+			_RootWidget = CreateWidget(GetWorld(), RootWidget);
+		}
 
 		
 		if (UMainMenuWidget *Widget = Cast<UMainMenuWidget>(_RootWidget))
@@ -39,6 +68,8 @@ void ABaseUIManager::DisplayWidget()
 		// Add Additional Widget Blueprints
 		for (TSubclassOf<UUserWidget> WidgetBluePrint : AdditionalWidgets)
 		{
+			CAPSTONE_LLM_SCOPE(Capstone_UI);
+			CAPSTONE_HITCH_SCOPE(Widget, WidgetBluePrint->GetFName());
 			UUserWidget* _AdditionalWidgetToAdd = CreateWidget(GetWorld(), WidgetBluePrint);
 			_AdditionalWidgetToAdd->AddToViewport(1);
 		}
@@ -52,3 +83,22 @@ void ABaseUIManager::DismissWidget()
 {
 	_RootWidget->RemoveFromParent();
 }
+
+void ABaseUIManager::TogglePerformanceOverlay()
+{
+	if (_PerformanceOverlayWidget && _PerformanceOverlayWidget->IsInViewport())
+	{
+		_PerformanceOverlayWidget->RemoveFromParent();
+		return;
+	}
+
+	if (!_PerformanceOverlayWidget && PerformanceOverlayWidget)
+	{
+		CAPSTONE_LLM_SCOPE(Capstone_UI);
+		CAPSTONE_HITCH_SCOPE(Widget, PerformanceOverlayWidget->GetFName());
+		_PerformanceOverlayWidget = CreateWidget<UPerformanceOverlayWidget>(GetWorld(), PerformanceOverlayWidget);
+	}
+
+	if (_PerformanceOverlayWidget)
+		_PerformanceOverlayWidget->AddToViewport(10);
+}
@@ -7,6 +7,7 @@
 #include "BaseUIManager.generated.h"
 
 class UUserWidget;
+class UPerformanceOverlayWidget;
 
 UCLASS()
 class SPRING2022_CAPSTONE_API ABaseUIManager : public AActor
@@ -34,7 +35,17 @@ public:
 	UFUNCTION()
 	void DismissWidget();
 
+	// Performance overlay, toggled with the Capstone.PerfOverlay console command or started with -PerfOverlay.
+	UPROPERTY(EditAnywhere, Category = "Widget")
+	TSubclassOf<UPerformanceOverlayWidget> PerformanceOverlayWidget;
+
+	UFUNCTION(BlueprintCallable)
+	void TogglePerformanceOverlay();
+
 private:
 	UUserWidget *_RootWidget;
 
+	UPROPERTY()
+	UPerformanceOverlayWidget *_PerformanceOverlayWidget;
+
 };
@@ -3,6 +3,7 @@
 #include "EndScreenUserWidget.h"
 #include "Components/Button.h"
 #include "Kismet/GameplayStatics.h"
+#include "Spring2022_Capstone/Spring2022_CapstoneGameModeBase.h"
 
 void UEndScreenUserWidget::NativeConstruct()
 {
@@ -10,6 +11,8 @@ void UEndScreenUserWidget::NativeConstruct()
 
 	ReturnToMainMenuButton->OnClicked.AddUniqueDynamic(this, &UEndScreenUserWidget::ReturnToMenuButtonPressed);
 	ExitButton->OnClicked.AddUniqueDynamic(this, &UEndScreenUserWidget::OnExitButtonPressed);
+	if (RetryButton)
+		RetryButton->OnClicked.AddUniqueDynamic(this, &UEndScreenUserWidget::OnRetryButtonPressed);
 
 	APlayerController* PC = GetWorld()->GetFirstPlayerController();
 	if (PC)
@@ -25,6 +28,18 @@ void UEndScreenUserWidget::ReturnToMenuButtonPressed()
 	UGameplayStatics::OpenLevel(this, "MainMenu");
 }
 
+void UEndScreenUserWidget::OnRetryButtonPressed()
+{
+	if (ASpring2022_CapstoneGameModeBase* GameMode = Cast<ASpring2022_CapstoneGameModeBase>(UGameplayStatics::GetGameMode(this)))
+	{
+		GameMode->RetryLevel();
+	}
+	else
+	{
+		// Fall back to reloading the map when the level isn't using the Capstone game mode.
+		UGameplayStatics::OpenLevel(this, FName(*UGameplayStatics::GetCurrentLevelName(this)));
+	}
+}
 
 void UEndScreenUserWidget::OnExitButtonPressed()
 {
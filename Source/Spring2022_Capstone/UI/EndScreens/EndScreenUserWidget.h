@@ -40,6 +40,13 @@ public:
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 		UTextBlock* ReturnToMainMenuText;
 	
+	// Optional, resets the level in place instead of travelling to another map.
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+		UButton* RetryButton;
+
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+		UTextBlock* RetryButtonText;
+
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 		UButton* ExitButton;
 
@@ -51,6 +58,9 @@ private:
 	UFUNCTION()
 		void ReturnToMenuButtonPressed();
 
+	UFUNCTION()
+		void OnRetryButtonPressed();
+
 	UFUNCTION()
 		void OnExitButtonPressed();
 };
@@ -6,6 +6,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Spring2022_Capstone/Player/PlayerCharacter.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
 
 void UDirectionalDamageIndicatorWidget::NativeConstruct()
 {
@@ -20,6 +21,7 @@ void UDirectionalDamageIndicatorWidget::NativeConstruct()
 
 void UDirectionalDamageIndicatorWidget::NativeTick(const FGeometry& MyGeometry, float DeltaTime)
 {
+	CAPSTONE_SCOPE(STAT_CapstoneDamageIndicatorTick, UI);
 	Super::NativeTick(MyGeometry, DeltaTime);
 	
 	if(DamagingActor)
@@ -7,6 +7,7 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "Spring2022_Capstone/Player/PlayerCharacter.h"
 #include "Spring2022_Capstone/Player/GrappleComponent.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
 
 void UHUDWidget::NativeConstruct()
 {
@@ -29,6 +30,7 @@ void UHUDWidget::NativeConstruct()
 
 void UHUDWidget::NativeTick(const FGeometry &MyGeometry, float DeltaTime)
 {
+    CAPSTONE_SCOPE(STAT_CapstoneHUDTick, UI);
     Super::NativeTick(MyGeometry, DeltaTime);
     if (GrappleTimerHandle && GrappleTimerHandle->IsValid())
     {
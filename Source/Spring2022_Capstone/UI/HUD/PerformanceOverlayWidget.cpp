@@ -0,0 +1,307 @@
+// Created by Spring2022_Capstone team
+
+
+#include "PerformanceOverlayWidget.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/SizeBox.h"
+#include "Components/TextBlock.h"
+#include "Components/VerticalBox.h"
+#include "Components/VerticalBoxSlot.h"
+#include "Engine/GameInstance.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "Rendering/DrawElements.h"
+#include "Spring2022_Capstone/Enemies/EncounterDirectorSubsystem.h"
+#include "Spring2022_Capstone/Enemies/EnemyAttackSchedulerSubsystem.h"
+#include "Spring2022_Capstone/Enemies/EnemyPoolSubsystem.h"
+#include "Spring2022_Capstone/Enemies/EnemyProjectileSubsystem.h"
+#include "Spring2022_Capstone/Enemies/EnemySignificanceSubsystem.h"
+#include "Spring2022_Capstone/Enemies/AI/CoverPointSubsystem.h"
+#include "Spring2022_Capstone/Enemies/AI/EnemyLineOfSightSubsystem.h"
+#include "Spring2022_Capstone/Enemies/AI/EnemyPathRequestSubsystem.h"
+#include "Spring2022_Capstone/Enemies/AI/EnemyQueryCacheSubsystem.h"
+#include "Spring2022_Capstone/Performance/CapstoneChurnTracker.h"
+#include "Spring2022_Capstone/Performance/CapstoneInputLatency.h"
+#include "Spring2022_Capstone/Performance/CapstoneMemoryBudgetSubsystem.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+#include "Spring2022_Capstone/Performance/PerformanceGovernorSubsystem.h"
+
+bool UPerformanceOverlayWidget::Initialize()
+{
+	if (!Super::Initialize())
+		return false;
+
+	// Created straight from this class the tree is empty, a Blueprint subclass brings its own.
+	if (WidgetTree && !WidgetTree->RootWidget)
+		BuildDefaultLayout();
+	return true;
+}
+
+void UPerformanceOverlayWidget::BuildDefaultLayout()
+{
+	UVerticalBox* Box = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass(), TEXT("RootPanel"));
+	WidgetTree->RootWidget = Box;
+	RootPanel = Box;
+
+	FrameTimeText = AddDefaultText(TEXT("FrameTimeText"));
+	GovernorText = AddDefaultText(TEXT("GovernorText"));
+
+	USizeBox* GraphBox = WidgetTree->ConstructWidget<USizeBox>(USizeBox::StaticClass(), TEXT("FrameGraphArea"));
+	GraphBox->SetWidthOverride(DEFAULT_GRAPH_WIDTH);
+	GraphBox->SetHeightOverride(DEFAULT_GRAPH_HEIGHT);
+	Box->AddChildToVerticalBox(GraphBox)->SetHorizontalAlignment(HAlign_Left);
+	FrameGraphArea = GraphBox;
+
+	MemoryText = AddDefaultText(TEXT("MemoryText"));
+	ObjectCountText = AddDefaultText(TEXT("ObjectCountText"));
+	DirectorText = AddDefaultText(TEXT("DirectorText"));
+	ChurnText = AddDefaultText(TEXT("ChurnText"));
+	LatencyText = AddDefaultText(TEXT("LatencyText"));
+	SubsystemCostText = AddDefaultText(TEXT("SubsystemCostText"));
+}
+
+UTextBlock* UPerformanceOverlayWidget::AddDefaultText(FName Name)
+{
+	UTextBlock* Text = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), Name);
+	FSlateFontInfo Font = Text->GetFont();
+	Font.Size = DEFAULT_FONT_SIZE;
+	Text->SetFont(Font);
+	Text->SetShadowOffset(FVector2D(1.f, 1.f));
+	Text->SetShadowColorAndOpacity(FLinearColor::Black);
+	RootPanel->AddChild(Text);
+	return Text;
+}
+
+void UPerformanceOverlayWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	Samples.SetNum(SAMPLE_CAPACITY);
+	NextSampleIndex = 0;
+	SampleCount = 0;
+	HitchCount = 0;
+	TimeSinceRefresh = RefreshRate;
+
+	// The overlay is display only, keep it out of hit testing.
+	SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UPerformanceOverlayWidget::NativeTick(const FGeometry &MyGeometry, float DeltaTime)
+{
+	Super::NativeTick(MyGeometry, DeltaTime);
+
+	// Buffering a sample is all that happens on most frames.
+	FFrameSample& Sample = Samples[NextSampleIndex];
+	Sample.FrameMs = FApp::GetDeltaTime() * 1000.f;
+	Sample.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Sample.RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	Sample.GPUMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+	NextSampleIndex = (NextSampleIndex + 1) % SAMPLE_CAPACITY;
+	SampleCount = FMath::Min(SampleCount + 1, SAMPLE_CAPACITY);
+
+	if (Sample.FrameMs > HitchThresholdMs)
+		HitchCount++;
+
+	TimeSinceRefresh += DeltaTime;
+	if (TimeSinceRefresh >= RefreshRate)
+	{
+		TimeSinceRefresh = 0;
+		Refresh();
+	}
+}
+
+void UPerformanceOverlayWidget::Refresh()
+{
+	if (SampleCount == 0)
+		return;
+
+	FFrameSample Average;
+	float WorstFrameMs = 0;
+	GraphPoints.Reset(SampleCount);
+	HitchMarkers.Reset();
+
+	// Oldest sample first so the graph scrolls right to left.
+	const int32 FirstIndex = (NextSampleIndex - SampleCount + SAMPLE_CAPACITY) % SAMPLE_CAPACITY;
+	for (int32 Offset = 0; Offset < SampleCount; Offset++)
+	{
+		const FFrameSample& Sample = Samples[(FirstIndex + Offset) % SAMPLE_CAPACITY];
+		Average.FrameMs += Sample.FrameMs;
+		Average.GameThreadMs += Sample.GameThreadMs;
+		Average.RenderThreadMs += Sample.RenderThreadMs;
+		Average.GPUMs += Sample.GPUMs;
+		WorstFrameMs = FMath::Max(WorstFrameMs, Sample.FrameMs);
+
+		const float X = (float)Offset / (SAMPLE_CAPACITY - 1);
+		GraphPoints.Add(FVector2D(X, 1.f - FMath::Min(Sample.FrameMs / GraphMaxMs, 1.f)));
+		if (Sample.FrameMs > HitchThresholdMs)
+			HitchMarkers.Add(X);
+	}
+
+	Average.FrameMs /= SampleCount;
+	Average.GameThreadMs /= SampleCount;
+	Average.RenderThreadMs /= SampleCount;
+	Average.GPUMs /= SampleCount;
+
+	if (FrameTimeText)
+	{
+		FrameTimeText->SetText(FText::FromString(FString::Printf(TEXT("Frame %.2f ms (%.0f fps)  Game %.2f  Render %.2f  GPU %.2f  Worst %.1f  Hitches %d"),
+			Average.FrameMs, Average.FrameMs > 0 ? 1000.f / Average.FrameMs : 0.f, Average.GameThreadMs, Average.RenderThreadMs, Average.GPUMs, WorstFrameMs, HitchCount)));
+	}
+
+	if (GovernorText)
+	{
+		if (UPerformanceGovernorSubsystem* Governor = GetGameInstance() ? GetGameInstance()->GetSubsystem<UPerformanceGovernorSubsystem>() : nullptr)
+		{
+			const FPerformanceGovernorStats& Stats = Governor->GetStats();
+			GovernorText->SetText(FText::FromString(FString::Printf(TEXT("Target %.2f ms  Resolution %.0f%%  Quality -%d  %s"),
+				Stats.TargetFrameTimeMs, Stats.ScreenPercentage, Stats.QualityStepsDropped, *Stats.LastDecision)));
+		}
+	}
+
+	if (DirectorText)
+	{
+		if (const UEncounterDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEncounterDirectorSubsystem>())
+		{
+			DirectorText->SetText(FText::FromString(FString::Printf(TEXT("Director load %.0f%%  budget %.2f  intensity %.2f%s\nEnemies %d/%d  Attackers %d/%d  Effects %d/%d"),
+				Director->GetFrameLoad() * 100.f, Director->GetBudgetScale(), Director->GetIntensity(), Director->AreSpawnsHeld() ? TEXT("  spawns held") : TEXT(""),
+				Director->GetActiveEnemyCount(), Director->GetMaxActiveEnemies(), Director->GetAttackerCount(), Director->GetMaxAttackers(),
+				Director->GetEffectCount(), Director->GetMaxEffects())));
+		}
+	}
+
+	if (MemoryText)
+	{
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+		FString MemoryLines = FString::Printf(TEXT("Memory %.0f MB (peak %.0f MB)"),
+			MemoryStats.UsedPhysical / (1024.f * 1024.f), MemoryStats.PeakUsedPhysical / (1024.f * 1024.f));
+
+		// Per tag memory with -LLM, tags over their budget are flagged.
+		const UCapstoneMemoryBudgetSubsystem* Budgets = GetGameInstance() ? GetGameInstance()->GetSubsystem<UCapstoneMemoryBudgetSubsystem>() : nullptr;
+		if (Budgets && FCapstoneMemoryTags::IsTracking())
+		{
+			MemoryLines += TEXT("\n");
+			for (int32 Index = 0; Index < (int32)ECapstoneMemoryTag::Count; Index++)
+			{
+				const ECapstoneMemoryTag Tag = (ECapstoneMemoryTag)Index;
+				if (Budgets->IsOverBudget(Tag))
+					MemoryLines += FString::Printf(TEXT("%s %.1f/%.0f MB OVER  "), FCapstoneMemoryTags::GetTagName(Tag), Budgets->GetCurrentMB(Tag), Budgets->GetBudgetMB(Tag));
+				else
+					MemoryLines += FString::Printf(TEXT("%s %.1f MB  "), FCapstoneMemoryTags::GetTagName(Tag), Budgets->GetCurrentMB(Tag));
+			}
+		}
+		MemoryText->SetText(FText::FromString(MemoryLines));
+	}
+
+	if (ObjectCountText)
+	{
+		FString CountLines = FString::Printf(TEXT("Actors %d  Widgets created %d  UObjects %d\nPer frame: Traces %d  Spawns %d  Widgets %d"),
+			GetWorld()->GetActorCount(), FCapstoneFrameCounters::GetTotalWidgetCreations(), GUObjectArray.GetObjectArrayNumMinusAvailable(),
+			FCapstoneFrameCounters::GetLastFrameSceneQueries(), FCapstoneFrameCounters::GetLastFrameActorSpawns(), FCapstoneFrameCounters::GetLastFrameWidgetCreations());
+
+		if (const UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+		{
+			CountLines += FString::Printf(TEXT("\nEnemies High %d  Medium %d  Low %d  Dormant %d"),
+				Significance->GetEnemyCount(EEnemySignificance::High), Significance->GetEnemyCount(EEnemySignificance::Medium),
+				Significance->GetEnemyCount(EEnemySignificance::Low), Significance->GetEnemyCount(EEnemySignificance::Dormant));
+		}
+		if (const UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+		{
+			CountLines += FString::Printf(TEXT("\nEnemy pool: %d active, %d free"), Pool->GetActiveCount(), Pool->GetFreeCount());
+		}
+		if (const UEnemyLineOfSightSubsystem* LineOfSight = GetWorld()->GetSubsystem<UEnemyLineOfSightSubsystem>())
+		{
+			CountLines += FString::Printf(TEXT("\nLine of sight: %d traces, %d queued, oldest %.2fs"),
+				LineOfSight->GetLastFrameTraceCount(), LineOfSight->GetQueuedCount(), LineOfSight->GetMaxAge());
+		}
+		if (const UEnemyQueryCacheSubsystem* QueryCache = GetWorld()->GetSubsystem<UEnemyQueryCacheSubsystem>())
+		{
+			const int32 Requests = QueryCache->GetCacheHitCount() + QueryCache->GetCacheMissCount();
+			CountLines += FString::Printf(TEXT("\nEnv queries: %d started, %d queued, %.0f%% cached"),
+				QueryCache->GetLastFrameQueryCount(), QueryCache->GetQueuedCount(), Requests > 0 ? 100.f * QueryCache->GetCacheHitCount() / Requests : 0.f);
+		}
+		if (const UEnemyPathRequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UEnemyPathRequestSubsystem>())
+		{
+			CountLines += FString::Printf(TEXT("\nPaths: %d searches, %d queued, %.0f%% shared"),
+				PathRequests->GetLastFrameSearchCount(), PathRequests->GetQueuedCount(), PathRequests->GetSharedFraction() * 100.f);
+		}
+		if (const UCoverPointSubsystem* CoverPoints = GetWorld()->GetSubsystem<UCoverPointSubsystem>())
+		{
+			CountLines += FString::Printf(TEXT("\nCover points: %d, %d reserved"), CoverPoints->GetCoverPointCount(), CoverPoints->GetReservedCount());
+		}
+		if (const UEnemyAttackSchedulerSubsystem* AttackScheduler = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+		{
+			CountLines += FString::Printf(TEXT("\nAttack tokens: %d held, %d attacks"), AttackScheduler->GetTokenCount(), AttackScheduler->GetLastFrameAttackCount());
+		}
+		if (const UEnemyProjectileSubsystem* Projectiles = GetWorld()->GetSubsystem<UEnemyProjectileSubsystem>())
+		{
+			CountLines += FString::Printf(TEXT("\nEnemy projectiles: %d, %d sweeps, %.2f ms"),
+				Projectiles->GetProjectileCount(), Projectiles->GetLastFrameSweepCount(), Projectiles->GetLastUpdateMs());
+		}
+		ObjectCountText->SetText(FText::FromString(CountLines));
+	}
+
+	if (ChurnText)
+	{
+		FString ChurnLines = TEXT("Churn per minute: spawns/destroys/widgets\n");
+		for (const FCapstoneChurnEntry& Entry : FCapstoneChurnTracker::GetTopClasses(CHURN_LINES))
+		{
+			ChurnLines += FString::Printf(TEXT("%s %d/%d/%d\n"), *Entry.ClassName.ToString(),
+				Entry.PerMinute[(int32)ECapstoneChurn::Spawn], Entry.PerMinute[(int32)ECapstoneChurn::Destroy], Entry.PerMinute[(int32)ECapstoneChurn::Widget]);
+		}
+		ChurnText->SetText(FText::FromString(ChurnLines));
+	}
+
+	if (LatencyText)
+	{
+		FString LatencyLines;
+		for (int32 Index = 0; Index < (int32)ECapstoneLatencyAction::Count; Index++)
+		{
+			const ECapstoneLatencyAction Action = (ECapstoneLatencyAction)Index;
+			const FCapstoneLatencyHistogram& Histogram = FCapstoneInputLatency::GetHistogram(Action);
+			LatencyLines += FString::Printf(TEXT("%-8s %.1f ms (%.1f frames)  p95 %.1f  max %.1f  x%d\n"), FCapstoneInputLatency::GetActionName(Action),
+				Histogram.GetAverageMs(), Histogram.GetAverageFrames(), Histogram.GetPercentileMs(0.95f), Histogram.MaxMs, Histogram.Count);
+		}
+		LatencyText->SetText(FText::FromString(LatencyLines));
+	}
+
+	if (SubsystemCostText)
+	{
+		FString CostLines;
+		for (int32 Index = 0; Index < (int32)ECapstoneSubsystem::Count; Index++)
+		{
+			const ECapstoneSubsystem Subsystem = (ECapstoneSubsystem)Index;
+			CostLines += FString::Printf(TEXT("%-8s %.3f ms\n"), FCapstoneSubsystemCosts::GetSubsystemName(Subsystem), FCapstoneSubsystemCosts::GetLastFrameMs(Subsystem));
+		}
+		SubsystemCostText->SetText(FText::FromString(CostLines));
+	}
+}
+
+int32 UPerformanceOverlayWidget::NativePaint(const FPaintArgs &Args, const FGeometry &AllottedGeometry, const FSlateRect &MyCullingRect,
+	FSlateWindowElementList &OutDrawElements, int32 LayerId, const FWidgetStyle &InWidgetStyle, bool bParentEnabled) const
+{
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	if (!FrameGraphArea || GraphPoints.Num() < 2)
+		return LayerId;
+
+	// Scale the cached normalized points into the graph area, no per sample work beyond that.
+	const FGeometry& GraphGeometry = FrameGraphArea->GetCachedGeometry();
+	const FVector2D GraphSize = GraphGeometry.GetLocalSize();
+
+	LinePoints.Reset(GraphPoints.Num());
+	for (const FVector2D& Point : GraphPoints)
+		LinePoints.Add(Point * GraphSize);
+
+	FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 1, GraphGeometry.ToPaintGeometry(), LinePoints, ESlateDrawEffect::None, FLinearColor::Green, true, 1.f);
+
+	MarkerPoints.SetNum(2);
+	for (float X : HitchMarkers)
+	{
+		MarkerPoints[0] = FVector2D(X * GraphSize.X, 0);
+		MarkerPoints[1] = FVector2D(X * GraphSize.X, GraphSize.Y);
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 1, GraphGeometry.ToPaintGeometry(), MarkerPoints, ESlateDrawEffect::None, FLinearColor::Red, true, 1.f);
+	}
+
+	return LayerId + 1;
+}
@@ -0,0 +1,117 @@
+// Created by Spring2022_Capstone team
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "PerformanceOverlayWidget.generated.h"
+
+class UPanelWidget;
+class UTextBlock;
+
+/**
+ * Playtest overlay showing frame time split into game, render and GPU, a frame time graph with
+ * hitch markers, memory, object counts, the classes churning the most, input latency and per subsystem costs.
+ * Samples are buffered every frame but text and graph are only rebuilt at RefreshRate.
+ * Without a widget Blueprint the overlay builds a plain layout with every text block and the graph itself.
+ */
+UCLASS()
+class SPRING2022_CAPSTONE_API UPerformanceOverlayWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool Initialize() override;
+
+protected:
+	virtual void NativeConstruct() override;
+	virtual void NativeTick(const FGeometry &MyGeometry, float DeltaTime) override;
+	virtual int32 NativePaint(const FPaintArgs &Args, const FGeometry &AllottedGeometry, const FSlateRect &MyCullingRect,
+		FSlateWindowElementList &OutDrawElements, int32 LayerId, const FWidgetStyle &InWidgetStyle, bool bParentEnabled) const override;
+
+public:
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UPanelWidget *RootPanel;
+
+	// Frame time breakdown
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UTextBlock *FrameTimeText;
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UTextBlock *GovernorText;
+
+	// Memory, actor and widget counts
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UTextBlock *MemoryText;
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UTextBlock *ObjectCountText;
+
+	// Classes with the most spawns, destroys and widget creations over the last minute
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UTextBlock *ChurnText;
+
+	// Input to effect latency per ECapstoneLatencyAction
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UTextBlock *LatencyText;
+
+	// Encounter director limits and frame load
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UTextBlock *DirectorText;
+
+	// One line per ECapstoneSubsystem
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UTextBlock *SubsystemCostText;
+
+	// Area the frame time graph is drawn over. The graph is skipped if not bound.
+	UPROPERTY(EditAnywhere, meta = (BindWidgetOptional))
+	UWidget *FrameGraphArea;
+
+private:
+	struct FFrameSample
+	{
+		float FrameMs = 0;
+		float GameThreadMs = 0;
+		float RenderThreadMs = 0;
+		float GPUMs = 0;
+	};
+
+	// Rebuilds the texts and graph points from the buffered samples.
+	void Refresh();
+
+	// Creates the root panel, text blocks and graph area when no widget Blueprint laid them out.
+	void BuildDefaultLayout();
+	UTextBlock* AddDefaultText(FName Name);
+
+	// Seconds between overlay refreshes.
+	UPROPERTY(EditAnywhere, Category = "Performance Overlay")
+	float RefreshRate = 0.25f;
+
+	// Frames slower than this are drawn as hitch markers and counted.
+	UPROPERTY(EditAnywhere, Category = "Performance Overlay")
+	float HitchThresholdMs = 50.f;
+
+	// Frame time at the top of the graph.
+	UPROPERTY(EditAnywhere, Category = "Performance Overlay")
+	float GraphMaxMs = 50.f;
+
+	// Ring buffer of the most recent frames.
+	TArray<FFrameSample> Samples;
+	int32 NextSampleIndex = 0;
+	int32 SampleCount = 0;
+
+	int32 HitchCount = 0;
+	float TimeSinceRefresh = 0;
+
+	// Graph built in Refresh(), normalized 0 - 1 so painting only has to scale them.
+	TArray<FVector2D> GraphPoints;
+	TArray<float> HitchMarkers;
+
+	// Reused by NativePaint() so painting doesn't allocate.
+	mutable TArray<FVector2D> LinePoints;
+	mutable TArray<FVector2D> MarkerPoints;
+
+	const int32 SAMPLE_CAPACITY = 240;	// About four seconds of frames at 60 fps.
+	const int32 CHURN_LINES = 5;		// Classes listed in ChurnText.
+	const int32 DEFAULT_FONT_SIZE = 10;	// Text size of the layout built without a widget Blueprint.
+	const float DEFAULT_GRAPH_WIDTH = 480.f;
+	const float DEFAULT_GRAPH_HEIGHT = 80.f;
+};
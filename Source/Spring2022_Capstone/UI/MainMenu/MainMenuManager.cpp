@@ -1,13 +1,32 @@
 // Created by Spring2022_Capstone team
 #include "MainMenuManager.h"
 #include "Spring2022_Capstone/UI/SettingsMenu/SettingsMenuWidget.h"
+#include "GameFramework/GameUserSettings.h"
+#include "Spring2022_Capstone/Performance/CapstoneHitchDetector.h"
+#include "Spring2022_Capstone/Performance/CapstoneMemoryTags.h"
 
+void AMainMenuManager::BeginPlay()
+{
+    // First launch: pick a scalability tier for this machine before the menu is shown.
+    UGameUserSettings *Settings = UGameUserSettings::GetGameUserSettings();
+    if (Settings && Settings->GetLastCPUBenchmarkResult() < 0)
+    {
+        USettingsMenuWidget::AutoDetectGraphicsSettings();
+        Settings->ApplySettings(false);
+    }
+
+    Super::BeginPlay();
+}
 
 void AMainMenuManager::DisplaySettingsWidget()
 {
     if (SettingsWidget)
     {
-        _SettingsWidget = CreateWidget(GetWorld(), SettingsWidget);
+        {
+            CAPSTONE_LLM_SCOPE(Capstone_UI);
+            CAPSTONE_HITCH_SCOPE(Widget, SettingsWidget->GetFName());
+            _SettingsWidget = CreateWidget(GetWorld(), SettingsWidget);
+        }
 
         if (USettingsMenuWidget *Widget = Cast<USettingsMenuWidget>(_SettingsWidget))
         {
@@ -16,6 +16,9 @@ class SPRING2022_CAPSTONE_API AMainMenuManager : public ABaseUIManager
 	
 	
 
+protected:
+	virtual void BeginPlay() override;
+
 public:	
 	
 	UPROPERTY(EditAnywhere, Category = "Widget")
@@ -2,6 +2,8 @@
 
 
 #include "NotificationUIManager.h"
+#include "Spring2022_Capstone/Performance/CapstoneHitchDetector.h"
+#include "Spring2022_Capstone/Performance/CapstoneMemoryTags.h"
 
 // Sets default values
 ANotificationUIManager::ANotificationUIManager()
@@ -40,7 +42,11 @@ void ANotificationUIManager::OnOverlapBegin(UPrimitiveComponent* Comp, AActor* O
 	{
 		
 		// Display Notification
-		_NotificationWidget = Cast<UNotificationWidget>(CreateWidget(GetWorld(), NotificationWidget));
+		{
+			CAPSTONE_LLM_SCOPE(Capstone_UI);
+			CAPSTONE_HITCH_SCOPE(Widget, NotificationWidget->GetFName());
+			_NotificationWidget = Cast<UNotificationWidget>(CreateWidget(GetWorld(), NotificationWidget));
+		}
 
 		// Overwrite Notification's text instance with NewNotificationText set in details.
 		if(bOverwriteNotificationText)
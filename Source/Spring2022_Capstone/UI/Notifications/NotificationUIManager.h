@@ -12,6 +12,8 @@ UCLASS()
 class SPRING2022_CAPSTONE_API ANotificationUIManager : public AActor
 {
 	GENERATED_BODY()
+
+	friend class UCapstoneSoakTestSubsystem;
 	
 public:	
 	// Sets default values for this actor's properties
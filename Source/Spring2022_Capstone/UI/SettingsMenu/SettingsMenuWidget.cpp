@@ -3,6 +3,25 @@
 #include "SettingsMenuWidget.h"
 #include "Spring2022_Capstone/UI/MainMenu/MainMenuManager.h"
 #include "Components/Button.h"
+#include "Components/CheckBox.h"
+#include "Components/TextBlock.h"
+#include "GameFramework/GameUserSettings.h"
+#include "Spring2022_Capstone/Performance/CapstoneGameUserSettings.h"
+
+namespace
+{
+	// Display names for scalability levels 0 (Low) to 4 (Cinematic).
+	const TCHAR* QUALITY_LEVEL_NAMES[] = { TEXT("Low"), TEXT("Medium"), TEXT("High"), TEXT("Epic"), TEXT("Cinematic") };
+	const TCHAR* CUSTOM_PRESET_NAME = TEXT("Custom");
+
+	// Frame rate options, 0 is shown as Unlimited for the frame rate limit.
+	const int32 FRAME_RATE_OPTIONS[] = { 0, 30, 60, 90, 120, 144, 165, 240 };
+
+	FString GetFrameRateOptionName(int32 FrameRate)
+	{
+		return FrameRate > 0 ? FString::FromInt(FrameRate) : FString(TEXT("Unlimited"));
+	}
+}
 
 void USettingsMenuWidget::NativeConstruct()
 {
@@ -13,6 +32,56 @@ void USettingsMenuWidget::NativeConstruct()
 	GraphicsButton->OnClicked.AddUniqueDynamic(this, &USettingsMenuWidget::OnGraphicsButtonPressed);
 	AudioButton->OnClicked.AddUniqueDynamic(this, &USettingsMenuWidget::OnAudioButtonPressed);
 	ControlsButton->OnClicked.AddUniqueDynamic(this, &USettingsMenuWidget::OnControlsButtonPressed);
+
+	// Graphics widgets are optional so the panel can be laid out without all of them.
+	if (QualityPresetComboBox)
+	{
+		QualityPresetComboBox->ClearOptions();
+		for (const TCHAR* LevelName : QUALITY_LEVEL_NAMES)
+			QualityPresetComboBox->AddOption(LevelName);
+		QualityPresetComboBox->AddOption(CUSTOM_PRESET_NAME);
+		QualityPresetComboBox->OnSelectionChanged.AddUniqueDynamic(this, &USettingsMenuWidget::OnQualityPresetChanged);
+	}
+
+	for (UComboBoxString *ComboBox : GetQualityGroupComboBoxes())
+	{
+		if (!ComboBox)
+			continue;
+
+		ComboBox->ClearOptions();
+		for (const TCHAR* LevelName : QUALITY_LEVEL_NAMES)
+			ComboBox->AddOption(LevelName);
+		ComboBox->OnSelectionChanged.AddUniqueDynamic(this, &USettingsMenuWidget::OnQualityGroupChanged);
+	}
+
+	if (FrameRateLimitComboBox)
+	{
+		FrameRateLimitComboBox->ClearOptions();
+		for (int32 FrameRate : FRAME_RATE_OPTIONS)
+			FrameRateLimitComboBox->AddOption(GetFrameRateOptionName(FrameRate));
+		FrameRateLimitComboBox->OnSelectionChanged.AddUniqueDynamic(this, &USettingsMenuWidget::OnFrameRateSettingChanged);
+	}
+	if (TargetFrameRateComboBox)
+	{
+		TargetFrameRateComboBox->ClearOptions();
+		for (int32 FrameRate : FRAME_RATE_OPTIONS)
+		{
+			if (FrameRate > 0)
+				TargetFrameRateComboBox->AddOption(GetFrameRateOptionName(FrameRate));
+		}
+		TargetFrameRateComboBox->OnSelectionChanged.AddUniqueDynamic(this, &USettingsMenuWidget::OnFrameRateSettingChanged);
+	}
+	if (VSyncCheckBox)
+		VSyncCheckBox->OnCheckStateChanged.AddUniqueDynamic(this, &USettingsMenuWidget::OnFrameRateCheckBoxChanged);
+	if (AdaptivePerformanceCheckBox)
+		AdaptivePerformanceCheckBox->OnCheckStateChanged.AddUniqueDynamic(this, &USettingsMenuWidget::OnFrameRateCheckBoxChanged);
+
+	if (AutoDetectButton)
+		AutoDetectButton->OnClicked.AddUniqueDynamic(this, &USettingsMenuWidget::OnAutoDetectButtonPressed);
+	if (ApplyGraphicsButton)
+		ApplyGraphicsButton->OnClicked.AddUniqueDynamic(this, &USettingsMenuWidget::OnApplyGraphicsButtonPressed);
+
+	RefreshGraphicsSettings();
 }
 
 void USettingsMenuWidget::OnBackButtonPressed()
@@ -36,6 +105,7 @@ void USettingsMenuWidget::OnGraphicsButtonPressed()
 {
 	ClearPanels();
 	GraphicsPanel->SetVisibility(ESlateVisibility::Visible);
+	RefreshGraphicsSettings();
 }	
 
 void USettingsMenuWidget::OnAudioButtonPressed()
@@ -52,3 +122,150 @@ void USettingsMenuWidget::ClearPanels()
 	ControlsPanel->SetVisibility(ESlateVisibility::Hidden);
 	AudioPanel->SetVisibility(ESlateVisibility::Hidden);
 }
+
+void USettingsMenuWidget::AutoDetectGraphicsSettings()
+{
+	UGameUserSettings* Settings = UGameUserSettings::GetGameUserSettings();
+	if (!Settings)
+		return;
+
+	Settings->RunHardwareBenchmark();
+	Settings->ApplyHardwareBenchmarkResults();
+
+	UE_LOG(LogTemp, Log, TEXT("Hardware benchmark CPU: %.1f GPU: %.1f, overall quality set to %d"),
+		Settings->GetLastCPUBenchmarkResult(), Settings->GetLastGPUBenchmarkResult(), Settings->GetOverallScalabilityLevel());
+}
+
+void USettingsMenuWidget::OnQualityPresetChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
+{
+	// Ignore changes made by RefreshGraphicsSettings().
+	if (SelectionType == ESelectInfo::Direct)
+		return;
+
+	const int32 Level = QualityPresetComboBox->GetSelectedIndex();
+	if (Level < 0 || Level >= UE_ARRAY_COUNT(QUALITY_LEVEL_NAMES))
+		return;
+
+	UGameUserSettings::GetGameUserSettings()->SetOverallScalabilityLevel(Level);
+	RefreshGraphicsSettings();
+}
+
+void USettingsMenuWidget::OnQualityGroupChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
+{
+	if (SelectionType == ESelectInfo::Direct)
+		return;
+
+	UGameUserSettings* Settings = UGameUserSettings::GetGameUserSettings();
+	auto GetLevel = [](const UComboBoxString* ComboBox, int32 CurrentLevel)
+	{
+		return ComboBox && ComboBox->GetSelectedIndex() >= 0 ? ComboBox->GetSelectedIndex() : CurrentLevel;
+	};
+
+	Settings->SetViewDistanceQuality(GetLevel(ViewDistanceComboBox, Settings->GetViewDistanceQuality()));
+	Settings->SetAntiAliasingQuality(GetLevel(AntiAliasingComboBox, Settings->GetAntiAliasingQuality()));
+	Settings->SetShadowQuality(GetLevel(ShadowComboBox, Settings->GetShadowQuality()));
+	Settings->SetGlobalIlluminationQuality(GetLevel(GlobalIlluminationComboBox, Settings->GetGlobalIlluminationQuality()));
+	Settings->SetReflectionQuality(GetLevel(ReflectionComboBox, Settings->GetReflectionQuality()));
+	Settings->SetPostProcessingQuality(GetLevel(PostProcessComboBox, Settings->GetPostProcessingQuality()));
+	Settings->SetTextureQuality(GetLevel(TextureComboBox, Settings->GetTextureQuality()));
+	Settings->SetVisualEffectQuality(GetLevel(EffectsComboBox, Settings->GetVisualEffectQuality()));
+	Settings->SetFoliageQuality(GetLevel(FoliageComboBox, Settings->GetFoliageQuality()));
+	Settings->SetShadingQuality(GetLevel(ShadingComboBox, Settings->GetShadingQuality()));
+
+	// Preset switches to Custom when the groups no longer share one level.
+	RefreshGraphicsSettings();
+}
+
+void USettingsMenuWidget::OnFrameRateSettingChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
+{
+	if (SelectionType == ESelectInfo::Direct)
+		return;
+
+	// Both combo boxes hold frame rates as text, so they share one handler.
+	OnFrameRateCheckBoxChanged(true);
+}
+
+void USettingsMenuWidget::OnFrameRateCheckBoxChanged(bool bIsChecked)
+{
+	UCapstoneGameUserSettings* Settings = UCapstoneGameUserSettings::GetCapstoneGameUserSettings();
+	if (!Settings)
+		return;
+
+	if (FrameRateLimitComboBox && FrameRateLimitComboBox->GetSelectedIndex() >= 0)
+		Settings->SetFrameRateLimit(FRAME_RATE_OPTIONS[FrameRateLimitComboBox->GetSelectedIndex()]);
+	if (TargetFrameRateComboBox && TargetFrameRateComboBox->GetSelectedIndex() >= 0)
+		Settings->SetTargetFrameRate(FCString::Atof(*TargetFrameRateComboBox->GetSelectedOption()));
+	if (VSyncCheckBox)
+		Settings->SetVSyncEnabled(VSyncCheckBox->IsChecked());
+	if (AdaptivePerformanceCheckBox)
+		Settings->SetAdaptivePerformanceEnabled(AdaptivePerformanceCheckBox->IsChecked());
+}
+
+void USettingsMenuWidget::OnAutoDetectButtonPressed()
+{
+	AutoDetectGraphicsSettings();
+	UGameUserSettings::GetGameUserSettings()->ApplySettings(false);
+	RefreshGraphicsSettings();
+}
+
+void USettingsMenuWidget::OnApplyGraphicsButtonPressed()
+{
+	// ApplySettings also saves to GameUserSettings.ini.
+	UGameUserSettings::GetGameUserSettings()->ApplySettings(false);
+}
+
+void USettingsMenuWidget::RefreshGraphicsSettings()
+{
+	UGameUserSettings* Settings = UGameUserSettings::GetGameUserSettings();
+	if (!Settings)
+		return;
+
+	if (QualityPresetComboBox)
+	{
+		// GetOverallScalabilityLevel() returns -1 when the groups are mixed.
+		const int32 OverallLevel = Settings->GetOverallScalabilityLevel();
+		QualityPresetComboBox->SetSelectedIndex(OverallLevel >= 0 ? OverallLevel : UE_ARRAY_COUNT(QUALITY_LEVEL_NAMES));
+	}
+
+	auto SetLevel = [](UComboBoxString* ComboBox, int32 Level)
+	{
+		if (ComboBox)
+			ComboBox->SetSelectedIndex(FMath::Clamp(Level, 0, (int32)UE_ARRAY_COUNT(QUALITY_LEVEL_NAMES) - 1));
+	};
+
+	SetLevel(ViewDistanceComboBox, Settings->GetViewDistanceQuality());
+	SetLevel(AntiAliasingComboBox, Settings->GetAntiAliasingQuality());
+	SetLevel(ShadowComboBox, Settings->GetShadowQuality());
+	SetLevel(GlobalIlluminationComboBox, Settings->GetGlobalIlluminationQuality());
+	SetLevel(ReflectionComboBox, Settings->GetReflectionQuality());
+	SetLevel(PostProcessComboBox, Settings->GetPostProcessingQuality());
+	SetLevel(TextureComboBox, Settings->GetTextureQuality());
+	SetLevel(EffectsComboBox, Settings->GetVisualEffectQuality());
+	SetLevel(FoliageComboBox, Settings->GetFoliageQuality());
+	SetLevel(ShadingComboBox, Settings->GetShadingQuality());
+
+	if (UCapstoneGameUserSettings* CapstoneSettings = Cast<UCapstoneGameUserSettings>(Settings))
+	{
+		if (FrameRateLimitComboBox)
+			FrameRateLimitComboBox->SetSelectedOption(GetFrameRateOptionName(FMath::RoundToInt(CapstoneSettings->GetFrameRateLimit())));
+		if (TargetFrameRateComboBox)
+			TargetFrameRateComboBox->SetSelectedOption(GetFrameRateOptionName(FMath::RoundToInt(CapstoneSettings->GetTargetFrameRate())));
+		if (VSyncCheckBox)
+			VSyncCheckBox->SetIsChecked(CapstoneSettings->IsVSyncEnabled());
+		if (AdaptivePerformanceCheckBox)
+			AdaptivePerformanceCheckBox->SetIsChecked(CapstoneSettings->IsAdaptivePerformanceEnabled());
+	}
+
+	if (BenchmarkResultText)
+	{
+		BenchmarkResultText->SetText(Settings->GetLastCPUBenchmarkResult() < 0
+			? FText::FromString(TEXT("Benchmark not run"))
+			: FText::FromString(FString::Printf(TEXT("CPU %.0f / GPU %.0f"), Settings->GetLastCPUBenchmarkResult(), Settings->GetLastGPUBenchmarkResult())));
+	}
+}
+
+TArray<UComboBoxString*> USettingsMenuWidget::GetQualityGroupComboBoxes() const
+{
+	return { ViewDistanceComboBox, AntiAliasingComboBox, ShadowComboBox, GlobalIlluminationComboBox, ReflectionComboBox,
+		PostProcessComboBox, TextureComboBox, EffectsComboBox, FoliageComboBox, ShadingComboBox };
+}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/Slider.h"
+#include "Components/ComboBoxString.h"
 #include "SettingsMenuWidget.generated.h"
 
 class UPanelWidget;
@@ -12,6 +13,7 @@ class UImage;
 class UTextBlock;
 class AMainMenuManager;
 class UButton;
+class UCheckBox;
 
 UCLASS(Abstract)
 class SPRING2022_CAPSTONE_API USettingsMenuWidget : public UUserWidget
@@ -55,6 +57,47 @@ public:
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	UPanelWidget *GraphicsPanel;
 
+	// Graphics Quality
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *QualityPresetComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *ViewDistanceComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *AntiAliasingComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *ShadowComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *GlobalIlluminationComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *ReflectionComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *PostProcessComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *TextureComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *EffectsComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *FoliageComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *ShadingComboBox;
+
+	// Frame Pacing
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *FrameRateLimitComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UComboBoxString *TargetFrameRateComboBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UCheckBox *VSyncCheckBox;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UCheckBox *AdaptivePerformanceCheckBox;
+
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UButton *AutoDetectButton;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UButton *ApplyGraphicsButton;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UTextBlock *BenchmarkResultText;
+
 	// Audio
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	UButton *AudioButton;
@@ -70,6 +113,12 @@ public:
 	UPROPERTY(EditAnywhere, meta = (BindWidget))
 	USlider *SFXSlider;
 
+	/**
+	 * @brief Runs the engine hardware benchmark and applies the scalability levels it picks.
+	 * @note Called on first launch by AMainMenuManager, settings are saved to GameUserSettings.ini.
+	 */
+	static void AutoDetectGraphicsSettings();
+
 
 private:
 	
@@ -90,5 +139,29 @@ private:
 
 	UFUNCTION()
 	void ClearPanels();
+
+	UFUNCTION()
+	void OnQualityPresetChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
+
+	UFUNCTION()
+	void OnQualityGroupChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
+
+	UFUNCTION()
+	void OnFrameRateSettingChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
+
+	UFUNCTION()
+	void OnFrameRateCheckBoxChanged(bool bIsChecked);
+
+	UFUNCTION()
+	void OnAutoDetectButtonPressed();
+
+	UFUNCTION()
+	void OnApplyGraphicsButtonPressed();
+
+	// Fills the graphics combo boxes with the levels currently held by the game user settings.
+	void RefreshGraphicsSettings();
+
+	// Graphics group combo boxes in the order they are read in OnQualityGroupChanged().
+	TArray<UComboBoxString*> GetQualityGroupComboBoxes() const;
 	
 };
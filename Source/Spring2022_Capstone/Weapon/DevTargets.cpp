@@ -2,6 +2,7 @@
 
 
 #include "DevTargets.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
 
 // Sets default values
 ADevTargets::ADevTargets()
@@ -29,6 +30,7 @@ void ADevTargets::Tick(float DeltaTime)
 
 void ADevTargets::DamageActor(AActor* DamagingActor, const float DamageAmount)
 {
+	CAPSTONE_TRACE_SCOPE(STAT_CapstoneDamage);
 	ToggleMaterial();	
 }
 
@@ -5,6 +5,7 @@
 
 #include "GameFramework/PawnMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
 
 URecoilComponent::URecoilComponent()
 {
@@ -61,6 +62,7 @@ void URecoilComponent::FireTimerHandleFunction()
 
 void URecoilComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	CAPSTONE_SCOPE(STAT_CapstoneRecoilTick, Weapons);
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	
 	if(bIsRecoiling)
@@ -75,8 +77,13 @@ void URecoilComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 		if(!GetWorld()->GetTimerManager().IsTimerActive(BackupRecoveryTimer))
 			GetWorld()->GetTimerManager().SetTimer(BackupRecoveryTimer, this, &URecoilComponent::RecoilReset,  (bHasLargerFireRate) ? LargeFireRateMaxTimeInRecovery : OwningParentWeapon->FireRate /*+ SemiAutomaticMaxTimeInRecoveryBuffer*/, false);
 
-		RecoverRecoil(DeltaTime);
+		// Control Rotation is also the Player's aim, so recovery isn't interpolated between steps.
+		const int32 Steps = RecoveryClock.Advance(DeltaTime);
+		for (int32 Step = 0; Step < Steps && bIsRecovering; Step++)
+			RecoverRecoil(RecoveryClock.GetStepTime());
 	}
+	else
+		RecoveryClock.Reset();
 
 	// Reset recoil when Player leaves the ground.
 	if(!OwnersPawnMovementComponent->IsMovingOnGround())
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "WeaponBase.h"
+#include "Spring2022_Capstone/GameplaySystems/FixedStepClock.h"
 #include "Components/ActorComponent.h"
 #include "RecoilComponent.generated.h"
 
@@ -14,6 +15,8 @@ class SPRING2022_CAPSTONE_API URecoilComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	friend class UCapstoneSoakTestSubsystem;
+
 public:	
 	// Sets default values for this component's properties
 	URecoilComponent();
@@ -92,6 +95,9 @@ private:
 	// The amount Player's Control Rotation needs to be brought down vertically during recoil recovery.
 	float PitchRecoveryAmount;
 
+	// Steps recovery so it comes down the same way at any frame rate when fixed steps are on.
+	FFixedStepClock RecoveryClock;
+
 // Timers
 	// Used to start recoil recovery after player has finished shooting.
 	FTimerHandle FireTimerHandle;
@@ -4,6 +4,9 @@
 #include "SemiAutomaticWeapon.h"
 
 #include "DevTargets.h"
+#include "Spring2022_Capstone/Performance/CapstoneInputLatency.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+#include "Spring2022_Capstone/Performance/CapstoneTelemetry.h"
 
 
 ASemiAutomaticWeapon::ASemiAutomaticWeapon()
@@ -15,6 +18,7 @@ ASemiAutomaticWeapon::ASemiAutomaticWeapon()
 
 void ASemiAutomaticWeapon::Shoot()
 {
+	CAPSTONE_SCOPE(STAT_CapstoneWeaponShoot, Weapons);
 
 	if(!bIsOverheating && CurrentCharge > MaxChargeAmount )
 	{
@@ -37,19 +41,24 @@ void ASemiAutomaticWeapon::Shoot()
 			FVector ForwardVector = PlayerCamera->GetActorForwardVector();
 			FVector EndTrace = ((ForwardVector * ShotDistance) + StartTrace); 
 			FCollisionQueryParams* TraceParams = new FCollisionQueryParams();
+			FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::ShotFired, this, ShotDamage, StartTrace);
 
+			CAPSTONE_COUNT_SCENE_QUERY();
 			if(GetWorld()->LineTraceSingleByChannel(HitResult, StartTrace, EndTrace, ECC_Visibility, *TraceParams))
 			{
 				if(HitResult.GetActor()->Implements<UDamageableActor>())
 				{
+					CAPSTONE_TRACE_SCOPE(STAT_CapstoneDamage);
 					IDamageableActor* DamageableActor = Cast<IDamageableActor>(HitResult.GetActor());
 					DamageableActor->DamageActor(this, ShotDamage);	
+					FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::ShotHit, this, ShotDamage, HitResult.Location, HitResult.GetActor()->GetFName());
 				}
 				DrawDebugLine(GetWorld(), StartTrace, HitResult.Location, FColor::Black, false, 0.5f);
 			}
 			
 			CurrentCharge += ShotCost;
 			PlayWeaponCameraShake();
+			FCapstoneInputLatency::MarkEffect(ECapstoneLatencyAction::Attack);
 			
 			// Call recoil
 			if(RecoilComponent)
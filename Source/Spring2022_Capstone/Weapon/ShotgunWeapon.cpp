@@ -3,16 +3,26 @@
 
 #include "ShotgunWeapon.h"
 #include "DevTargets.h"
+#include "Spring2022_Capstone/Performance/CapstoneInputLatency.h"
+#include "Spring2022_Capstone/Performance/CapstoneStats.h"
+#include "Spring2022_Capstone/Performance/CapstoneTelemetry.h"
 #include "Kismet/KismetMathLibrary.h"
 
 
 AShotgunWeapon::AShotgunWeapon()
 {
 	RecoilComponent = CreateDefaultSubobject<URecoilComponent>("Shotgun Recoil Component");
+	SpreadStream.GenerateNewSeed();
+}
+
+void AShotgunWeapon::SetSpreadSeed(int32 Seed)
+{
+	SpreadStream.Initialize(Seed);
 }
 
 void AShotgunWeapon::Shoot()
 {
+	CAPSTONE_SCOPE(STAT_CapstoneWeaponShoot, Weapons);
 
 	if(!bIsOverheating && CurrentCharge > MaxChargeAmount )
 	{
@@ -38,21 +48,25 @@ void AShotgunWeapon::Shoot()
 			HalfAngle = UKismetMathLibrary::DegreesToRadians(HalfAngle);
 			//															//
 			
+			FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::ShotFired, this, ShotDamage * PelletCount, StartTrace);
 			for(int i = 0; i < PelletCount; i++)
 			{
 				
 				// Get random direction inside cone projected from player
-				ForwardVector = UKismetMathLibrary::RandomUnitVectorInConeInRadians(PlayerCamera->GetActorForwardVector(), HalfAngle);
+				ForwardVector = SpreadStream.VRandCone(PlayerCamera->GetActorForwardVector(), HalfAngle);
 				
 				FVector EndTrace = ((ForwardVector * ShotDistance) + StartTrace);
 				FCollisionQueryParams* TraceParams = new FCollisionQueryParams();
 				
+				CAPSTONE_COUNT_SCENE_QUERY();
 				if(GetWorld()->LineTraceSingleByChannel(HitResult, StartTrace, EndTrace, ECC_Visibility, *TraceParams))
 				{
 					if(HitResult.GetActor()->Implements<UDamageableActor>())
 					{
+						CAPSTONE_TRACE_SCOPE(STAT_CapstoneDamage);
 						IDamageableActor* DamageableActor = Cast<IDamageableActor>(HitResult.GetActor());
 						DamageableActor->DamageActor(this, ShotDamage);	
+						FCapstoneTelemetry::Record(ECapstoneTelemetryEvent::ShotHit, this, ShotDamage, HitResult.Location, HitResult.GetActor()->GetFName());
 					}
 					
 					DrawDebugLine(GetWorld(), StartTrace, HitResult.Location, FColor::Black, false, 0.5f);
@@ -61,6 +75,7 @@ void AShotgunWeapon::Shoot()
 			
 			CurrentCharge += ShotCost;
 			PlayWeaponCameraShake();
+			FCapstoneInputLatency::MarkEffect(ECapstoneLatencyAction::Attack);
 
 			// Call recoil
 			if(RecoilComponent)
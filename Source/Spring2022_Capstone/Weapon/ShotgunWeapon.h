@@ -31,5 +31,18 @@ class SPRING2022_CAPSTONE_API AShotgunWeapon : public AWeaponBase
 
 	UPROPERTY(EditAnywhere)
 	URecoilComponent* RecoilComponent;
-	
+
+	// Pellet spread, kept separate from the global random numbers so recorded sessions replay the same pattern.
+	FRandomStream SpreadStream;
+
+public:
+	/**
+	 * @brief Restarts the pellet spread from Seed.
+	 * @note Used by UCapstoneReplaySubsystem when recording or replaying a session.
+	 */
+	void SetSpreadSeed(int32 Seed);
+	int32 GetSpreadSeed() const { return SpreadStream.GetInitialSeed(); }
+
+	// Current position in the spread sequence, compared between a recording and its replay.
+	int32 GetSpreadState() const { return SpreadStream.GetCurrentSeed(); }
 };
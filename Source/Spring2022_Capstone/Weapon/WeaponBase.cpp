@@ -6,10 +6,12 @@
 #include "GameFramework/GameModeBase.h"
 #include "Kismet/GameplayStatics.h"
 #include "Spring2022_Capstone/Player/PlayerCharacter.h"
+#include "Spring2022_Capstone/Performance/CapstoneMemoryTags.h"
 
 // Sets default values
 AWeaponBase::AWeaponBase()
 {
+	CAPSTONE_LLM_SCOPE(Capstone_Weapons);
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -22,6 +24,7 @@ AWeaponBase::AWeaponBase()
 // Called when the game starts or when spawned
 void AWeaponBase::BeginPlay()
 {
+	CAPSTONE_LLM_SCOPE(Capstone_Weapons);
 	Super::BeginPlay();
 
 	PlayerCamera = GetWorld()->GetFirstPlayerController()->PlayerCameraManager; // No constructor will crash (execution order),
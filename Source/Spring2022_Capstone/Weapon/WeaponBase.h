@@ -15,6 +15,8 @@ class SPRING2022_CAPSTONE_API AWeaponBase : public AActor
 
 	friend class UUpgradeSystemComponent;
 	friend class URecoilComponent;
+	friend struct FGameplaySnapshot;
+	friend class UCapstoneSoakTestSubsystem;
 		
 public:	
 	// Sets default values for this actor's properties